@@ -0,0 +1,42 @@
+#!/usr/bin/env bash
+# CMC vs Mover movement backend benchmark.
+# Runs the headless TestingArea soak (UTrialSoakTestController) once per backend and bot count with the
+# same bot behavior, and collects the SOAK result lines (average / p95 game-thread ms) into one table.
+# Gates are not enforced here; high bot counts are expected to exceed them.
+#
+# Usage: RunMoverBenchmark.sh <path to TrialTask game binary> [bot counts] [seconds per run] [behavior]
+#   e.g. RunMoverBenchmark.sh ./TrialTask "16 64 128 256" 60 Slider
+
+set -euo pipefail
+
+GAME_BIN="$1"
+BOT_COUNTS="${2:-16 32 64 128}"
+RUN_SECONDS="${3:-60}"
+BEHAVIOR="${4:-None}"
+OUT_DIR="$(pwd)/MoverBench_$(date +%Y%m%d-%H%M%S)"
+
+# Class names resolved by ATrialBotController::FindBotPawnClass
+BACKENDS="CMC=/Game/Character/BP_CustomCharacter.BP_CustomCharacter_C Mover=/Script/TrialTask.TrialMoverCharacter"
+
+mkdir -p "$OUT_DIR"
+echo "backend,bots,frames,avgGT_ms,p95GT_ms,queries_per_bot_frame" > "$OUT_DIR/MoverBench.csv"
+
+for BOTS in $BOT_COUNTS; do
+	for BACKEND in $BACKENDS; do
+		NAME="${BACKEND%%=*}"
+		CLASS="${BACKEND#*=}"
+		LOG="$OUT_DIR/${NAME}_${BOTS}.log"
+
+		echo "$NAME bots=$BOTS, measuring ${RUN_SECONDS}s"
+		"$GAME_BIN" TestingArea -gauntlet=TrialSoakTestController -nullrhi -nosound -unattended -NoVerifyGC \
+			-SoakBots="$BOTS" -SoakDuration="$RUN_SECONDS" -SoakBehavior="$BEHAVIOR" -SoakPawn="$CLASS" \
+			-csvMetadata="Test=MoverBench,Backend=$NAME,Bots=$BOTS" -abslog="$LOG" >/dev/null 2>&1 || true
+
+		grep "SOAK: pawn=" "$LOG" | tail -1 | sed -E \
+			's/.*frames=([0-9]+) bots=([0-9]+) avgGT=([0-9.]+)ms.*p95GT=([0-9.]+)ms.*queries\/bot\/frame=([0-9.]+).*/\2,\1,\3,\4,\5/' \
+			| awk -F, -v N="$NAME" '{print N "," $1 "," $2 "," $3 "," $4 "," $5}' >> "$OUT_DIR/MoverBench.csv" || true
+	done
+done
+
+echo "results: $OUT_DIR/MoverBench.csv"
+cat "$OUT_DIR/MoverBench.csv"
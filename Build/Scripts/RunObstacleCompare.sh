@@ -0,0 +1,42 @@
+#!/usr/bin/env bash
+# Parkour obstacle count / memory comparison (tagged BP_Parkourable actors vs one instanced obstacle field).
+# Runs Trial.Parkour.ObstacleCompare in a standalone TestingArea and collects the OBSTACLES result lines
+# (UObjects, primitives, resource size, physical memory delta, spawn time) into one table, two rows per run.
+# Render proxies only exist with a renderer, so the default run is windowed; pass "nullrhi" for a headless run.
+#
+# Usage: RunObstacleCompare.sh <path to TrialTask game binary> [count] [runs] [rhi|nullrhi]
+#   e.g. RunObstacleCompare.sh ./TrialTask 10000 3
+
+set -euo pipefail
+
+GAME_BIN="$1"
+COUNT="${2:-10000}"
+RUNS="${3:-3}"
+RHI="${4:-rhi}"
+OUT_DIR="$(pwd)/ObstacleCompare_$(date +%Y%m%d-%H%M%S)"
+
+RHI_ARGS="-windowed -ResX=1280 -ResY=720"
+if [ "$RHI" = "nullrhi" ]; then
+	RHI_ARGS="-nullrhi"
+fi
+
+mkdir -p "$OUT_DIR"
+echo "run,mode,count,spawn_ms,uobjects,primitives,resource_kb,physical_delta_mb" > "$OUT_DIR/ObstacleCompare.csv"
+
+for RUN in $(seq 1 "$RUNS"); do
+	LOG="$OUT_DIR/Run$RUN.log"
+
+	echo "run $RUN/$RUNS, $COUNT obstacles"
+	"$GAME_BIN" TestingArea -game $RHI_ARGS -nosound -unattended \
+		-ExecCmds="Trial.Parkour.ObstacleCompare ${COUNT},quit" -abslog="$LOG" >/dev/null 2>&1 || true
+
+	grep "OBSTACLES,Mode=" "$LOG" | awk -F'OBSTACLES,' -v R="$RUN" '{
+		n = split($2, Fields, ",")
+		Row = R
+		for (i = 1; i <= n; ++i) { split(Fields[i], KV, "="); Row = Row "," KV[2] }
+		print Row
+	}' >> "$OUT_DIR/ObstacleCompare.csv" || true
+done
+
+echo "results: $OUT_DIR/ObstacleCompare.csv"
+cat "$OUT_DIR/ObstacleCompare.csv"
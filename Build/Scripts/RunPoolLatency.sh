@@ -0,0 +1,36 @@
+#!/usr/bin/env bash
+# Respawn latency benchmark (character pool vs fresh SpawnActor).
+# Runs Trial.Pool.Latency in a headless standalone TestingArea and collects the POOL result lines
+# (spawn-to-controllable average / max ms for both paths) into one table, one row per run.
+#
+# Usage: RunPoolLatency.sh <path to TrialTask game binary> [iterations] [runs] [character class]
+#   e.g. RunPoolLatency.sh ./TrialTask 200 5 /Game/Character/BP_CustomCharacter.BP_CustomCharacter_C
+
+set -euo pipefail
+
+GAME_BIN="$1"
+ITERATIONS="${2:-100}"
+RUNS="${3:-3}"
+CHARACTER_CLASS="${4:-}"
+OUT_DIR="$(pwd)/PoolLatency_$(date +%Y%m%d-%H%M%S)"
+
+mkdir -p "$OUT_DIR"
+echo "run,class,iterations,spawn_avg_ms,spawn_max_ms,pooled_avg_ms,pooled_max_ms,speedup" > "$OUT_DIR/PoolLatency.csv"
+
+for RUN in $(seq 1 "$RUNS"); do
+	LOG="$OUT_DIR/Run$RUN.log"
+
+	echo "run $RUN/$RUNS, $ITERATIONS iterations"
+	"$GAME_BIN" TestingArea -game -nullrhi -nosound -unattended \
+		-ExecCmds="Trial.Pool.Latency ${ITERATIONS} ${CHARACTER_CLASS},quit" -abslog="$LOG" >/dev/null 2>&1 || true
+
+	grep "POOL,Class=" "$LOG" | tail -1 | awk -F'POOL,' -v R="$RUN" '{
+		n = split($2, Fields, ",")
+		Row = R
+		for (i = 1; i <= n; ++i) { split(Fields[i], KV, "="); sub(/x$/, "", KV[2]); Row = Row "," KV[2] }
+		print Row
+	}' >> "$OUT_DIR/PoolLatency.csv" || true
+done
+
+echo "results: $OUT_DIR/PoolLatency.csv"
+cat "$OUT_DIR/PoolLatency.csv"
@@ -0,0 +1,65 @@
+#!/usr/bin/env bash
+# Local multi-client replication benchmark.
+# Starts a headless dedicated server on TestingArea, then adds headless clients in steps and
+# collects the REPBENCH lines (server replication ms per frame vs connected player count)
+# and the NETSTATE lines (traversal state bytes per pawn per second).
+#
+# Usage: RunRepBenchmark.sh <path to TrialTaskServer> <path to TrialTask client> [max players] [seconds per step] [server bots]
+
+set -euo pipefail
+
+SERVER_BIN="$1"
+CLIENT_BIN="$2"
+MAX_PLAYERS="${3:-16}"
+STEP_SECONDS="${4:-30}"
+SERVER_BOTS="${5:-0}"
+PORT=7777
+OUT_DIR="$(pwd)/RepBench_$(date +%Y%m%d-%H%M%S)"
+
+mkdir -p "$OUT_DIR"
+
+SERVER_CMDS="Trial.RepBench.ReportInterval ${STEP_SECONDS},Trial.NetState.ReportInterval ${STEP_SECONDS}"
+if [ "$SERVER_BOTS" -gt 0 ]; then
+	SERVER_CMDS="${SERVER_CMDS},Trial.SpawnBots ${SERVER_BOTS}"
+fi
+
+"$SERVER_BIN" TestingArea -log -unattended -port=$PORT -ExecCmds="${SERVER_CMDS}" \
+	-abslog="$OUT_DIR/Server.log" >/dev/null 2>&1 &
+SERVER_PID=$!
+
+CLIENT_PIDS=()
+cleanup()
+{
+	for PID in "${CLIENT_PIDS[@]:-}"; do kill "$PID" 2>/dev/null || true; done
+	kill "$SERVER_PID" 2>/dev/null || true
+}
+trap cleanup EXIT
+
+sleep 15
+
+PLAYERS=0
+STEP=1
+while [ "$PLAYERS" -lt "$MAX_PLAYERS" ]; do
+	while [ "$PLAYERS" -lt "$STEP" ] && [ "$PLAYERS" -lt "$MAX_PLAYERS" ]; do
+		"$CLIENT_BIN" 127.0.0.1:$PORT -nullrhi -nosound -unattended -log \
+			-abslog="$OUT_DIR/Client$PLAYERS.log" >/dev/null 2>&1 &
+		CLIENT_PIDS+=($!)
+		PLAYERS=$((PLAYERS + 1))
+	done
+
+	echo "players=$PLAYERS, measuring ${STEP_SECONDS}s"
+	sleep "$STEP_SECONDS"
+	STEP=$((STEP * 2))
+done
+
+# Reports are cumulative, so the final table is the last line logged for each player count
+sleep "$STEP_SECONDS"
+grep "REPBENCH" "$OUT_DIR/Server.log" \
+	| awk -F'REPBENCH,' '{ split($2, Fields, ","); Last[Fields[1]] = $2 } END { for (Key in Last) print Last[Key] }' \
+	| sort -t= -k2 -n > "$OUT_DIR/RepBench.csv" || true
+
+grep "NETSTATE" "$OUT_DIR/Server.log" | awk -F'NETSTATE,' '{print $2}' > "$OUT_DIR/NetState.csv" || true
+
+echo "results: $OUT_DIR/RepBench.csv, $OUT_DIR/NetState.csv"
+cat "$OUT_DIR/RepBench.csv"
+cat "$OUT_DIR/NetState.csv"
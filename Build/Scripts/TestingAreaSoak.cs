@@ -0,0 +1,67 @@
+// Headless soak of TestingArea with performance gates.
+//
+// RunUAT.sh RunUnreal -project=<path>/TrialTask.uproject -platform=Linux -configuration=Development \
+//     -build=<staged build> -test=TrialTask.Automation.TestingAreaSoak -Bots=32 -Duration=180
+//
+// The in-game UTrialSoakTestController spawns the bots, captures a CSV profile and exits
+// non-zero when a baseline from [/Script/TrialTask.TrialSoakTestController] in DefaultGame.ini is exceeded.
+
+using Gauntlet;
+
+namespace TrialTask.Automation
+{
+	public class SoakTestConfig : UnrealTestConfiguration
+	{
+		[AutoParam("TestingArea")]
+		public string Map = "TestingArea";
+
+		[AutoParam(16)]
+		public int Bots = 16;
+
+		[AutoParam(120)]
+		public int Duration = 120;
+
+		// Bot pawn class, e.g. TrialMoverCharacter for the Mover backend (empty = BotCharacterClass)
+		[AutoParam("")]
+		public string Pawn = "";
+
+		// Also gate on steady-state hot-path allocations (Parkour.AllocCheck)
+		[AutoParam(false)]
+		public bool AllocCheck = false;
+	}
+
+	public class TestingAreaSoak : UnrealTestNode<SoakTestConfig>
+	{
+		public TestingAreaSoak(UnrealTestContext InContext)
+			: base(InContext)
+		{
+		}
+
+		public override SoakTestConfig GetConfiguration()
+		{
+			SoakTestConfig Config = base.GetConfiguration();
+
+			UnrealTestRole Client = Config.RequireRole(UnrealTargetRole.Client);
+			Client.Controllers.Add("TrialSoakTestController");
+
+			Client.CommandLine += string.Format(" {0} -nullrhi -nosound -unattended -NoVerifyGC", Config.Map);
+			Client.CommandLine += string.Format(" -SoakBots={0} -SoakDuration={1}", Config.Bots, Config.Duration);
+			Client.CommandLine += " -csvMetadata=\"Test=TestingAreaSoak\"";
+
+			if (!string.IsNullOrEmpty(Config.Pawn))
+			{
+				Client.CommandLine += string.Format(" -SoakPawn={0}", Config.Pawn);
+			}
+
+			if (Config.AllocCheck)
+			{
+				Client.CommandLine += " -ParkourAllocCheck -ExecCmds=\"Parkour.AllocCheck 1\"";
+			}
+
+			// Map load + warmup + measured window + shutdown
+			Config.MaxDuration = Config.Duration + 600;
+
+			return Config;
+		}
+	}
+}
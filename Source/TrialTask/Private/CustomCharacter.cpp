@@ -1,11 +1,21 @@
 #include "CustomCharacter.h"
 
 #include "CustomMovementComponent.h"
+#include "ParkourAllocationScope.h"
+#include "ParkourStats.h"
 #include "StaminaWidget.h"
+#include "TrialAnimCrowd.h"
+#include "TrialInputLatency.h"
+#include "TrialReplayController.h"
+#include "TrialParkourObstacle.h"
+#include "TrialPredictiveStreaming.h"
+#include "TrialReplicationGraph.h"
+#include "TrialTaskLLM.h"
 
 #include "Camera/CameraComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "SkeletalMeshComponentBudgeted.h"
 
 #include "Animation/AnimInstance.h"
 #include "GameFramework/CharacterMovementComponent.h"
@@ -15,22 +25,38 @@
 #include "EnhancedInputComponent.h"
 
 #include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "Net/UnrealNetwork.h"
 #include "TimerManager.h"
 
-static const FName TAG_PARKOURABLE(TEXT("Parkourable"));
+DECLARE_CYCLE_STAT(TEXT("CharacterTick"), STAT_CharacterTick, STATGROUP_Parkour);
+DECLARE_CYCLE_STAT(TEXT("ParkourPressed"), STAT_ParkourPressed, STATGROUP_Parkour);
+DECLARE_CYCLE_STAT(TEXT("FindParkourObstacle"), STAT_FindParkourObstacle, STATGROUP_Parkour);
+DECLARE_CYCLE_STAT(TEXT("ComputeSafeParkourLanding"), STAT_ComputeSafeParkourLanding, STATGROUP_Parkour);
+DECLARE_CYCLE_STAT(TEXT("ParkourMoveStep"), STAT_ParkourMoveStep, STATGROUP_Parkour);
+DECLARE_CYCLE_STAT(TEXT("SimulatedTraversal"), STAT_SimulatedTraversal, STATGROUP_Parkour);
+DECLARE_CYCLE_STAT(TEXT("ValidateParkourStart"), STAT_ValidateParkourStart, STATGROUP_Parkour);
 
 ACustomCharacter::ACustomCharacter(const FObjectInitializer& ObjectInitializer)
-	: Super(ObjectInitializer.SetDefaultSubobjectClass<UCustomMovementComponent>(ACharacter::CharacterMovementComponentName))
+	: Super(ObjectInitializer
+		.SetDefaultSubobjectClass<UCustomMovementComponent>(ACharacter::CharacterMovementComponentName)
+		// Budgeted mesh: UTrialAnimCrowdSubsystem keeps crowds of characters under Trial.Anim.BudgetMs
+		.SetDefaultSubobjectClass<USkeletalMeshComponentBudgeted>(ACharacter::MeshComponentName))
 {
+	LLM_SCOPE_BYTAG(TrialTask);
+
 	PrimaryActorTick.bCanEverTick = true;
 
 	CustomMoveComp = Cast<UCustomMovementComponent>(GetCharacterMovement());
 
+	// Created everywhere so the class default matches BP_CustomCharacter's serialized overrides; servers deactivate it in BeginPlay
 	FirstPersonCamera = CreateDefaultSubobject<UCameraComponent>(TEXT("FirstPersonCamera"));
 	FirstPersonCamera->SetupAttachment(GetCapsuleComponent());
 	FirstPersonCamera->SetRelativeLocation(FVector(0.f, 0.f, 64.f));
 	FirstPersonCamera->bUsePawnControlRotation = true;
 
+	PredictiveStreaming = CreateDefaultSubobject<UTrialPredictiveStreamingComponent>(TEXT("PredictiveStreaming"));
+
 	bUseControllerRotationYaw = true;
 	bUseControllerRotationPitch = true;
 	bUseControllerRotationRoll = false;
@@ -45,59 +71,247 @@ void ACustomCharacter::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// Enhanced Input mapping context
-	if (APlayerController* PC = Cast<APlayerController>(GetController()))
+	LLM_SCOPE_BYTAG(TrialTask);
+
+	InitQueryParams();
+
+	if (HasAuthority() && !IsNetMode(NM_Standalone))
+	{
+		++FTraversalNetStats::NumPawns;
+		bCountedInNetStats = true;
+	}
+
+	const bool bDedicatedServer = IsNetMode(NM_DedicatedServer);
+
+	if (bDedicatedServer)
+	{
+		// Nothing is ever rendered: skip pose evaluation and montage ticking entirely (parkour motion is geometric)
+		if (GetMesh())
+		{
+			GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+		}
+
+		// No viewport to view through
+		FirstPersonCamera->Deactivate();
+	}
+	// Montage callbacks are bound once; binding per StartParkour allocated a delegate each time
+	else if (UAnimInstance* AnimInstance = GetMesh() ? GetMesh()->GetAnimInstance() : nullptr)
+	{
+		AnimInstance->OnMontageBlendingOut.AddUniqueDynamic(this, &ACustomCharacter::OnParkourMontageBlendOut);
+		AnimInstance->OnMontageEnded.AddUniqueDynamic(this, &ACustomCharacter::OnParkourMontageEnded);
+	}
+
+	if (!bDedicatedServer)
+	{
+		if (UTrialAnimCrowdSubsystem* AnimCrowd = GetWorld()->GetSubsystem<UTrialAnimCrowdSubsystem>())
+		{
+			AnimCrowd->RegisterCharacter(this);
+		}
+	}
+
+	// Client-only setup below (input mapping, HUD) needs a local player controller
+	if (bDedicatedServer || !IsLocallyControlled() || !IsPlayerControlled())
+	{
+		return;
+	}
+
+	SetupLocalPlayerFeatures();
+
+	ATrialReplayController::StartFromCommandLine(this);
+}
+
+void ACustomCharacter::PawnClientRestart()
+{
+	Super::PawnClientRestart();
+
+	// Every local possession, including characters reused from UTrialCharacterPool (BeginPlay already ran)
+	SetupLocalPlayerFeatures();
+
+	// A pooled pawn that was animated as a remote one becomes the full-rate, unshared local one
+	if (UTrialAnimCrowdSubsystem* AnimCrowd = GetWorld()->GetSubsystem<UTrialAnimCrowdSubsystem>())
+	{
+		AnimCrowd->RegisterCharacter(this);
+	}
+
+	PredictiveStreaming->RefreshStreamingRole();
+}
+
+void ACustomCharacter::NotifyControllerChanged()
+{
+	Super::NotifyControllerChanged();
+
+	// Possession and unpossession on the server, controller replication on clients
+	PredictiveStreaming->RefreshStreamingRole();
+
+	// A pooled pawn that stops being the local one goes back to budgeted, shared animation
+	if (HasActorBegunPlay() && !IsNetMode(NM_DedicatedServer))
 	{
-		if (ULocalPlayer* LP = PC->GetLocalPlayer())
+		if (UTrialAnimCrowdSubsystem* AnimCrowd = GetWorld()->GetSubsystem<UTrialAnimCrowdSubsystem>())
 		{
-			if (UEnhancedInputLocalPlayerSubsystem* Subsystem = LP->GetSubsystem<UEnhancedInputLocalPlayerSubsystem>())
+			AnimCrowd->RegisterCharacter(this);
+		}
+	}
+}
+
+void ACustomCharacter::SetupLocalPlayerFeatures()
+{
+	APlayerController* LocalPC = Cast<APlayerController>(GetController());
+	if (IsNetMode(NM_DedicatedServer) || !LocalPC || !LocalPC->IsLocalController())
+	{
+		return;
+	}
+
+	// Enhanced Input mapping context (kept when the same player takes a pooled character again)
+	if (ULocalPlayer* LP = LocalPC->GetLocalPlayer())
+	{
+		if (UEnhancedInputLocalPlayerSubsystem* Subsystem = LP->GetSubsystem<UEnhancedInputLocalPlayerSubsystem>())
+		{
+			if (DefaultMappingContext && !Subsystem->HasMappingContext(DefaultMappingContext))
 			{
-				if (DefaultMappingContext)
-				{
-					Subsystem->ClearAllMappings();
-					Subsystem->AddMappingContext(DefaultMappingContext, 0);
-				}
+				Subsystem->ClearAllMappings();
+				Subsystem->AddMappingContext(DefaultMappingContext, 0);
 			}
 		}
 	}
 
-	// Stamina UI
-	if (StaminaWidgetClass && !StaminaWidget)
+	// Stamina UI: created once per character, re-added when a pooled character is reused
+	if (StaminaWidget)
 	{
-		if (APlayerController* PC = Cast<APlayerController>(GetController()))
+		if (!StaminaWidget->IsInViewport())
 		{
-			StaminaWidget = CreateWidget<UStaminaWidget>(PC, StaminaWidgetClass);
-			if (StaminaWidget)
+			StaminaWidget->AddToViewport();
+		}
+	}
+	else if (StaminaWidgetClass)
+	{
+		LLM_SCOPE_BYTAG(TrialTask_HUD);
+
+		StaminaWidget = CreateWidget<UStaminaWidget>(LocalPC, StaminaWidgetClass);
+		if (StaminaWidget)
+		{
+			StaminaWidget->AddToViewport();
+			if (!CustomMoveComp)
 			{
-				StaminaWidget->AddToViewport();
-				if (!CustomMoveComp)
-				{
-					CustomMoveComp = Cast<UCustomMovementComponent>(GetCharacterMovement());
-				}
-				StaminaWidget->SetMovementComponent(CustomMoveComp);
+				CustomMoveComp = Cast<UCustomMovementComponent>(GetCharacterMovement());
 			}
+			StaminaWidget->SetMovementComponent(CustomMoveComp);
 		}
 	}
 }
 
+void ACustomCharacter::ResetForPool()
+{
+	// EndParkour clears the traversal set and restores gravity / walking, forced so a half-started move is covered too
+	EndParkour(true, true);
+	bVaultApexNoFit = true;
+	bJumpRequested = false;
+
+	if (CustomMoveComp)
+	{
+		CustomMoveComp->ResetTraversalState();
+	}
+
+	StopJumping();
+	UnCrouch();
+
+	if (UAnimInstance* AnimInstance = GetMesh() ? GetMesh()->GetAnimInstance() : nullptr)
+	{
+		AnimInstance->StopAllMontages(0.f);
+	}
+
+	if (StaminaWidget)
+	{
+		StaminaWidget->RemoveFromParent();
+	}
+
+	InputRecorder.Reset();
+	HeldActionMask = 0;
+	FlightRecorder.Reset();
+	PoseHistory.Reset();
+
+	bProxyTraversal = false;
+	TraversalState = FTraversalNetState();
+
+	// The graph keeps the period of the last push; a pawn parked while idle would otherwise come back with the
+	// idle period, and UpdateReplicationActivity only pushes changes of the cached flag
+	bReplicationActive = true;
+	if (UTrialReplicationGraph* Graph = UTrialReplicationGraph::Get(GetWorld()))
+	{
+		Graph->SetTraversalActive(this, true);
+	}
+}
+
+void ACustomCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (bCountedInNetStats)
+	{
+		--FTraversalNetStats::NumPawns;
+		bCountedInNetStats = false;
+	}
+
+	if (UTrialAnimCrowdSubsystem* AnimCrowd = GetWorld() ? GetWorld()->GetSubsystem<UTrialAnimCrowdSubsystem>() : nullptr)
+	{
+		AnimCrowd->UnregisterCharacter(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ACustomCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	// The owning client runs its own traversal; only other machines need the summary
+	DOREPLIFETIME_CONDITION(ACustomCharacter, TraversalState, COND_SimulatedOnly);
+}
+
 void ACustomCharacter::Tick(float DeltaSeconds)
 {
+	PARKOUR_SCOPE(STAT_CharacterTick);
+
+	const bool bSimulatedProxy = GetLocalRole() == ROLE_SimulatedProxy;
+	FParkourProxyCostScope ProxyCost(bSimulatedProxy);
+
 	Super::Tick(DeltaSeconds);
 
-	if (!bIsParkouring || ParkourPhase == EParkourPhase::None)
+	if (bSimulatedProxy)
+	{
+		++FParkourProxyCost::PawnTicks;
+		TickSimulatedTraversal(DeltaSeconds);
+		return;
+	}
+
+	if (InputRecorder && Controller)
+	{
+		InputRecorder->CommitFrame(DeltaSeconds, Controller->GetControlRotation());
+	}
+
+	if (HasAuthority() && !IsNetMode(NM_Standalone))
+	{
+		UpdateReplicationActivity();
+		UpdateTraversalNetState();
+
+		if (!IsLocallyControlled())
+		{
+			PoseHistory.Record(GetWorld()->GetTimeSeconds(), GetActorLocation(), GetActorRotation());
+		}
+	}
+
+	const EParkourPhase Phase = GetTraversalModeState().GetParkourPhase();
+	if (Phase == EParkourPhase::None)
 	{
 		return;
 	}
 
 	// Phase movement (geometrico)
-	if (ParkourPhase == EParkourPhase::ToApex)
+	if (Phase == EParkourPhase::ToApex)
 	{
 		if (ParkourMoveStep(DeltaSeconds, ParkourStart, ParkourApex, PhaseDuration))
 		{
 			AdvanceParkourPhase();
 		}
 	}
-	else if (ParkourPhase == EParkourPhase::ToTarget)
+	else if (Phase == EParkourPhase::ToTarget)
 	{
 		if (ParkourMoveStep(DeltaSeconds, ParkourApex, ParkourTarget, PhaseDuration))
 		{
@@ -132,8 +346,8 @@ void ACustomCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputCom
 
 	if (IA_Jump)
 	{
-		EIC->BindAction(IA_Jump, ETriggerEvent::Started, this, &ACharacter::Jump);
-		EIC->BindAction(IA_Jump, ETriggerEvent::Completed, this, &ACharacter::StopJumping);
+		EIC->BindAction(IA_Jump, ETriggerEvent::Started, this, &ACustomCharacter::JumpPressed);
+		EIC->BindAction(IA_Jump, ETriggerEvent::Completed, this, &ACustomCharacter::JumpReleased);
 	}
 
 	if (IA_Sprint)
@@ -160,6 +374,11 @@ void ACustomCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputCom
 
 void ACustomCharacter::SetInputLocked(bool bLocked)
 {
+	if (CustomMoveComp)
+	{
+		CustomMoveComp->SetTraversalInputLocked(bLocked);
+	}
+
 	if (bLocked)
 	{
 		if (UCharacterMovementComponent* Move = GetCharacterMovement())
@@ -183,25 +402,37 @@ void ACustomCharacter::SetInputLocked(bool bLocked)
 
 void ACustomCharacter::MoveForward(const FInputActionValue& Value)
 {
-	if (bInputLocked || bIsParkouring) return;
+	if (InputRecorder) InputRecorder->NoteMoveForward(Value.Get<float>());
+
+	if (!GetTraversalModeState().AcceptsMoveInput()) return;
 
 	const float Axis = Value.Get<float>();
 	if (!Controller || FMath::IsNearlyZero(Axis)) return;
 
 	const FRotator YawRot(0.f, Controller->GetControlRotation().Yaw, 0.f);
 	const FVector ForwardDir = FRotationMatrix(YawRot).GetUnitAxis(EAxis::X);
+	if (GetPendingMovementInputVector().IsNearlyZero() && GetLastMovementInputVector().IsNearlyZero() && GetVelocity().IsNearlyZero())
+	{
+		FTrialInputLatency::NoteInput(this, ETrialLatencyAction::Move);
+	}
 	AddMovementInput(ForwardDir, Axis);
 }
 
 void ACustomCharacter::MoveRight(const FInputActionValue& Value)
 {
-	if (bInputLocked || bIsParkouring) return;
+	if (InputRecorder) InputRecorder->NoteMoveRight(Value.Get<float>());
+
+	if (!GetTraversalModeState().AcceptsMoveInput()) return;
 
 	const float Axis = Value.Get<float>();
 	if (!Controller || FMath::IsNearlyZero(Axis)) return;
 
 	const FRotator YawRot(0.f, Controller->GetControlRotation().Yaw, 0.f);
 	const FVector RightDir = FRotationMatrix(YawRot).GetUnitAxis(EAxis::Y);
+	if (GetPendingMovementInputVector().IsNearlyZero() && GetLastMovementInputVector().IsNearlyZero() && GetVelocity().IsNearlyZero())
+	{
+		FTrialInputLatency::NoteInput(this, ETrialLatencyAction::Move);
+	}
 	AddMovementInput(RightDir, Axis);
 }
 
@@ -216,21 +447,35 @@ void ACustomCharacter::Look(const FInputActionValue& Value)
 
 void ACustomCharacter::SprintPressed(const FInputActionValue& Value)
 {
-	if (bInputLocked || bIsParkouring) return;
-	if (CustomMoveComp) CustomMoveComp->SetSprintRequested(true);
+	NoteAction(ETrialInputAction::Sprint, true);
+
+	if (!GetTraversalModeState().AcceptsMoveInput()) return;
+	if (!CustomMoveComp) return;
+
+	// Only measurable once walking at full speed: sprint shows as speed above WalkSpeed
+	if (CustomMoveComp->GetHorizontalSpeed() >= CustomMoveComp->GetWalkSpeed() * 0.95f)
+	{
+		FTrialInputLatency::NoteInput(this, ETrialLatencyAction::Sprint);
+	}
+	CustomMoveComp->SetSprintRequested(true);
 }
 
 void ACustomCharacter::SprintReleased(const FInputActionValue& Value)
 {
+	NoteAction(ETrialInputAction::Sprint, false);
+
 	if (CustomMoveComp) CustomMoveComp->SetSprintRequested(false);
 }
 
 void ACustomCharacter::CrouchPressed(const FInputActionValue& Value)
 {
-	if (bInputLocked || bIsParkouring) return;
+	NoteAction(ETrialInputAction::Crouch, true);
+
+	if (!GetTraversalModeState().AcceptsMoveInput()) return;
 
 	if (CustomMoveComp && CustomMoveComp->CanStartSlide())
 	{
+		FTrialInputLatency::NoteInput(this, ETrialLatencyAction::Slide);
 		CustomMoveComp->StartSlide();
 		Crouch();
 		return;
@@ -242,6 +487,8 @@ void ACustomCharacter::CrouchPressed(const FInputActionValue& Value)
 
 void ACustomCharacter::CrouchReleased(const FInputActionValue& Value)
 {
+	NoteAction(ETrialInputAction::Crouch, false);
+
 	if (CustomMoveComp && CustomMoveComp->IsSliding())
 	{
 		CustomMoveComp->StopSlide();
@@ -251,59 +498,250 @@ void ACustomCharacter::CrouchReleased(const FInputActionValue& Value)
 	if (CustomMoveComp) CustomMoveComp->SetCrouchRequested(false);
 }
 
+// --------------------
+// INPUT INJECTION
+// --------------------
+
+void ACustomCharacter::InjectMoveInput(const FVector2D& Axes)
+{
+	MoveForward(FInputActionValue(Axes.Y));
+	MoveRight(FInputActionValue(Axes.X));
+}
+
+void ACustomCharacter::InjectLookInput(const FVector2D& Axes)
+{
+	if (!Controller) return;
+
+	// AddController*Input only works for player controllers; other controllers rotate directly
+	if (!Controller->IsLocalPlayerController())
+	{
+		FRotator ControlRot = Controller->GetControlRotation();
+		ControlRot.Yaw += Axes.X;
+		ControlRot.Pitch = FMath::ClampAngle(ControlRot.Pitch - Axes.Y, -89.f, 89.f);
+		Controller->SetControlRotation(ControlRot);
+		return;
+	}
+
+	Look(FInputActionValue(Axes));
+}
+
+void ACustomCharacter::InjectAction(ETrialInputAction Action, bool bPressed)
+{
+	const FInputActionValue Value(bPressed);
+
+	switch (Action)
+	{
+	case ETrialInputAction::Jump:
+		bPressed ? JumpPressed(Value) : JumpReleased(Value);
+		break;
+	case ETrialInputAction::Sprint:
+		bPressed ? SprintPressed(Value) : SprintReleased(Value);
+		break;
+	case ETrialInputAction::Crouch:
+		bPressed ? CrouchPressed(Value) : CrouchReleased(Value);
+		break;
+	case ETrialInputAction::Parkour:
+		if (bPressed) ParkourPressed(Value);
+		break;
+	default:
+		break;
+	}
+}
+
+FPackedTraversalState ACustomCharacter::GetTraversalModeState() const
+{
+	return CustomMoveComp ? CustomMoveComp->GetTraversalState() : FPackedTraversalState();
+}
+
+bool ACustomCharacter::IsSprintActive() const
+{
+	return CustomMoveComp && CustomMoveComp->IsSprinting();
+}
+
+bool ACustomCharacter::IsSlideActive() const
+{
+	return CustomMoveComp && CustomMoveComp->IsSliding();
+}
+
+// --------------------
+// INPUT RECORD / REPLAY
+// --------------------
+
+void ACustomCharacter::JumpPressed(const FInputActionValue& Value)
+{
+	NoteAction(ETrialInputAction::Jump, true);
+	Jump();
+}
+
+void ACustomCharacter::JumpReleased(const FInputActionValue& Value)
+{
+	NoteAction(ETrialInputAction::Jump, false);
+	StopJumping();
+}
+
+void ACustomCharacter::NoteAction(ETrialInputAction Action, bool bPressed)
+{
+	// Parkour is a tap with no release binding, so it is never held
+	if (Action != ETrialInputAction::Parkour)
+	{
+		const uint8 Bit = 1u << (uint8)Action;
+		HeldActionMask = bPressed ? (HeldActionMask | Bit) : (HeldActionMask & ~Bit);
+	}
+
+	if (InputRecorder)
+	{
+		InputRecorder->NoteAction(Action, bPressed);
+	}
+}
+
+bool ACustomCharacter::StartInputRecording()
+{
+	if (InputRecorder) return false;
+
+	InputRecorder = MakeUnique<FTrialInputRecorder>(CaptureReplayState());
+	return true;
+}
+
+bool ACustomCharacter::StopInputRecording(const FString& Path)
+{
+	if (!InputRecorder) return false;
+
+	const bool bSaved = InputRecorder->GetRecording().SaveToFile(Path);
+	UE_LOG(LogTemp, Display, TEXT("REPLAY: recorded %d frames -> %s (%s)"),
+		InputRecorder->GetRecording().Frames.Num(), *Path, bSaved ? TEXT("ok") : TEXT("write failed"));
+
+	InputRecorder.Reset();
+	return bSaved;
+}
+
+FTrialReplayInitialState ACustomCharacter::CaptureReplayState() const
+{
+	FTrialReplayInitialState State;
+	State.Location = GetActorLocation();
+	State.Rotation = GetActorRotation();
+	State.ControlRotation = Controller ? Controller->GetControlRotation() : GetActorRotation();
+	State.Velocity = GetVelocity();
+	State.bIsCrouched = bIsCrouched;
+	State.HeldActionMask = HeldActionMask;
+
+	if (CustomMoveComp)
+	{
+		State.Stamina = CustomMoveComp->GetStamina();
+		State.MovementMode = CustomMoveComp->MovementMode;
+		State.CustomMovementMode = CustomMoveComp->CustomMovementMode;
+	}
+	return State;
+}
+
+void ACustomCharacter::ApplyReplayState(const FTrialReplayInitialState& State)
+{
+	EndParkour(true, true);
+
+	// Held actions as they were when recording started; the recording only has the edges after that
+	HeldActionMask = State.HeldActionMask;
+	const bool bSprintHeld = (HeldActionMask & (1u << (uint8)ETrialInputAction::Sprint)) != 0;
+	const bool bCrouchHeld = (HeldActionMask & (1u << (uint8)ETrialInputAction::Crouch)) != 0;
+
+	if (CustomMoveComp)
+	{
+		CustomMoveComp->StopSlide();
+		CustomMoveComp->SetSprintRequested(bSprintHeld);
+		CustomMoveComp->SetCrouchRequested(bCrouchHeld);
+	}
+
+	SetActorLocationAndRotation(State.Location, State.Rotation, false, nullptr, ETeleportType::ResetPhysics);
+	if (Controller)
+	{
+		Controller->SetControlRotation(State.ControlRotation);
+	}
+
+	State.bIsCrouched ? Crouch() : UnCrouch();
+
+	if (CustomMoveComp)
+	{
+		CustomMoveComp->SetStamina(State.Stamina);
+
+		// A slide in progress is not resumed: slide state is rebuilt from the recorded crouch edges
+		const EMovementMode Mode = (EMovementMode)State.MovementMode;
+		CustomMoveComp->SetMovementMode(Mode == MOVE_Custom ? MOVE_Walking : Mode);
+		CustomMoveComp->Velocity = State.Velocity;
+	}
+}
+
 // --------------------
 // PARKOUR (detection + geometric move)
 // --------------------
 
 void ACustomCharacter::ParkourPressed(const FInputActionValue& Value)
 {
-	if (bInputLocked || bIsParkouring) return;
+	NoteAction(ETrialInputAction::Parkour, true);
+
+	if (!GetTraversalModeState().CanStartParkour()) return;
+
+	FTrialInputLatency::NoteInput(this, ETrialLatencyAction::Parkour);
+
+	PARKOUR_SCOPE(STAT_ParkourPressed);
+	PARKOUR_NO_ALLOC_SCOPE(ParkourPressed);
+	LLM_SCOPE_BYTAG(TrialTask_Parkour);
+
+	FlightRecorder.Record(EParkourTraceEvent::Pressed, 0, GetActorLocation(), GetActorForwardVector(), GetVelocity(), Value.Get<float>());
 
 	FHitResult FrontHit, TopHit;
 	float ObstacleHeight = 0.f;
 	FVector TopPoint = FVector::ZeroVector;
+	FTrialParkourObstacleInfo ObstacleInfo;
 
-	if (!FindParkourObstacle(FrontHit, TopHit, ObstacleHeight, TopPoint))
+	if (!FindParkourObstacle(FrontHit, TopHit, ObstacleHeight, TopPoint, ObstacleInfo))
 	{
-		UE_LOG(LogTemp, Warning, TEXT("PARKOUR: no valid obstacle"));
+		FlightRecorder.Record(EParkourTraceEvent::NoObstacle, FrontHit.bBlockingHit ? 1 : 0, GetActorLocation(), FrontHit.ImpactPoint, FrontHit.ImpactNormal);
 		return;
 	}
 
-	const EParkourType Type = DecideParkourType(ObstacleHeight);
+	const EParkourType Type = DecideParkourType(ObstacleHeight, ObstacleInfo);
 	if (Type == EParkourType::None)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("PARKOUR: obstacle out of range (height=%.1f)"), ObstacleHeight);
+		FlightRecorder.Record(EParkourTraceEvent::OutOfRange, 0, GetActorLocation(), TopPoint, TopHit.ImpactNormal, ObstacleHeight);
 		return;
 	}
 
 	FVector SafeTarget = FVector::ZeroVector;
 	if (!ComputeSafeParkourLanding(FrontHit, TopPoint, SafeTarget))
 	{
-		UE_LOG(LogTemp, Warning, TEXT("PARKOUR: landing blocked"));
+		FlightRecorder.Record(EParkourTraceEvent::LandingBlocked, (uint8)Type, GetActorLocation(), TopPoint, FrontHit.ImpactNormal, ObstacleHeight);
+		DumpFlightRecorder(EParkourTraceDumpReason::LandingBlocked);
 		return;
 	}
 
-	StartParkour(Type, SafeTarget, TopPoint);
+	if (StartParkour(Type, SafeTarget, TopPoint) && GetLocalRole() == ROLE_AutonomousProxy)
+	{
+		const AGameStateBase* GameState = GetWorld()->GetGameState();
+		const double ClientTime = GameState ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
+		ServerStartParkour(Type, FrontHit.GetActor(), TopPoint, ParkourApex, ParkourTarget, ClientTime, ++ParkourStartId);
+	}
 }
 
-EParkourType ACustomCharacter::DecideParkourType(float ObstacleHeight) const
+EParkourType ACustomCharacter::DecideParkourType(float ObstacleHeight, const FTrialParkourObstacleInfo& Info) const
 {
-	if (ObstacleHeight <= VaultMaxObstacleHeight) return EParkourType::Vault;
-	if (ObstacleHeight <= MantleMaxObstacleHeight) return EParkourType::Mantle;
+	// Server validation maps heights to types, so a disallowed vault does not fall through to mantle
+	if (ObstacleHeight <= VaultMaxObstacleHeight) return Info.bAllowVault ? EParkourType::Vault : EParkourType::None;
+	if (ObstacleHeight <= MantleMaxObstacleHeight) return Info.bAllowMantle ? EParkourType::Mantle : EParkourType::None;
 	return EParkourType::None;
 }
 
-bool ACustomCharacter::FindParkourObstacle(FHitResult& OutFrontHit, FHitResult& OutTopHit, float& OutObstacleHeight, FVector& OutTopPoint) const
+bool ACustomCharacter::FindParkourObstacle(FHitResult& OutFrontHit, FHitResult& OutTopHit, float& OutObstacleHeight, FVector& OutTopPoint, FTrialParkourObstacleInfo& OutInfo) const
 {
+	PARKOUR_SCOPE(STAT_FindParkourObstacle);
+
 	UWorld* World = GetWorld();
 	if (!World) return false;
 
-	const FVector Start = GetActorLocation() + FVector(0, 0, 50);
+	const FVector Start = GetActorLocation() + FVector(0, 0, ParkourQueryOffsets::FrontSweepUp);
 	const FVector Forward = GetActorForwardVector();
 	const FVector End = Start + Forward * ParkourFrontCheckDistance;
 
-	FCollisionQueryParams Params(SCENE_QUERY_STAT(ParkourFront), false, this);
+	const FCollisionQueryParams& Params = FrontQueryParams;
 
+	PARKOUR_COUNT(Sweeps);
 	const bool bFrontHit = World->SweepSingleByChannel(
 		OutFrontHit,
 		Start,
@@ -319,14 +757,27 @@ bool ACustomCharacter::FindParkourObstacle(FHitResult& OutFrontHit, FHitResult&
 		return false;
 	}
 
-	if (!OutFrontHit.GetActor()->ActorHasTag(TAG_PARKOURABLE))
+	if (!TrialParkourObstacle::Resolve(OutFrontHit, OutInfo))
 	{
 		return false;
 	}
 
+	const float FeetZ = GetActorLocation().Z;
+
+	// Instanced obstacles know their top; no trace needed
+	if (OutInfo.bHasTop)
+	{
+		OutTopPoint = FVector(OutFrontHit.ImpactPoint.X, OutFrontHit.ImpactPoint.Y, OutInfo.TopZ);
+		OutTopHit = FHitResult(OutFrontHit.GetActor(), OutFrontHit.GetComponent(), OutTopPoint, FVector::UpVector);
+		OutTopHit.Item = OutFrontHit.Item;
+		OutObstacleHeight = OutTopPoint.Z - FeetZ;
+		return true;
+	}
+
 	const FVector TopStart = OutFrontHit.ImpactPoint + FVector(0, 0, ParkourTopTraceHeight);
 	const FVector TopEnd = OutFrontHit.ImpactPoint - FVector(0, 0, ParkourTopTraceHeight);
 
+	PARKOUR_COUNT(LineTraces);
 	const bool bTopHit = World->LineTraceSingleByChannel(
 		OutTopHit,
 		TopStart,
@@ -340,7 +791,6 @@ bool ACustomCharacter::FindParkourObstacle(FHitResult& OutFrontHit, FHitResult&
 		return false;
 	}
 
-	const float FeetZ = GetActorLocation().Z;
 	OutTopPoint = OutTopHit.ImpactPoint;
 	OutObstacleHeight = OutTopPoint.Z - FeetZ;
 
@@ -349,6 +799,8 @@ bool ACustomCharacter::FindParkourObstacle(FHitResult& OutFrontHit, FHitResult&
 
 bool ACustomCharacter::ComputeSafeParkourLanding(const FHitResult& FrontHit, const FVector& TopPoint, FVector& OutSafeLocation) const
 {
+	PARKOUR_SCOPE(STAT_ComputeSafeParkourLanding);
+
 	UWorld* World = GetWorld();
 	if (!World) return false;
 
@@ -363,14 +815,16 @@ bool ACustomCharacter::ComputeSafeParkourLanding(const FHitResult& FrontHit, con
 	FVector Desired = TopPoint;
 	Desired += Forward * (CapsuleRadius + ParkourLandForwardOffset + ParkourLandingForwardExtra);
 
-	FCollisionQueryParams Params(SCENE_QUERY_STAT(ParkourLandTrace), false, this);
+	const FCollisionQueryParams& Params = LandQueryParams;
 
 	FHitResult GroundHit;
 	const FVector GroundStart = Desired + FVector(0, 0, 250.f);
 	const FVector GroundEnd = Desired - FVector(0, 0, 600.f);
 
+	PARKOUR_COUNT(LineTraces);
 	if (!World->LineTraceSingleByChannel(GroundHit, GroundStart, GroundEnd, ECC_Visibility, Params))
 	{
+		FlightRecorder.Record(EParkourTraceEvent::LandingCandidate, 0, GetActorLocation(), Desired, FVector::ZeroVector, -1.f);
 		return false;
 	}
 
@@ -383,6 +837,7 @@ bool ACustomCharacter::ComputeSafeParkourLanding(const FHitResult& FrontHit, con
 	);
 
 	FHitResult CapsuleHit;
+	PARKOUR_COUNT(Sweeps);
 	const bool bBlocked = World->SweepSingleByChannel(
 		CapsuleHit,
 		Candidate,
@@ -393,6 +848,8 @@ bool ACustomCharacter::ComputeSafeParkourLanding(const FHitResult& FrontHit, con
 		Params
 	);
 
+	FlightRecorder.Record(EParkourTraceEvent::LandingCandidate, 1, GetActorLocation(), Candidate, bBlocked ? CapsuleHit.ImpactNormal : GroundHit.ImpactNormal, bBlocked ? 1.f : 0.f);
+
 	if (!bBlocked)
 	{
 		OutSafeLocation = Candidate;
@@ -400,8 +857,10 @@ bool ACustomCharacter::ComputeSafeParkourLanding(const FHitResult& FrontHit, con
 	}
 
 	// small forward fallback
-	const FVector Candidate2 = Candidate + Forward * (CapsuleRadius * 0.75f);
+	const FVector Candidate2 = Candidate + Forward * (CapsuleRadius * ParkourQueryOffsets::LandingFallbackRadiusScale);
 
+	PARKOUR_COUNT(Fallbacks);
+	PARKOUR_COUNT(Sweeps);
 	const bool bBlocked2 = World->SweepSingleByChannel(
 		CapsuleHit,
 		Candidate2,
@@ -412,6 +871,8 @@ bool ACustomCharacter::ComputeSafeParkourLanding(const FHitResult& FrontHit, con
 		Params
 	);
 
+	FlightRecorder.Record(EParkourTraceEvent::LandingCandidate, 2, GetActorLocation(), Candidate2, CapsuleHit.ImpactNormal, bBlocked2 ? 1.f : 0.f);
+
 	if (!bBlocked2)
 	{
 		OutSafeLocation = Candidate2;
@@ -453,7 +914,7 @@ bool ACustomCharacter::ComputeParkourApex_Mantle(const FVector& TopPoint, FVecto
 	UWorld* World = GetWorld();
 	if (!World) return false;
 
-	FCollisionQueryParams Params(SCENE_QUERY_STAT(ParkourApexFit), false, this);
+	const FCollisionQueryParams& Params = ApexQueryParams;
 
 	FCollisionShape CapsuleShape = FCollisionShape::MakeCapsule(
 		CapsuleRadius + ParkourLandingCapsuleInflate,
@@ -461,6 +922,7 @@ bool ACustomCharacter::ComputeParkourApex_Mantle(const FVector& TopPoint, FVecto
 	);
 
 	FHitResult Hit;
+	PARKOUR_COUNT(Sweeps);
 	const bool bBlocked = World->SweepSingleByChannel(
 		Hit, Apex, Apex, FQuat::Identity, ECC_WorldStatic, CapsuleShape, Params
 	);
@@ -472,8 +934,10 @@ bool ACustomCharacter::ComputeParkourApex_Mantle(const FVector& TopPoint, FVecto
 	}
 
 	// fallback: alza un po'
-	Apex.Z += 20.f;
+	Apex.Z += ParkourQueryOffsets::RetryUp;
 
+	PARKOUR_COUNT(Fallbacks);
+	PARKOUR_COUNT(Sweeps);
 	const bool bBlocked2 = World->SweepSingleByChannel(
 		Hit, Apex, Apex, FQuat::Identity, ECC_WorldStatic, CapsuleShape, Params
 	);
@@ -490,26 +954,7 @@ bool ACustomCharacter::ComputeParkourApex_Mantle(const FVector& TopPoint, FVecto
 
 bool ACustomCharacter::StartParkour(EParkourType Type, const FVector& TargetLocation, const FVector& TopPoint)
 {
-	if (bInputLocked || bIsParkouring) return false;
-
-	UAnimInstance* AnimInstance = GetMesh() ? GetMesh()->GetAnimInstance() : nullptr;
-
-	UAnimMontage* MontageToPlay = nullptr;
-	if (Type == EParkourType::Vault)
-	{
-		MontageToPlay = VaultMontage;
-		bIsVaulting = true;
-		bIsMantling = false;
-	}
-	else if (Type == EParkourType::Mantle)
-	{
-		MontageToPlay = MantleMontage;
-		bIsVaulting = false;
-		bIsMantling = true;
-	}
-
-	// NOTE: se non hai montage buoni, puoi anche lasciarlo NULL: il move geometrico funziona lo stesso
-	CurrentParkourMontage = MontageToPlay;
+	if (!GetTraversalModeState().Can(FPackedTraversalState::StartEventFor(Type))) return false;
 
 	// Points
 	FVector Apex;
@@ -526,36 +971,44 @@ bool ACustomCharacter::StartParkour(EParkourType Type, const FVector& TargetLoca
 
 	if (!bApexOk)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("PARKOUR: Apex blocked (mantle)"));
+		FlightRecorder.Record(EParkourTraceEvent::ApexBlocked, (uint8)Type, GetActorLocation(), TopPoint, FVector::ZeroVector);
+		DumpFlightRecorder(EParkourTraceDumpReason::ApexBlocked);
 		return false;
 	}
 
+	return BeginParkourMove(Type, Apex, TargetLocation, TopPoint);
+}
+
+bool ACustomCharacter::BeginParkourMove(EParkourType Type, const FVector& Apex, const FVector& TargetLocation, const FVector& TopPoint)
+{
+	if (Type == EParkourType::None) return false;
+
+	// Enters <Type>ToApex; ends a sprint or slide on the way
+	if (!CustomMoveComp || !CustomMoveComp->ApplyTraversalEvent(FPackedTraversalState::StartEventFor(Type))) return false;
+
+	UAnimInstance* AnimInstance = GetMesh() ? GetMesh()->GetAnimInstance() : nullptr;
 
-	bIsParkouring = true;
-	CurrentParkour = Type;
+	UAnimMontage* MontageToPlay = (Type == EParkourType::Vault) ? VaultMontage.Get() : MantleMontage.Get();
+
+	// NOTE: se non hai montage buoni, puoi anche lasciarlo NULL: il move geometrico funziona lo stesso
+	CurrentParkourMontage = MontageToPlay;
 
 	ParkourStart = GetActorLocation();
 	ParkourApex = Apex;
 	ParkourTarget = TargetLocation;
+	ParkourObstacleTop = TopPoint;
 
-	ParkourPhase = EParkourPhase::ToApex;
 	PhaseElapsed = 0.f;
 
-	PhaseDuration = (Type == EParkourType::Vault) ? VaultToApexDuration : MantleToApexDuration;
+	PhaseDuration = GetParkourPhaseDuration(Type, EParkourPhase::ToApex);
 
 	SetInputLocked(true);
 
-	// Play montage (solo estetica)
-	if (AnimInstance && MontageToPlay)
+	// Play montage (solo estetica, never on dedicated servers)
+	if (AnimInstance && MontageToPlay && !IsNetMode(NM_DedicatedServer))
 	{
-		FOnMontageBlendingOutStarted BlendOutDel;
-		BlendOutDel.BindUObject(this, &ACustomCharacter::OnParkourMontageBlendOut);
-		AnimInstance->Montage_SetBlendingOutDelegate(BlendOutDel, MontageToPlay);
-
-		FOnMontageEnded EndDel;
-		EndDel.BindUObject(this, &ACustomCharacter::OnParkourMontageEnded);
-		AnimInstance->Montage_SetEndDelegate(EndDel, MontageToPlay);
-
+		// The engine allocates a new montage instance per play; cosmetic and outside our control
+		PARKOUR_ALLOW_ALLOC_SCOPE();
 		AnimInstance->Montage_Play(MontageToPlay, 1.0f);
 	}
 
@@ -563,13 +1016,151 @@ bool ACustomCharacter::StartParkour(EParkourType Type, const FVector& TargetLoca
 	const float Total = ((Type == EParkourType::Vault) ? (VaultToApexDuration + VaultToTargetDuration) : (MantleToApexDuration + MantleToTargetDuration));
 	const float FailSafeDelay = FMath::Max(0.15f, Total + ParkourFailSafeExtraTime);
 
-	GetWorldTimerManager().ClearTimer(ParkourFailsafeTimer);
-	GetWorldTimerManager().SetTimer(
-		ParkourFailsafeTimer,
-		FTimerDelegate::CreateUObject(this, &ACustomCharacter::EndParkour, false, true),
-		FailSafeDelay,
-		false
-	);
+	FlightRecorder.Record(EParkourTraceEvent::Started, (uint8)Type, ParkourStart, ParkourTarget, ParkourApex, Total);
+
+	{
+		// The timer binds a delegate per start; exempt like Montage_Play
+		PARKOUR_ALLOW_ALLOC_SCOPE();
+		GetWorldTimerManager().SetTimer(ParkourFailsafeTimer, this, &ACustomCharacter::OnParkourFailsafe, FailSafeDelay, false);
+	}
+
+	return true;
+}
+
+// --------------------
+// SERVER VALIDATION (lag compensated)
+// --------------------
+
+void ACustomCharacter::ServerStartParkour_Implementation(EParkourType Type, AActor* Obstacle, FVector_NetQuantize TopPoint, FVector_NetQuantize Apex, FVector_NetQuantize Target, double ClientTime, uint16 StartId)
+{
+	// Every path that does not start the traversal here tells the client, or it keeps running one the server never had
+	const TCHAR* Reason = nullptr;
+	if (IsParkouring())
+	{
+		Reason = TEXT("already traversing");
+	}
+	else if (ValidateParkourStart(Type, Obstacle, TopPoint, Apex, Target, ClientTime, Reason))
+	{
+		if (BeginParkourMove(Type, Apex, Target, TopPoint))
+		{
+			CSV_CUSTOM_STAT(Parkour, ServerParkourAccepted, 1, ECsvCustomStatOp::Accumulate);
+			return;
+		}
+		Reason = TEXT("could not begin move");
+	}
+
+	CSV_CUSTOM_STAT(Parkour, ServerParkourRejected, 1, ECsvCustomStatOp::Accumulate);
+	UE_LOG(LogTemp, Verbose, TEXT("PARKOUR: rejected %s start from %s (%s)"),
+		Type == EParkourType::Vault ? TEXT("vault") : TEXT("mantle"), *GetName(), Reason ? Reason : TEXT("?"));
+
+	FlightRecorder.Record(EParkourTraceEvent::ServerRejected, (uint8)Type, GetActorLocation(), TopPoint, Target);
+	ClientRejectParkour(StartId);
+}
+
+void ACustomCharacter::ClientRejectParkour_Implementation(uint16 StartId)
+{
+	// A reject for an older start arriving after the client began a newer one (or already finished) is stale
+	if (StartId != ParkourStartId || !IsParkouring())
+	{
+		return;
+	}
+
+	FlightRecorder.Record(EParkourTraceEvent::ServerRejected, (uint8)GetTraversalModeState().GetParkourType(), GetActorLocation(), ParkourTarget);
+	DumpFlightRecorder(EParkourTraceDumpReason::ServerRejected);
+
+	// The movement correction that follows puts the capsule back where the server has it
+	EndParkour(true, true);
+}
+
+bool ACustomCharacter::ValidateParkourStart(EParkourType Type, const AActor* Obstacle, const FVector& TopPoint, const FVector& Apex, const FVector& Target, double ClientTime, const TCHAR*& OutReason) const
+{
+	PARKOUR_SCOPE(STAT_ValidateParkourStart);
+
+	const UCapsuleComponent* Capsule = GetCapsuleComponent();
+	if (!Capsule || Type == EParkourType::None)
+	{
+		OutReason = TEXT("invalid type");
+		return false;
+	}
+
+	if (!Obstacle || !Obstacle->ActorHasTag(TrialParkourObstacle::Tag))
+	{
+		OutReason = TEXT("obstacle not parkourable");
+		return false;
+	}
+
+	// Rewind to what the client saw, but never further than the configured window
+	const double Now = GetWorld()->GetTimeSeconds();
+	const double RewindTime = FMath::Clamp(ClientTime, Now - ParkourMaxRewindSeconds, Now);
+
+	FParkourPoseSample Pose;
+	if (!PoseHistory.Sample(RewindTime, Pose))
+	{
+		Pose.Location = GetActorLocation();
+		Pose.Rotation = GetActorRotation();
+	}
+
+	const float Tol = ParkourValidationTolerance;
+	const float CapsuleRadius = Capsule->GetScaledCapsuleRadius();
+	const float CapsuleHalfHeight = Capsule->GetScaledCapsuleHalfHeight();
+
+	// Obstacle top must be in reach of the rewound capsule (same limits as FindParkourObstacle / DecideParkourType)
+	const float Height = TopPoint.Z - Pose.Location.Z;
+	const float Reach = FVector::Dist2D(Pose.Location, TopPoint);
+	if (Reach > ParkourFrontCheckDistance + ParkourFrontCheckRadius + CapsuleRadius + Tol)
+	{
+		OutReason = TEXT("obstacle out of reach");
+		return false;
+	}
+	if (Height < -Tol || Height > MantleMaxObstacleHeight + Tol
+		|| (Type == EParkourType::Vault && Height > VaultMaxObstacleHeight + Tol)
+		|| (Type == EParkourType::Mantle && Height < VaultMaxObstacleHeight - Tol))
+	{
+		OutReason = TEXT("height does not match type");
+		return false;
+	}
+
+	// Top point must lie on the obstacle; moving obstacles get slack for how far they travelled since ClientTime
+	const float ObstacleSlack = Tol + Obstacle->GetVelocity().Size() * (float)(Now - RewindTime);
+	// Instanced fields span the whole map, so they are checked per instance
+	bool bOnObstacle = false;
+	if (const UTrialParkourObstacleComponent* Instanced = Cast<UTrialParkourObstacleComponent>(Obstacle->GetRootComponent()))
+	{
+		bOnObstacle = Instanced->IsPointOnObstacle(TopPoint, ObstacleSlack);
+	}
+	else
+	{
+		const FBox ObstacleBox = Obstacle->GetRootComponent() ? Obstacle->GetRootComponent()->Bounds.GetBox() : FBox(ForceInit);
+		bOnObstacle = ObstacleBox.IsValid && ObstacleBox.ExpandBy(ObstacleSlack).IsInside(TopPoint);
+	}
+	if (!bOnObstacle)
+	{
+		OutReason = TEXT("top point not on obstacle");
+		return false;
+	}
+
+	// Apex and target are derived from the top point by fixed offsets (ComputeParkourApex_*, ComputeSafeParkourLanding)
+	const float ApexMaxReach = CapsuleRadius + ApexForwardExtra + Tol;
+	const float ApexMaxUp = CapsuleHalfHeight + ApexUpExtra + ParkourQueryOffsets::RetryUp + Tol;
+	if (FVector::Dist2D(Apex, TopPoint) > ApexMaxReach || Apex.Z < TopPoint.Z || Apex.Z > TopPoint.Z + ApexMaxUp)
+	{
+		OutReason = TEXT("apex out of bounds");
+		return false;
+	}
+
+	const float TargetMaxReach = CapsuleRadius * (1.f + ParkourQueryOffsets::LandingFallbackRadiusScale) + ParkourLandForwardOffset + ParkourLandingForwardExtra + Tol;
+	if (FVector::Dist2D(Target, TopPoint) > TargetMaxReach)
+	{
+		OutReason = TEXT("target out of bounds");
+		return false;
+	}
+
+	// The one scene query: the landing capsule must fit in the present world
+	if (!TryTeleportIfFits(Target))
+	{
+		OutReason = TEXT("target blocked");
+		return false;
+	}
 
 	return true;
 }
@@ -580,6 +1171,7 @@ bool ACustomCharacter::TrySafeMoveDelta(const FVector& Delta)
 	if (!Move) return false;
 
 	FHitResult Hit;
+	PARKOUR_COUNT(Sweeps);
 	Move->SafeMoveUpdatedComponent(Delta, GetActorQuat(), true, Hit);
 
 	// check if blocked
@@ -596,6 +1188,7 @@ bool ACustomCharacter::TrySafeMoveDelta(const FVector& Delta)
 		const FVector SlideDelta = FVector::VectorPlaneProject(Delta, Hit.Normal) * RemainingTime;
 
 		FHitResult Hit2;
+		PARKOUR_COUNT(Sweeps);
 		Move->SafeMoveUpdatedComponent(SlideDelta, GetActorQuat(), true, Hit2);
 
 		// check if also the slide delta its blocked instantly
@@ -615,9 +1208,15 @@ bool ACustomCharacter::TrySafeMoveDelta(const FVector& Delta)
 
 bool ACustomCharacter::ParkourMoveStep(float DeltaSeconds, const FVector& From, const FVector& To, float Duration)
 {
+	PARKOUR_SCOPE(STAT_ParkourMoveStep);
+	PARKOUR_NO_ALLOC_SCOPE(ParkourMoveStep);
+	LLM_SCOPE_BYTAG(TrialTask_Parkour);
+
 	Duration = FMath::Max(0.01f, Duration);
 	PhaseElapsed += DeltaSeconds;
 
+	FTrialInputLatency::NoteMotion(this, ETrialLatencyAction::Parkour);
+
 	const float Alpha = FMath::Clamp(PhaseElapsed / Duration, 0.f, 1.f);
 	const FVector Desired = FMath::Lerp(From, To, Alpha);
 
@@ -631,6 +1230,8 @@ bool ACustomCharacter::ParkourMoveStep(float DeltaSeconds, const FVector& From,
 	}
 
 	// Fallback: try moving slightly UP (useful for mantle edge collision)
+	PARKOUR_COUNT(Fallbacks);
+	FlightRecorder.Record(EParkourTraceEvent::MoveStepFallback, 1, Current, Desired, FVector::ZeroVector, Alpha);
 	{
 		const FVector UpDelta = Delta + FVector(0, 0, MoveStepFallbackUp);
 		if (TrySafeMoveDelta(UpDelta))
@@ -640,6 +1241,8 @@ bool ACustomCharacter::ParkourMoveStep(float DeltaSeconds, const FVector& From,
 	}
 
 	// Fallback: try a bit more FORWARD (useful to clear the lip)
+	PARKOUR_COUNT(Fallbacks);
+	FlightRecorder.Record(EParkourTraceEvent::MoveStepFallback, 2, Current, Desired, FVector::ZeroVector, Alpha);
 	{
 		const FVector Fwd = GetActorForwardVector();
 		const FVector FwdDelta = Delta + Fwd * MoveStepFallbackForward;
@@ -649,29 +1252,35 @@ bool ACustomCharacter::ParkourMoveStep(float DeltaSeconds, const FVector& From,
 		}
 	}
 
+	PARKOUR_COUNT(Fallbacks);
+
 	// Still blocked -> stop parkour (NO PERMA LOCK)
 	// Still blocked -> recovery (mantle)
-	UE_LOG(LogTemp, Warning, TEXT("PARKOUR: blocked during move-step -> recovery"));
+	FlightRecorder.Record(EParkourTraceEvent::MoveStepBlocked, (uint8)GetTraversalModeState().GetParkourPhase(), GetActorLocation(), Desired, FVector::ZeroVector, Alpha);
+	DumpFlightRecorder(EParkourTraceDumpReason::MoveStepBlocked);
 
-	if (CurrentParkour == EParkourType::Mantle && !ParkourTarget.IsZero())
+	if (IsMantling() && !ParkourTarget.IsZero())
 	{
 		// Try to place it directly if the target fits
 		if (TryTeleportIfFits(ParkourTarget))
 		{
+			FlightRecorder.Record(EParkourTraceEvent::Recovery, 1, GetActorLocation(), ParkourTarget);
 			SetActorLocation(ParkourTarget, false, nullptr, ETeleportType::TeleportPhysics);
 			EndParkour(false, true);
 			return true;
 		}
 
 		// Fallback: Checks slightly upper
-		FVector UpTarget = ParkourTarget + FVector(0, 0, 20.f);
+		FVector UpTarget = ParkourTarget + FVector(0, 0, ParkourQueryOffsets::RetryUp);
 		if (TryTeleportIfFits(UpTarget))
 		{
+			FlightRecorder.Record(EParkourTraceEvent::Recovery, 2, GetActorLocation(), UpTarget);
 			SetActorLocation(UpTarget, false, nullptr, ETeleportType::TeleportPhysics);
 			EndParkour(false, true);
 			return true;
 		}
 	}
+	FlightRecorder.Record(EParkourTraceEvent::Recovery, 0, GetActorLocation(), ParkourTarget);
 	EndParkour(true, true);
 	return true;
 }
@@ -679,10 +1288,29 @@ bool ACustomCharacter::ParkourMoveStep(float DeltaSeconds, const FVector& From,
 void ACustomCharacter::AdvanceParkourPhase()
 {
 	// Apex -> LandTarget
-	ParkourPhase = EParkourPhase::ToTarget;
+	const EParkourType Type = GetTraversalModeState().GetParkourType();
+	FlightRecorder.Record(EParkourTraceEvent::PhaseAdvanced, (uint8)Type, GetActorLocation(), ParkourApex, FVector::ZeroVector, PhaseElapsed);
+
+	if (CustomMoveComp)
+	{
+		CustomMoveComp->ApplyTraversalEvent(ETraversalEvent::ApexReached);
+	}
 	PhaseElapsed = 0.f;
 
-	PhaseDuration = (CurrentParkour == EParkourType::Vault) ? VaultToTargetDuration : MantleToTargetDuration;
+	PhaseDuration = GetParkourPhaseDuration(Type, EParkourPhase::ToTarget);
+}
+
+float ACustomCharacter::GetParkourPhaseDuration(EParkourType Type, EParkourPhase Phase) const
+{
+	if (Phase == EParkourPhase::ToApex)
+	{
+		return (Type == EParkourType::Vault) ? VaultToApexDuration : MantleToApexDuration;
+	}
+	if (Phase == EParkourPhase::ToTarget)
+	{
+		return (Type == EParkourType::Vault) ? VaultToTargetDuration : MantleToTargetDuration;
+	}
+	return 0.f;
 }
 
 void ACustomCharacter::OnParkourMontageBlendOut(UAnimMontage* Montage, bool bInterrupted)
@@ -697,22 +1325,27 @@ void ACustomCharacter::OnParkourMontageEnded(UAnimMontage* Montage, bool bInterr
 
 void ACustomCharacter::EndParkour(bool bInterrupted, bool bForce)
 {
-	if (!bIsParkouring && !bForce) return;
+	const bool bWasParkouring = IsParkouring();
+	if (!bWasParkouring && !bForce) return;
 
 	GetWorldTimerManager().ClearTimer(ParkourFailsafeTimer);
-	
-	// reset states
-	bIsParkouring = false;
-	bIsVaulting = false;
-	bIsMantling = false;
 
-	CurrentParkour = EParkourType::None;
+	if (bWasParkouring)
+	{
+		FlightRecorder.Record(EParkourTraceEvent::Ended, bInterrupted ? 1 : 0, GetActorLocation(), ParkourTarget, FVector::ZeroVector, PhaseElapsed);
+	}
+
+	// reset states
+	if (CustomMoveComp)
+	{
+		CustomMoveComp->ApplyTraversalEvent(ETraversalEvent::TraversalEnd);
+	}
 	CurrentParkourMontage = nullptr;
 
-	ParkourPhase = EParkourPhase::None;
 	ParkourStart = FVector::ZeroVector;
 	ParkourApex = FVector::ZeroVector;
 	ParkourTarget = FVector::ZeroVector;
+	ParkourObstacleTop = FVector::ZeroVector;
 
 	PhaseElapsed = 0.f;
 	PhaseDuration = 0.f;
@@ -720,6 +1353,172 @@ void ACustomCharacter::EndParkour(bool bInterrupted, bool bForce)
 	SetInputLocked(false);
 }
 
+void ACustomCharacter::OnParkourFailsafe()
+{
+	FlightRecorder.Record(EParkourTraceEvent::Failsafe, (uint8)GetTraversalModeState().GetParkourPhase(), GetActorLocation(), ParkourTarget, FVector::ZeroVector, PhaseElapsed);
+	DumpFlightRecorder(EParkourTraceDumpReason::Failsafe);
+
+	EndParkour(false, true);
+}
+
+void ACustomCharacter::DumpFlightRecorder(EParkourTraceDumpReason Reason) const
+{
+	// Failure path: writing the file is allowed to allocate
+	PARKOUR_ALLOW_ALLOC_SCOPE();
+	LLM_SCOPE_BYTAG(TrialTask_Parkour);
+
+	const FString Path = FlightRecorder.DumpToFile(Reason, GetName());
+	if (!Path.IsEmpty())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("PARKOUR: %s -> flight recorder written to %s"), FParkourFlightRecorder::ReasonToString(Reason), *Path);
+	}
+}
+
+void ACustomCharacter::UpdateReplicationActivity()
+{
+	const bool bActive = GetTraversalModeState().GetMode() != ETraversalMode::Walk
+		|| GetVelocity().SizeSquared() > FMath::Square(10.f);
+
+	if (bActive == bReplicationActive)
+	{
+		return;
+	}
+	bReplicationActive = bActive;
+
+	if (UTrialReplicationGraph* Graph = UTrialReplicationGraph::Get(GetWorld()))
+	{
+		Graph->SetTraversalActive(this, bActive);
+	}
+}
+
+void ACustomCharacter::UpdateTraversalNetState()
+{
+	FTraversalNetState State;
+
+	const FPackedTraversalState Packed = GetTraversalModeState();
+
+	if (CustomMoveComp)
+	{
+		State.StaminaNormalized = CustomMoveComp->GetStaminaNormalized();
+	}
+	State.SetMode(Packed.GetMode());
+	State.Flags |= bIsCrouched ? TraversalNetFlags::Crouched : 0;
+
+	if (Packed.IsTraversing())
+	{
+		State.PhaseAlpha = (PhaseDuration > 0.f) ? PhaseElapsed / PhaseDuration : 0.f;
+		State.ObstacleOrigin = ParkourObstacleTop;
+		State.ParkourStart = ParkourStart;
+		State.ParkourApex = ParkourApex;
+		State.ParkourTarget = ParkourTarget;
+	}
+
+	// Compared on the quantized form, so this only dirties the property when the wire bits change
+	if (!(State == TraversalState))
+	{
+		TraversalState = State;
+	}
+}
+
+void ACustomCharacter::OnRep_TraversalState()
+{
+	if (GetLocalRole() != ROLE_SimulatedProxy) return;
+
+	FPackedTraversalState Rep;
+	Rep.SetReplicatedMode(TraversalState.GetMode());
+
+	if (Rep.IsTraversing())
+	{
+		ParkourObstacleTop = TraversalState.ObstacleOrigin;
+		ParkourStart = TraversalState.ParkourStart;
+		ParkourApex = TraversalState.ParkourApex;
+		ParkourTarget = TraversalState.ParkourTarget;
+
+		// Local progress runs ahead of the (older) replicated one; only pull it forward, or resync on a new phase
+		const EParkourPhase LocalPhase = GetTraversalModeState().GetParkourPhase();
+		const EParkourPhase RepPhase = Rep.GetParkourPhase();
+		const float RepDuration = GetParkourPhaseDuration(Rep.GetParkourType(), RepPhase);
+		const float RepElapsed = TraversalState.PhaseAlpha * RepDuration;
+
+		if (!bProxyTraversal || RepPhase != LocalPhase)
+		{
+			// Never step back from ToTarget to ToApex because of a late update
+			if (!(bProxyTraversal && LocalPhase == EParkourPhase::ToTarget && RepPhase == EParkourPhase::ToApex))
+			{
+				if (CustomMoveComp)
+				{
+					CustomMoveComp->SetReplicatedTraversalMode(Rep.GetMode());
+				}
+				PhaseDuration = RepDuration;
+				PhaseElapsed = RepElapsed;
+			}
+		}
+		else
+		{
+			PhaseElapsed = FMath::Max(PhaseElapsed, RepElapsed);
+		}
+		bProxyTraversal = IsParkouring();
+	}
+	else if (bProxyTraversal)
+	{
+		bProxyTraversal = false;
+		PhaseElapsed = 0.f;
+		PhaseDuration = 0.f;
+
+		// Resume from the latest replicated movement (updates received during the traversal were skipped)
+		Super::PostNetReceiveLocationAndRotation();
+	}
+
+	if (CustomMoveComp)
+	{
+		CustomMoveComp->SetStamina(TraversalState.StaminaNormalized * CustomMoveComp->StaminaMax);
+		if (!Rep.IsTraversing())
+		{
+			CustomMoveComp->SetReplicatedTraversalMode(Rep.GetMode());
+		}
+	}
+}
+
+void ACustomCharacter::PostNetReceiveLocationAndRotation()
+{
+	if (bProxyTraversal) return;
+
+	Super::PostNetReceiveLocationAndRotation();
+}
+
+void ACustomCharacter::TickSimulatedTraversal(float DeltaSeconds)
+{
+	if (!bProxyTraversal) return;
+
+	PARKOUR_SCOPE(STAT_SimulatedTraversal);
+
+	PhaseElapsed += DeltaSeconds;
+	float Alpha = FMath::Clamp(PhaseElapsed / FMath::Max(0.01f, PhaseDuration), 0.f, 1.f);
+
+	// Apex reached locally before the server said so: carry on toward the target
+	if (Alpha >= 1.f && CustomMoveComp && CustomMoveComp->ApplyTraversalEvent(ETraversalEvent::ApexReached))
+	{
+		PhaseElapsed = 0.f;
+		PhaseDuration = GetParkourPhaseDuration(GetTraversalModeState().GetParkourType(), EParkourPhase::ToTarget);
+		Alpha = 0.f;
+	}
+
+	// Holds at the target until the replicated state ends the traversal
+	const FVector Desired = (GetTraversalModeState().GetParkourPhase() == EParkourPhase::ToApex)
+		? FMath::Lerp(ParkourStart, ParkourApex, Alpha)
+		: FMath::Lerp(ParkourApex, ParkourTarget, Alpha);
+
+	SetActorLocation(Desired, false, nullptr, ETeleportType::None);
+}
+
+void ACustomCharacter::InitQueryParams()
+{
+	FrontQueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(ParkourFront), false, this);
+	LandQueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(ParkourLandTrace), false, this);
+	ApexQueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(ParkourApexFit), false, this);
+	FitQueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(ParkourTeleportFit), false, this);
+}
+
 bool ACustomCharacter::TryTeleportIfFits(const FVector& Location) const
 {
 	UWorld* World = GetWorld();
@@ -731,9 +1530,10 @@ bool ACustomCharacter::TryTeleportIfFits(const FVector& Location) const
 
 	FCollisionShape Shape = FCollisionShape::MakeCapsule(R + ParkourLandingCapsuleInflate, H);
 
-	FCollisionQueryParams Params(SCENE_QUERY_STAT(ParkourTeleportFit), false, this);
+	const FCollisionQueryParams& Params = FitQueryParams;
 
 	FHitResult Hit;
+	PARKOUR_COUNT(Sweeps);
 	const bool bBlocked = World->SweepSingleByChannel(
 		Hit, Location, Location, FQuat::Identity, ECC_WorldStatic, Shape, Params
 	);
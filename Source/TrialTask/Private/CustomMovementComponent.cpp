@@ -1,10 +1,28 @@
 #include "CustomMovementComponent.h"
 
+#include "ParkourAllocationScope.h"
+#include "ParkourStats.h"
+#include "TrialInputLatency.h"
+#include "TrialTaskLLM.h"
+
 #include "GameFramework/Character.h"
 #include "Components/CapsuleComponent.h"
+#include "DrawDebugHelpers.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("UpdateStamina"), STAT_UpdateStamina, STATGROUP_Parkour);
+DECLARE_CYCLE_STAT(TEXT("PhysSlide"), STAT_PhysSlide, STATGROUP_Parkour);
+DECLARE_CYCLE_STAT(TEXT("SimulatedProxyMoveTick"), STAT_SimulatedProxyMoveTick, STATGROUP_Parkour);
+
+static TAutoConsoleVariable<int32> CVarSlidePredictDebug(
+	TEXT("Trial.Slide.PredictDebug"),
+	0,
+	TEXT("Draws the predicted slide trajectory of locally controlled characters. Value = floor queries per frame (0 = off)."));
 
 UCustomMovementComponent::UCustomMovementComponent()
 {
+	LLM_SCOPE_BYTAG(TrialTask_Movement);
+
 	PrimaryComponentTick.bCanEverTick = true;
 }
 
@@ -12,19 +30,74 @@ void UCustomMovementComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
+	LLM_SCOPE_BYTAG(TrialTask_Movement);
+
 	DefaultGroundFriction = GroundFriction;
 	DefaultBrakingDecel = BrakingDecelerationWalking;
 
 	Stamina = StaminaMax;
 	UpdateMaxSpeed();
+
+	RebuildSlideSurfaces();
+}
+
+void UCustomMovementComponent::RebuildSlideSurfaces()
+{
+	LLM_SCOPE_BYTAG(TrialTask_Caches);
+
+	SlideSurfaceCache.Build(SlideSurfaces);
+	SlideFloorComponent = TObjectKey<UPrimitiveComponent>();
+	SlideSurfaceIndex = FTrialSlideSurfaceCache::DefaultIndex;
+
+	// Cached floors hold indices into the old table. Predictors owned elsewhere (predictive streaming)
+	// see the new generation on their next Update.
+	if (DebugSlidePrediction)
+	{
+		DebugSlidePrediction->Reset();
+	}
 }
 
 void UCustomMovementComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+	// Remote pawns: engine smoothing only. Stamina and sprint state come from the replicated traversal state.
+	// The engine simulates proxies in SimulateMovement, never PhysCustom: a remote slide moves along the replicated
+	// velocity with MoveSmooth and, being a custom mode, gets no floor check.
+	if (IsSimulatedProxy())
+	{
+		PARKOUR_SCOPE(STAT_SimulatedProxyMoveTick);
+		FParkourProxyCostScope ProxyCost(true);
+
+		Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+		return;
+	}
+
+	// Sprint requested this frame moves at sprint speed this frame (otherwise from the next one)
+	if (FTrialInputLatency::UseEarlySprint())
+	{
+		UpdateMaxSpeed();
+	}
+
+	const FVector LocationBeforeMove = UpdatedComponent ? UpdatedComponent->GetComponentLocation() : FVector::ZeroVector;
+
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	if (UpdatedComponent && !UpdatedComponent->GetComponentLocation().Equals(LocationBeforeMove, KINDA_SMALL_NUMBER))
+	{
+		FTrialInputLatency::NoteMotion(CharacterOwner, ETrialLatencyAction::Move);
+	}
+	if (IsSprinting() && GetHorizontalSpeed() > WalkSpeed)
+	{
+		FTrialInputLatency::NoteMotion(CharacterOwner, ETrialLatencyAction::Sprint);
+	}
+
+	// Outside the no-alloc scope: allocates the predictor on first use
+	DrawSlidePrediction(DeltaTime);
+
+	PARKOUR_NO_ALLOC_SCOPE(StaminaUpdate);
+	LLM_SCOPE_BYTAG(TrialTask_Movement);
+
 	// Keeps track of how recently sprint ended (used for slide grace window)
-	if (!bIsSprinting)
+	if (!IsSprinting())
 	{
 		TimeSinceSprintEnded += DeltaTime;
 	}
@@ -33,6 +106,11 @@ void UCustomMovementComponent::TickComponent(float DeltaTime, enum ELevelTick Ti
 	UpdateMaxSpeed();
 }
 
+bool UCustomMovementComponent::IsSimulatedProxy() const
+{
+	return CharacterOwner && CharacterOwner->GetLocalRole() == ROLE_SimulatedProxy;
+}
+
 float UCustomMovementComponent::GetHorizontalSpeed() const
 {
 	const FVector V = Velocity;
@@ -52,8 +130,10 @@ void UCustomMovementComponent::UpdateStamina(float DeltaTime)
 {
 	if (DeltaTime <= 0.f) return;
 
-	const bool bDrainSprint = bIsSprinting && IsMovingOnGround() && !bIsSliding;
-	const bool bDrainSlide = bIsSliding;
+	PARKOUR_SCOPE(STAT_UpdateStamina);
+
+	const bool bDrainSprint = IsSprinting() && IsMovingOnGround();
+	const bool bDrainSlide = IsSliding();
 
 	if (bDrainSprint)
 	{
@@ -69,10 +149,9 @@ void UCustomMovementComponent::UpdateStamina(float DeltaTime)
 	}
 
 	// Stops sprint if stamina hits zero
-	if (bIsSprinting && Stamina < KINDA_SMALL_NUMBER)
+	if (IsSprinting() && Stamina < KINDA_SMALL_NUMBER)
 	{
-		bIsSprinting = false;
-		TimeSinceSprintEnded = 0.f;
+		ApplyTraversalEvent(ETraversalEvent::SprintStop);
 	}
 }
 
@@ -80,24 +159,20 @@ void UCustomMovementComponent::UpdateMaxSpeed()
 {
 	const bool bShouldSprint =
 		bSprintRequested &&
-		!bIsSliding &&
 		IsMovingOnGround() &&
 		(Stamina >= MinStaminaToSprint);
 
+	// The table refuses SprintStart while sliding, traversing or locked
 	if (bShouldSprint)
 	{
-		bIsSprinting = true;
+		ApplyTraversalEvent(ETraversalEvent::SprintStart);
 	}
-	else
+	else if (IsSprinting())
 	{
-		if (bIsSprinting)
-		{
-			bIsSprinting = false;
-			TimeSinceSprintEnded = 0.f; // opens grace window for slide
-		}
+		ApplyTraversalEvent(ETraversalEvent::SprintStop);
 	}
 
-	MaxWalkSpeed = bIsSprinting ? SprintSpeed : WalkSpeed;
+	MaxWalkSpeed = IsSprinting() ? SprintSpeed : WalkSpeed;
 }
 
 // --------------------
@@ -107,7 +182,7 @@ void UCustomMovementComponent::UpdateMaxSpeed()
 bool UCustomMovementComponent::CanStartSlide() const
 {
 	if (!CharacterOwner) return false;
-	if (bIsSliding) return false;
+	if (!PackedState.Can(ETraversalEvent::SlideStart)) return false;
 	if (!IsMovingOnGround()) return false;
 
 	if (Stamina < MinStaminaToSlide) return false;
@@ -116,7 +191,7 @@ bool UCustomMovementComponent::CanStartSlide() const
 
 	// Either enough speed OR within sprint grace window
 	const bool bHasSpeed = Speed >= SlideMinStartSpeed;
-	const bool bInGrace = (TimeSinceSprintEnded <= PostSprintSlideGraceTime) && (Speed >= (SlideMinStartSpeed * 0.85f));
+	const bool bInGrace = (TimeSinceSprintEnded <= PostSprintSlideGraceTime) && (Speed >= (SlideMinStartSpeed * PostSprintSlideGraceSpeedScale));
 
 	return bHasSpeed || bInGrace;
 }
@@ -124,19 +199,46 @@ bool UCustomMovementComponent::CanStartSlide() const
 void UCustomMovementComponent::StartSlide()
 {
 	if (!CanStartSlide()) return;
-	EnterSlide();
+	ApplyTraversalEvent(ETraversalEvent::SlideStart);
 }
 
 void UCustomMovementComponent::StopSlide()
 {
-	if (!bIsSliding) return;
-	ExitSlide();
+	ApplyTraversalEvent(ETraversalEvent::SlideStop);
 }
 
-void UCustomMovementComponent::EnterSlide()
+bool UCustomMovementComponent::ApplyTraversalEvent(ETraversalEvent Event)
 {
-	bIsSliding = true;
+	const ETraversalMode From = PackedState.GetMode();
+	if (!PackedState.TryApply(Event))
+	{
+		return false;
+	}
+
+	const ETraversalMode To = PackedState.GetMode();
+	if (From == To)
+	{
+		return true;
+	}
+
+	if (From == ETraversalMode::Sprint)
+	{
+		TimeSinceSprintEnded = 0.f; // opens grace window for slide
+	}
+	else if (From == ETraversalMode::Slide)
+	{
+		ExitSlide();
+	}
+
+	if (To == ETraversalMode::Slide)
+	{
+		EnterSlide();
+	}
+	return true;
+}
 
+void UCustomMovementComponent::EnterSlide()
+{
 	// Saves current walking params, then makes slide feel slippery
 	DefaultGroundFriction = GroundFriction;
 	DefaultBrakingDecel = BrakingDecelerationWalking;
@@ -144,13 +246,15 @@ void UCustomMovementComponent::EnterSlide()
 	GroundFriction = SlideGroundFriction;
 	BrakingDecelerationWalking = 0.f;
 
+	// PhysSlide resolves the floor's surface on its first step
+	SlideFloorComponent = TObjectKey<UPrimitiveComponent>();
+	SlideSurfaceIndex = FTrialSlideSurfaceCache::DefaultIndex;
+
 	SetMovementMode(MOVE_Custom, (uint8)ECustomMovementMode::CMOVE_Slide);
 }
 
 void UCustomMovementComponent::ExitSlide()
 {
-	bIsSliding = false;
-
 	// Restores walking params
 	GroundFriction = DefaultGroundFriction;
 	BrakingDecelerationWalking = DefaultBrakingDecel;
@@ -158,6 +262,20 @@ void UCustomMovementComponent::ExitSlide()
 	SetMovementMode(MOVE_Walking);
 }
 
+void UCustomMovementComponent::ResetTraversalState()
+{
+	ApplyTraversalEvent(ETraversalEvent::Reset);
+	PackedState.SetCrouchRequested(false);
+	PackedState.SetInputLocked(false);
+
+	bSprintRequested = false;
+	TimeSinceSprintEnded = 999.0f;
+	Stamina = StaminaMax;
+
+	StopMovementImmediately();
+	UpdateMaxSpeed();
+}
+
 // --------------------
 // PHYS
 // --------------------
@@ -178,25 +296,8 @@ void UCustomMovementComponent::PhysCustom(float DeltaTime, int32 Iterations)
 	Super::PhysCustom(DeltaTime, Iterations);
 }
 
-void UCustomMovementComponent::PhysSlide(float DeltaTime, int32 Iterations)
+bool UCustomMovementComponent::StepSlideVelocity(FVector& InOutVelocity, const FVector& FloorNormal, const FTrialSlideSurface& Surface, const FVector& SteerInput, float DeltaTime) const
 {
-	if (!CharacterOwner || DeltaTime < KINDA_SMALL_NUMBER)
-	{
-		return;
-	}
-
-	// Updates floor info
-	FindFloor(UpdatedComponent->GetComponentLocation(), CurrentFloor, false);
-
-	if (!CurrentFloor.IsWalkableFloor())
-	{
-		// If ground is lost, ends slide and falls
-		ExitSlide();
-		SetMovementMode(MOVE_Falling);
-		return;
-	}
-
-	const FVector FloorNormal = CurrentFloor.HitResult.ImpactNormal.GetSafeNormal();
 	const FVector Up = FVector::UpVector;
 
 	// Computes slope angle (0 = flat, 90 = vertical wall)
@@ -212,27 +313,25 @@ void UCustomMovementComponent::PhysSlide(float DeltaTime, int32 Iterations)
 	Downhill = Downhill.GetSafeNormal();
 
 	// Keeps velocity on the floor plane to avoid tiny Z plane jitter
-	Velocity = FVector::VectorPlaneProject(Velocity, FloorNormal);
+	FVector Vel = FVector::VectorPlaneProject(InOutVelocity, FloorNormal);
+	InOutVelocity = Vel;
 
-	const float Speed = Velocity.Size();
+	const float Speed = Vel.Size();
 	if (Speed < SlideMinSpeedToKeep)
 	{
-		ExitSlide();
-		return;
+		return false;
 	}
 
-	const FVector VelDir = Velocity.GetSafeNormal();
-	const float AlongDownhill = FVector::DotProduct(VelDir, Downhill); 
+	const FVector VelDir = Vel.GetSafeNormal();
+	const float AlongDownhill = FVector::DotProduct(VelDir, Downhill);
 
 	// Steering input: uses the movement input vector, projected on the floor
-	FVector Input = ConsumeInputVector();
-	Input = FVector::VectorPlaneProject(Input, FloorNormal);
-	const FVector InputDir = Input.GetSafeNormal();
+	const FVector InputDir = FVector::VectorPlaneProject(SteerInput, FloorNormal).GetSafeNormal();
 
 	FVector Accel = FVector::ZeroVector;
 
 	// Steering always works (arcade feel)
-	if (!InputDir.IsNearlyZero()
+	if (!InputDir.IsNearlyZero())
 	{
 		Accel += InputDir * SlideSteerAccel;
 	}
@@ -243,35 +342,119 @@ void UCustomMovementComponent::PhysSlide(float DeltaTime, int32 Iterations)
 		const float SlopeStrength = FMath::Clamp(FMath::Sin(SlopeRad), 0.f, 1.f);
 
 		// Always pulls toward downhill on a slope (fixes "always flat" issue)
-		Accel += Downhill * (SlideDownhillAccel * SlopeStrength);
+		Accel += Downhill * (SlideDownhillAccel * Surface.DownhillAccel * SlopeStrength);
 
 		// If moving against downhill, adds extra braking (uphill feels heavy)
 		if (AlongDownhill < -0.05f)
 		{
-			Accel += (-VelDir) * SlideUphillDecel;
+			Accel += (-VelDir) * (SlideUphillDecel * Surface.Friction);
 		}
 	}
 	else
 	{
 		// Flat surface (loses momentum over time)
-		Accel += (-VelDir) * SlideFlatDecel;
+		Accel += (-VelDir) * (SlideFlatDecel * Surface.FlatDecel * Surface.Friction);
 	}
 
 	// Integrates velocity
-	Velocity += Accel * DeltaTime;
-	Velocity = FVector::VectorPlaneProject(Velocity, FloorNormal);
+	Vel += Accel * DeltaTime;
+	Vel = FVector::VectorPlaneProject(Vel, FloorNormal);
 
 	// Caps speed depending on slope/flat
 	const float MaxSpeed = bIsOnSlope ? SlideMaxSpeedDownhill : SlideMaxSpeedFlat;
-	const float NewSpeed = Velocity.Size();
+	const float NewSpeed = Vel.Size();
 	if (NewSpeed > MaxSpeed)
 	{
-		Velocity = Velocity.GetSafeNormal() * MaxSpeed;
+		Vel = Vel.GetSafeNormal() * MaxSpeed;
 	}
 
-	if (Velocity.Size() < SlideMinSpeedToKeep)
+	InOutVelocity = Vel;
+	return Vel.Size() >= SlideMinSpeedToKeep;
+}
+
+bool UCustomMovementComponent::UpdateSlidePrediction(FSlideTrajectoryPredictor& Predictor, float DeltaSeconds, int32 FloorQueryBudget) const
+{
+	if (!IsSliding() || !UpdatedComponent)
 	{
-		ExitSlide();
+		Predictor.Reset();
+		return false;
+	}
+
+	// PhysSlide consumes the pending input, so after movement has ticked the steer is only left in the
+	// acceleration built from it (same direction, which is all StepSlideVelocity uses)
+	return Predictor.Update(*this, UpdatedComponent->GetComponentLocation(), Velocity, GetCurrentAcceleration(), DeltaSeconds, FloorQueryBudget);
+}
+
+void UCustomMovementComponent::DrawSlidePrediction(float DeltaTime)
+{
+#if ENABLE_DRAW_DEBUG
+	const int32 Budget = CVarSlidePredictDebug.GetValueOnGameThread();
+	if (Budget <= 0 || !CharacterOwner || !CharacterOwner->IsLocallyControlled())
+	{
+		DebugSlidePrediction.Reset();
+		return;
+	}
+
+	if (!DebugSlidePrediction)
+	{
+		// Mostly the floor cache
+		LLM_SCOPE_BYTAG(TrialTask_Caches);
+		DebugSlidePrediction = MakeUnique<FSlideTrajectoryPredictor>();
+	}
+
+	const FSlideTrajectoryPredictor& Prediction = *DebugSlidePrediction;
+	UpdateSlidePrediction(*DebugSlidePrediction, DeltaTime, Budget);
+
+	for (int32 i = 1; i < Prediction.Num(); ++i)
+	{
+		DrawDebugLine(GetWorld(), Prediction[i - 1].Location, Prediction[i].Location, FColor::Cyan, false, -1.f, 0, 2.f);
+	}
+	if (const FSlideTrajectorySample* Last = Prediction.GetLast())
+	{
+		const FColor EndColor = Prediction.GetEndReason() == ESlideTrajectoryEnd::Blocked ? FColor::Red
+			: (Prediction.GetEndReason() == ESlideTrajectoryEnd::LostFloor ? FColor::Orange : FColor::Green);
+		DrawDebugSphere(GetWorld(), Last->Location, 20.f, 8, EndColor);
+	}
+#endif
+}
+
+void UCustomMovementComponent::PhysSlide(float DeltaTime, int32 Iterations)
+{
+	if (!CharacterOwner || DeltaTime < KINDA_SMALL_NUMBER)
+	{
+		return;
+	}
+
+	PARKOUR_SCOPE(STAT_PhysSlide);
+	PARKOUR_NO_ALLOC_SCOPE(PhysSlide);
+	LLM_SCOPE_BYTAG(TrialTask_Movement);
+
+	// Updates floor info
+	PARKOUR_COUNT(FindFloors);
+	FindFloor(UpdatedComponent->GetComponentLocation(), CurrentFloor, false);
+
+	if (!CurrentFloor.IsWalkableFloor())
+	{
+		// If ground is lost, ends slide and falls
+		ApplyTraversalEvent(ETraversalEvent::SlideStop);
+		SetMovementMode(MOVE_Falling);
+		return;
+	}
+
+	const FVector FloorNormal = CurrentFloor.HitResult.ImpactNormal.GetSafeNormal();
+
+	// Surface lookup only when the floor changes; otherwise one indexed read
+	const TObjectKey<UPrimitiveComponent> FloorComponent(CurrentFloor.HitResult.GetComponent());
+	if (FloorComponent != SlideFloorComponent)
+	{
+		SlideFloorComponent = FloorComponent;
+		SlideSurfaceIndex = SlideSurfaceCache.Resolve(CurrentFloor.HitResult.GetComponent());
+	}
+	const FTrialSlideSurface& Surface = SlideSurfaceCache.Get(SlideSurfaceIndex);
+
+	if (!StepSlideVelocity(Velocity, FloorNormal, Surface, ConsumeInputVector(), DeltaTime))
+	{
+		ApplyTraversalEvent(ETraversalEvent::SlideStop);
 		return;
 	}
 
@@ -279,11 +462,14 @@ void UCustomMovementComponent::PhysSlide(float DeltaTime, int32 Iterations)
 	const FVector Delta = Velocity * DeltaTime;
 
 	FHitResult Hit;
+	PARKOUR_COUNT(Sweeps);
 	SafeMoveUpdatedComponent(Delta, UpdatedComponent->GetComponentQuat(), true, Hit);
+	FTrialInputLatency::NoteMotion(CharacterOwner, ETrialLatencyAction::Slide);
 
 	if (Hit.IsValidBlockingHit())
 	{
 		// Slides along blocking surface
+		PARKOUR_COUNT(Fallbacks);
 		SlideAlongSurface(Delta, 1.f - Hit.Time, Hit.Normal, Hit, true);
 
 		// Keeps velocity on the new surface plane
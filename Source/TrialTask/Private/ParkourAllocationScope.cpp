@@ -0,0 +1,211 @@
+#include "ParkourAllocationScope.h"
+
+#if PARKOUR_ALLOC_TRACKING
+
+#include "ParkourStats.h"
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/MemoryBase.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/ScopeLock.h"
+
+static TAutoConsoleVariable<int32> CVarParkourAllocCheck(
+	TEXT("Parkour.AllocCheck"),
+	0,
+	TEXT("Count heap allocations inside movement hot paths (needs -ParkourAllocCheck on the command line).\n")
+	TEXT("0: off, 1: log violations, 2: log + ensure on violations"));
+
+static TAutoConsoleVariable<int32> CVarParkourAllocWarmupCalls(
+	TEXT("Parkour.AllocCheck.WarmupCalls"),
+	8,
+	TEXT("Calls per hot path ignored before allocations count as violations (lazy engine-side setup)."));
+
+namespace ParkourAlloc
+{
+	static thread_local uint64 ThreadCount = 0;
+	static thread_local int32 PauseDepth = 0;
+
+	static bool bProxyInstalled = false;
+
+	static FParkourAllocSite* SiteHead = nullptr;
+	static FCriticalSection SiteLock;
+
+	// Forwards everything to the original allocator, counting new blocks per thread
+	class FMallocCountingProxy final : public FMalloc
+	{
+	public:
+		explicit FMallocCountingProxy(FMalloc* InInner) : Inner(InInner) {}
+
+		static FORCEINLINE void Bump()
+		{
+			if (PauseDepth == 0)
+			{
+				++ThreadCount;
+			}
+		}
+
+		virtual void* Malloc(SIZE_T Size, uint32 Alignment) override { Bump(); return Inner->Malloc(Size, Alignment); }
+		virtual void* TryMalloc(SIZE_T Size, uint32 Alignment) override { Bump(); return Inner->TryMalloc(Size, Alignment); }
+		virtual void* MallocZeroed(SIZE_T Size, uint32 Alignment) override { Bump(); return Inner->MallocZeroed(Size, Alignment); }
+		virtual void* TryMallocZeroed(SIZE_T Size, uint32 Alignment) override { Bump(); return Inner->TryMallocZeroed(Size, Alignment); }
+		virtual void* Realloc(void* Ptr, SIZE_T NewSize, uint32 Alignment) override { if (NewSize > 0) Bump(); return Inner->Realloc(Ptr, NewSize, Alignment); }
+		virtual void* TryRealloc(void* Ptr, SIZE_T NewSize, uint32 Alignment) override { if (NewSize > 0) Bump(); return Inner->TryRealloc(Ptr, NewSize, Alignment); }
+		virtual void Free(void* Ptr) override { Inner->Free(Ptr); }
+
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+		virtual void MarkTLSCachesAsUsedOnCurrentThread() override { Inner->MarkTLSCachesAsUsedOnCurrentThread(); }
+		virtual void MarkTLSCachesAsUnusedOnCurrentThread() override { Inner->MarkTLSCachesAsUnusedOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual void InitializeStatsMetadata() override { Inner->InitializeStatsMetadata(); }
+		virtual void UpdateStats() override { Inner->UpdateStats(); }
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+		virtual const TCHAR* GetDescriptiveName() override { return TEXT("ParkourCountingProxy"); }
+
+	private:
+		FMalloc* Inner;
+	};
+}
+
+void ParkourAlloc::InstallCountingMallocIfRequested()
+{
+	check(IsInGameThread());
+
+	if (bProxyInstalled || !FParse::Param(FCommandLine::Get(), TEXT("ParkourAllocCheck")))
+	{
+		return;
+	}
+
+	// Swapped once at module startup, before gameplay runs, and never removed: blocks allocated through either
+	// pointer stay valid because the proxy forwards everything to the same allocator
+	GMalloc = new FMallocCountingProxy(GMalloc);
+	bProxyInstalled = true;
+
+	UE_LOG(LogTemp, Display, TEXT("PARKOUR ALLOC: counting allocator installed (Parkour.AllocCheck 1 to start counting)"));
+}
+
+bool ParkourAlloc::IsCountingMallocInstalled()
+{
+	return bProxyInstalled;
+}
+
+FParkourAllocSite::FParkourAllocSite(const TCHAR* InName)
+	: Name(InName)
+{
+	FScopeLock Lock(&ParkourAlloc::SiteLock);
+	Next = ParkourAlloc::SiteHead;
+	ParkourAlloc::SiteHead = this;
+}
+
+void FParkourAllocSite::ForEachSite(TFunctionRef<void(const FParkourAllocSite&)> Func)
+{
+	FScopeLock Lock(&ParkourAlloc::SiteLock);
+	for (const FParkourAllocSite* Site = ParkourAlloc::SiteHead; Site; Site = Site->Next)
+	{
+		Func(*Site);
+	}
+}
+
+uint64 FParkourAllocSite::TotalViolations()
+{
+	uint64 Total = 0;
+	ForEachSite([&Total](const FParkourAllocSite& Site) { Total += Site.Violations; });
+	return Total;
+}
+
+void FParkourAllocSite::ResetAll()
+{
+	FScopeLock Lock(&ParkourAlloc::SiteLock);
+	for (FParkourAllocSite* Site = ParkourAlloc::SiteHead; Site; Site = Site->Next)
+	{
+		Site->Calls = 0;
+		Site->Allocations = 0;
+		Site->Violations = 0;
+	}
+}
+
+FParkourAllocationScope::FParkourAllocationScope(FParkourAllocSite& InSite)
+	: Site(InSite)
+{
+	if (!ParkourAlloc::bProxyInstalled || CVarParkourAllocCheck.GetValueOnAnyThread() <= 0 || !IsInGameThread())
+	{
+		return;
+	}
+
+	bActive = true;
+	StartCount = ParkourAlloc::ThreadCount;
+}
+
+FParkourAllocationScope::~FParkourAllocationScope()
+{
+	if (!bActive)
+	{
+		return;
+	}
+
+	const uint64 Allocs = GetAllocations();
+	++Site.Calls;
+
+	if (Allocs == 0)
+	{
+		return;
+	}
+
+	// Reporting is allowed to allocate
+	FParkourAllocationPause Pause;
+
+	Site.Allocations += Allocs;
+	CSV_CUSTOM_STAT(Parkour, HotPathAllocs, (int32)Allocs, ECsvCustomStatOp::Accumulate);
+
+	if (Site.Calls <= (uint64)CVarParkourAllocWarmupCalls.GetValueOnGameThread())
+	{
+		return;
+	}
+
+	if (Site.Violations++ == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("PARKOUR ALLOC: %s allocated %llu block(s) in steady state (call %llu)"), Site.Name, Allocs, Site.Calls);
+	}
+
+	ensureMsgf(CVarParkourAllocCheck.GetValueOnGameThread() < 2, TEXT("PARKOUR ALLOC: %s allocated in steady state"), Site.Name);
+}
+
+uint64 FParkourAllocationScope::GetAllocations() const
+{
+	return bActive ? (ParkourAlloc::ThreadCount - StartCount) : 0;
+}
+
+FParkourAllocationPause::FParkourAllocationPause()
+{
+	++ParkourAlloc::PauseDepth;
+}
+
+FParkourAllocationPause::~FParkourAllocationPause()
+{
+	--ParkourAlloc::PauseDepth;
+}
+
+static FAutoConsoleCommand CmdParkourAllocReport(
+	TEXT("Parkour.AllocReport"),
+	TEXT("Prints heap allocations counted per movement hot path (needs -ParkourAllocCheck and Parkour.AllocCheck 1)."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FParkourAllocSite::ForEachSite([](const FParkourAllocSite& Site)
+		{
+			UE_LOG(LogTemp, Display, TEXT("PARKOUR ALLOC: %-24s calls=%-8llu allocs=%-8llu violations=%llu"),
+				Site.Name, Site.Calls, Site.Allocations, Site.Violations);
+		});
+	}));
+
+static FAutoConsoleCommand CmdParkourAllocReset(
+	TEXT("Parkour.AllocReset"),
+	TEXT("Resets the per hot path allocation counters."),
+	FConsoleCommandDelegate::CreateStatic(&FParkourAllocSite::ResetAll));
+
+#endif // PARKOUR_ALLOC_TRACKING
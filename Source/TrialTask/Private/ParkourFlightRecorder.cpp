@@ -0,0 +1,135 @@
+#include "ParkourFlightRecorder.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+#include "Serialization/Archive.h"
+
+static TAutoConsoleVariable<bool> CVarParkourFlightRecorderDump(
+	TEXT("Parkour.FlightRecorder.Dump"),
+	true,
+	TEXT("Write the parkour flight recorder to Saved/ParkourTraces when a traversal fails or the failsafe fires."));
+
+void FParkourFlightRecorder::Record(EParkourTraceEvent Event, uint8 Detail, const FVector& Location, const FVector& Point, const FVector& Normal, float Value)
+{
+	const uint32 Index = WriteIndex.fetch_add(1, std::memory_order_relaxed);
+
+	FParkourTraceRecord& Rec = Records[Index & (Capacity - 1)];
+	Rec.Cycles = FPlatformTime::Cycles64();
+	Rec.Frame = static_cast<uint32>(GFrameCounter);
+	Rec.Event = Event;
+	Rec.Detail = Detail;
+	Rec.Location = FVector3f(Location);
+	Rec.Point = FVector3f(Point);
+	Rec.Normal = FVector3f(Normal);
+	Rec.Value = Value;
+}
+
+uint32 FParkourFlightRecorder::Snapshot(TArray<FParkourTraceRecord>& OutRecords) const
+{
+	const uint32 End = WriteIndex.load(std::memory_order_acquire);
+	const uint32 Count = FMath::Min(End, Capacity);
+	const uint32 First = End - Count;
+
+	OutRecords.Reset(Count);
+	for (uint32 i = First; i != End; ++i)
+	{
+		OutRecords.Add(Records[i & (Capacity - 1)]);
+	}
+	return Count;
+}
+
+FString FParkourFlightRecorder::DumpToFile(EParkourTraceDumpReason Reason, const FString& OwnerName) const
+{
+	if (!CVarParkourFlightRecorderDump.GetValueOnGameThread())
+	{
+		return FString();
+	}
+
+	TArray<FParkourTraceRecord> Snap;
+	Snapshot(Snap);
+
+	const FString Dir = FPaths::ProjectSavedDir() / TEXT("ParkourTraces");
+	const FString Path = Dir / FString::Printf(TEXT("%s_%s.pkr"), *OwnerName, *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S-%s")));
+
+	TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileWriter(*Path, FILEWRITE_EvenIfReadOnly));
+	if (!Ar)
+	{
+		return FString();
+	}
+
+	FParkourTraceFileHeader Header;
+	Header.Count = Snap.Num();
+	Header.SecondsPerCycle = FPlatformTime::GetSecondsPerCycle64();
+	Header.Reason = static_cast<uint8>(Reason);
+
+	Ar->Serialize(&Header, sizeof(Header));
+	Ar->Serialize(Snap.GetData(), Snap.Num() * sizeof(FParkourTraceRecord));
+	Ar->Close();
+
+	return Path;
+}
+
+bool FParkourFlightRecorder::LoadFromFile(const FString& Path, FParkourTraceFileHeader& OutHeader, TArray<FParkourTraceRecord>& OutRecords)
+{
+	TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileReader(*Path));
+	if (!Ar || Ar->TotalSize() < (int64)sizeof(FParkourTraceFileHeader))
+	{
+		return false;
+	}
+
+	Ar->Serialize(&OutHeader, sizeof(OutHeader));
+	if (OutHeader.Magic != FParkourTraceFileHeader::ExpectedMagic
+		|| OutHeader.Version != FParkourTraceFileHeader::CurrentVersion
+		|| OutHeader.RecordSize != sizeof(FParkourTraceRecord))
+	{
+		return false;
+	}
+
+	const int64 Expected = (int64)sizeof(FParkourTraceFileHeader) + (int64)OutHeader.Count * sizeof(FParkourTraceRecord);
+	if (Ar->TotalSize() < Expected)
+	{
+		return false;
+	}
+
+	OutRecords.SetNumUninitialized(OutHeader.Count);
+	Ar->Serialize(OutRecords.GetData(), OutHeader.Count * sizeof(FParkourTraceRecord));
+	return !Ar->IsError();
+}
+
+const TCHAR* FParkourFlightRecorder::EventToString(EParkourTraceEvent Event)
+{
+	switch (Event)
+	{
+	case EParkourTraceEvent::Pressed:			return TEXT("Pressed");
+	case EParkourTraceEvent::NoObstacle:		return TEXT("NoObstacle");
+	case EParkourTraceEvent::OutOfRange:		return TEXT("OutOfRange");
+	case EParkourTraceEvent::LandingCandidate:	return TEXT("LandingCandidate");
+	case EParkourTraceEvent::LandingBlocked:	return TEXT("LandingBlocked");
+	case EParkourTraceEvent::ApexBlocked:		return TEXT("ApexBlocked");
+	case EParkourTraceEvent::Started:			return TEXT("Started");
+	case EParkourTraceEvent::PhaseAdvanced:		return TEXT("PhaseAdvanced");
+	case EParkourTraceEvent::MoveStepFallback:	return TEXT("MoveStepFallback");
+	case EParkourTraceEvent::MoveStepBlocked:	return TEXT("MoveStepBlocked");
+	case EParkourTraceEvent::Recovery:			return TEXT("Recovery");
+	case EParkourTraceEvent::Ended:				return TEXT("Ended");
+	case EParkourTraceEvent::Failsafe:			return TEXT("Failsafe");
+	case EParkourTraceEvent::ServerRejected:	return TEXT("ServerRejected");
+	default:									return TEXT("Unknown");
+	}
+}
+
+const TCHAR* FParkourFlightRecorder::ReasonToString(EParkourTraceDumpReason Reason)
+{
+	switch (Reason)
+	{
+	case EParkourTraceDumpReason::LandingBlocked:	return TEXT("LandingBlocked");
+	case EParkourTraceDumpReason::ApexBlocked:		return TEXT("ApexBlocked");
+	case EParkourTraceDumpReason::MoveStepBlocked:	return TEXT("MoveStepBlocked");
+	case EParkourTraceDumpReason::Failsafe:			return TEXT("Failsafe");
+	case EParkourTraceDumpReason::Manual:			return TEXT("Manual");
+	case EParkourTraceDumpReason::ServerRejected:	return TEXT("ServerRejected");
+	default:										return TEXT("Unknown");
+	}
+}
@@ -0,0 +1,62 @@
+#include "ParkourPoseHistory.h"
+
+void FParkourPoseHistory::Record(double Time, const FVector& Location, const FRotator& Rotation)
+{
+	// Several ticks can share a timestamp while paused; keep only the latest pose for it
+	if (Count > 0 && At(0).Time >= Time)
+	{
+		FParkourPoseSample& Latest = Samples[(WriteIndex - 1) & (Capacity - 1)];
+		Latest.Location = Location;
+		Latest.Rotation = Rotation;
+		return;
+	}
+
+	FParkourPoseSample& Sample = Samples[WriteIndex & (Capacity - 1)];
+	Sample.Time = Time;
+	Sample.Location = Location;
+	Sample.Rotation = Rotation;
+
+	++WriteIndex;
+	Count = FMath::Min(Count + 1, Capacity);
+}
+
+bool FParkourPoseHistory::Sample(double Time, FParkourPoseSample& OutSample) const
+{
+	if (Count == 0)
+	{
+		return false;
+	}
+
+	if (Time >= At(0).Time)
+	{
+		OutSample = At(0);
+		return true;
+	}
+
+	// Newest to oldest: find the pair that brackets Time
+	for (uint32 Age = 1; Age < Count; ++Age)
+	{
+		const FParkourPoseSample& Older = At(Age);
+		if (Older.Time > Time)
+		{
+			continue;
+		}
+
+		const FParkourPoseSample& Newer = At(Age - 1);
+		const double Span = Newer.Time - Older.Time;
+		const float Alpha = (Span > 0.0) ? (float)((Time - Older.Time) / Span) : 1.f;
+
+		OutSample.Time = Time;
+		OutSample.Location = FMath::Lerp(Older.Location, Newer.Location, Alpha);
+		OutSample.Rotation = FMath::Lerp(Older.Rotation, Newer.Rotation, Alpha);
+		return true;
+	}
+
+	OutSample = At(Count - 1);
+	return true;
+}
+
+double FParkourPoseHistory::GetOldestTime() const
+{
+	return Count ? At(Count - 1).Time : 0.0;
+}
@@ -0,0 +1,35 @@
+#include "ParkourStats.h"
+
+#include "HAL/IConsoleManager.h"
+
+CSV_DEFINE_CATEGORY_MODULE(TRIALTASK_API, Parkour, true);
+
+uint64 FParkourQueryCounters::Sweeps = 0;
+uint64 FParkourQueryCounters::LineTraces = 0;
+uint64 FParkourQueryCounters::FindFloors = 0;
+uint64 FParkourQueryCounters::Fallbacks = 0;
+
+double FParkourProxyCost::Seconds = 0.0;
+uint64 FParkourProxyCost::PawnTicks = 0;
+
+void FParkourProxyCost::Report()
+{
+	const double UsPerPawn = PawnTicks ? (Seconds * 1000000.0) / PawnTicks : 0.0;
+	UE_LOG(LogTemp, Display, TEXT("PROXYCOST,PawnTicks=%llu,TotalMs=%.3f,UsPerRemotePawnPerFrame=%.2f"), PawnTicks, Seconds * 1000.0, UsPerPawn);
+}
+
+void FParkourProxyCost::Reset()
+{
+	Seconds = 0.0;
+	PawnTicks = 0;
+}
+
+static FAutoConsoleCommand CmdParkourProxyCost(
+	TEXT("Parkour.ProxyCost"),
+	TEXT("Prints the client CPU cost per simulated proxy (character + movement tick) since the last reset."),
+	FConsoleCommandDelegate::CreateStatic(&FParkourProxyCost::Report));
+
+static FAutoConsoleCommand CmdParkourProxyCostReset(
+	TEXT("Parkour.ProxyCost.Reset"),
+	TEXT("Clears the simulated proxy cost counters."),
+	FConsoleCommandDelegate::CreateStatic(&FParkourProxyCost::Reset));
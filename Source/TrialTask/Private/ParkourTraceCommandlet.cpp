@@ -0,0 +1,100 @@
+#include "ParkourTraceCommandlet.h"
+
+#include "ParkourFlightRecorder.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+UParkourTraceCommandlet::UParkourTraceCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UParkourTraceCommandlet::Main(const FString& Params)
+{
+	FString File;
+	FString Csv;
+	FParse::Value(*Params, TEXT("File="), File);
+	FParse::Value(*Params, TEXT("Csv="), Csv);
+
+	TArray<FString> Files;
+	if (!File.IsEmpty())
+	{
+		Files.Add(File);
+	}
+	else
+	{
+		const FString Dir = FPaths::ProjectSavedDir() / TEXT("ParkourTraces");
+		IFileManager::Get().FindFiles(Files, *(Dir / TEXT("*.pkr")), true, false);
+		for (FString& Name : Files)
+		{
+			Name = Dir / Name;
+		}
+	}
+
+	if (Files.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("PARKOUR TRACE: no trace files found"));
+		return 1;
+	}
+
+	int32 Failures = 0;
+	for (const FString& Path : Files)
+	{
+		// One csv per input when decoding a whole directory
+		const FString CsvPath = Csv.IsEmpty() ? FString() : (Files.Num() == 1 ? Csv : FPaths::ChangeExtension(Path, TEXT("csv")));
+		if (!DecodeFile(Path, CsvPath))
+		{
+			++Failures;
+		}
+	}
+
+	return Failures > 0 ? 1 : 0;
+}
+
+bool UParkourTraceCommandlet::DecodeFile(const FString& Path, const FString& CsvPath) const
+{
+	FParkourTraceFileHeader Header;
+	TArray<FParkourTraceRecord> Records;
+	if (!FParkourFlightRecorder::LoadFromFile(Path, Header, Records))
+	{
+		UE_LOG(LogTemp, Error, TEXT("PARKOUR TRACE: cannot decode %s (bad magic, version or size)"), *Path);
+		return false;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("PARKOUR TRACE: %s  reason=%s  records=%u"),
+		*Path, FParkourFlightRecorder::ReasonToString(static_cast<EParkourTraceDumpReason>(Header.Reason)), Header.Count);
+
+	const uint64 BaseCycles = Records.Num() > 0 ? Records[0].Cycles : 0;
+
+	TArray<FString> CsvLines;
+	CsvLines.Add(TEXT("TimeMs,Frame,Event,Detail,LocX,LocY,LocZ,PointX,PointY,PointZ,NormalX,NormalY,NormalZ,Value"));
+
+	for (const FParkourTraceRecord& Rec : Records)
+	{
+		const double TimeMs = (double)(Rec.Cycles - BaseCycles) * Header.SecondsPerCycle * 1000.0;
+		const TCHAR* EventName = FParkourFlightRecorder::EventToString(Rec.Event);
+
+		UE_LOG(LogTemp, Display, TEXT("%9.3fms  f%-8u %-18s d=%u  loc=(%s)  pt=(%s)  n=(%s)  v=%.3f"),
+			TimeMs, Rec.Frame, EventName, Rec.Detail,
+			*Rec.Location.ToCompactString(), *Rec.Point.ToCompactString(), *Rec.Normal.ToCompactString(), Rec.Value);
+
+		CsvLines.Add(FString::Printf(TEXT("%.3f,%u,%s,%u,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.3f,%.3f,%.3f,%.4f"),
+			TimeMs, Rec.Frame, EventName, Rec.Detail,
+			Rec.Location.X, Rec.Location.Y, Rec.Location.Z,
+			Rec.Point.X, Rec.Point.Y, Rec.Point.Z,
+			Rec.Normal.X, Rec.Normal.Y, Rec.Normal.Z,
+			Rec.Value));
+	}
+
+	if (!CsvPath.IsEmpty())
+	{
+		FFileHelper::SaveStringArrayToFile(CsvLines, *CsvPath);
+	}
+
+	return true;
+}
@@ -0,0 +1,238 @@
+#include "SlideTrajectoryPredictor.h"
+
+#include "CustomMovementComponent.h"
+#include "ParkourStats.h"
+
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+
+DECLARE_CYCLE_STAT(TEXT("SlidePredict"), STAT_SlidePredict, STATGROUP_Parkour);
+
+void FSlideTrajectoryPredictor::Reset()
+{
+	Restart();
+	InvalidateFloorCache();
+}
+
+void FSlideTrajectoryPredictor::InvalidateFloorCache()
+{
+	for (FFloorCacheEntry& Entry : FloorCache)
+	{
+		Entry = FFloorCacheEntry();
+	}
+}
+
+void FSlideTrajectoryPredictor::Restart()
+{
+	Head = 0;
+	Count = 0;
+	Elapsed = 0.f;
+	EndReason = ESlideTrajectoryEnd::None;
+	LastSteer = FVector::ZeroVector;
+}
+
+bool FSlideTrajectoryPredictor::Update(const UCustomMovementComponent& Move, const FVector& Location, const FVector& Velocity, const FVector& SteerInput, float DeltaSeconds, int32 FloorQueryBudget)
+{
+	PARKOUR_SCOPE(STAT_SlidePredict);
+
+	const ACharacter* Character = Move.GetCharacterOwner();
+	const UCapsuleComponent* Capsule = Character ? Character->GetCapsuleComponent() : nullptr;
+	if (!Capsule || !Move.GetWorld())
+	{
+		Reset();
+		return false;
+	}
+	HalfHeight = Capsule->GetScaledCapsuleHalfHeight();
+
+	// Surfaces rebuilt since the floors were cached: their indices point into the old table
+	const uint32 Generation = Move.GetSlideSurfaceCache().GetGeneration();
+	if (Generation != SurfaceGeneration)
+	{
+		Reset();
+		SurfaceGeneration = Generation;
+	}
+
+	if (FloorQueryOwner.Get() != Move.GetOwner())
+	{
+		FloorQueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(SlidePredictFloor), false, Move.GetOwner());
+		FloorResponseParams = FCollisionResponseParams();
+		Move.InitCollisionParams(FloorQueryParams, FloorResponseParams);
+		FloorQueryOwner = Move.GetOwner();
+	}
+
+	int32 Budget = FloorQueryBudget;
+	LastReused = 0;
+
+	// Keep what is still ahead of the character, unless the steering or the live state moved off it
+	const bool bReuse = Count > 0 && IsSameSteer(SteerInput) && Consume(Location, Velocity, DeltaSeconds);
+	if (bReuse)
+	{
+		LastReused = Count;
+		if (EndReason == ESlideTrajectoryEnd::Horizon)
+		{
+			EndReason = ESlideTrajectoryEnd::None;
+		}
+	}
+	else
+	{
+		Restart();
+		LastSteer = SteerInput;
+
+		FFloorCacheEntry Floor;
+		if (!FindFloor(Move, Location, Budget, Floor))
+		{
+			LastFloorQueries = FloorQueryBudget - Budget;
+			return false;
+		}
+
+		Push({ 0.f, Location, Velocity, Floor.bWalkable ? Floor.Normal : FVector::UpVector, Floor.SurfaceIndex });
+		if (Floor.bBlocked || !Floor.bWalkable)
+		{
+			EndReason = ESlideTrajectoryEnd::LostFloor;
+		}
+	}
+
+	Extend(Move, Budget);
+
+	LastFloorQueries = FloorQueryBudget - Budget;
+	return IsComplete();
+}
+
+bool FSlideTrajectoryPredictor::IsSameSteer(const FVector& SteerInput) const
+{
+	// Steering is an acceleration (thousands of uu/s2): compare directions, not components
+	const FVector Dir = SteerInput.GetSafeNormal();
+	const FVector LastDir = LastSteer.GetSafeNormal();
+	if (Dir.IsZero() || LastDir.IsZero())
+	{
+		return Dir.IsZero() == LastDir.IsZero();
+	}
+	return FVector::DotProduct(Dir, LastDir) >= FMath::Cos(FMath::DegreesToRadians(SteerAngleToleranceDeg));
+}
+
+bool FSlideTrajectoryPredictor::Consume(const FVector& Location, const FVector& Velocity, float DeltaSeconds)
+{
+	Elapsed += DeltaSeconds;
+
+	// Sample pair around the current time
+	int32 Index = 0;
+	while (Index + 1 < Count && (*this)[Index + 1].Time <= Elapsed)
+	{
+		++Index;
+	}
+	if (Index + 1 >= Count)
+	{
+		// Ran past the predicted end
+		return false;
+	}
+
+	const FSlideTrajectorySample& A = (*this)[Index];
+	const FSlideTrajectorySample& B = (*this)[Index + 1];
+	const float Alpha = FMath::Clamp((Elapsed - A.Time) / FMath::Max(B.Time - A.Time, KINDA_SMALL_NUMBER), 0.f, 1.f);
+
+	const FVector PredictedLocation = FMath::Lerp(A.Location, B.Location, Alpha);
+	const float PredictedSpeed = FMath::Lerp(A.Velocity.Size(), B.Velocity.Size(), Alpha);
+
+	if (FVector::DistSquared(PredictedLocation, Location) > FMath::Square(LocationTolerance)
+		|| FMath::Abs(PredictedSpeed - Velocity.Size()) > SpeedTolerance)
+	{
+		return false;
+	}
+
+	// Drop the samples already behind the character
+	Head = (Head + Index) & (Capacity - 1);
+	Count -= Index;
+	return true;
+}
+
+void FSlideTrajectoryPredictor::Extend(const UCustomMovementComponent& Move, int32& InOutBudget)
+{
+	while (EndReason == ESlideTrajectoryEnd::None)
+	{
+		const FSlideTrajectorySample Last = (*this)[Count - 1];
+		if (Count >= Capacity || Last.Time >= Elapsed + HorizonSeconds)
+		{
+			EndReason = ESlideTrajectoryEnd::Horizon;
+			break;
+		}
+
+		// Same rules as PhysSlide
+		FVector Velocity = Last.Velocity;
+		if (!Move.StepSlideVelocity(Velocity, Last.FloorNormal, Move.GetSlideSurfaceCache().Get(Last.SurfaceIndex), LastSteer, StepSeconds))
+		{
+			EndReason = ESlideTrajectoryEnd::Stopped;
+			break;
+		}
+
+		FVector Next = Last.Location + Velocity * StepSeconds;
+
+		FFloorCacheEntry Floor;
+		if (!FindFloor(Move, Next, InOutBudget, Floor))
+		{
+			// Out of budget; the next call carries on from here
+			break;
+		}
+		if (Floor.bBlocked || Floor.ImpactZ > Last.Location.Z - HalfHeight + Move.MaxStepHeight)
+		{
+			EndReason = ESlideTrajectoryEnd::Blocked;
+			break;
+		}
+		if (!Floor.bWalkable)
+		{
+			EndReason = ESlideTrajectoryEnd::LostFloor;
+			break;
+		}
+
+		Next.Z = Floor.ImpactZ + HalfHeight;
+		Push({ Last.Time + StepSeconds, Next, Velocity, Floor.Normal, Floor.SurfaceIndex });
+	}
+}
+
+bool FSlideTrajectoryPredictor::FindFloor(const UCustomMovementComponent& Move, const FVector& Location, int32& InOutBudget, FFloorCacheEntry& OutFloor)
+{
+	const float FeetZ = Location.Z - HalfHeight;
+	const FIntVector Cell(
+		FMath::FloorToInt(Location.X / FloorCellSize),
+		FMath::FloorToInt(Location.Y / FloorCellSize),
+		FMath::FloorToInt(FeetZ / 100.f));
+
+	const uint32 Hash = (uint32(Cell.X) * 73856093u) ^ (uint32(Cell.Y) * 19349663u) ^ (uint32(Cell.Z) * 83492791u);
+	FFloorCacheEntry& Entry = FloorCache[Hash & (FloorCacheSize - 1)];
+	if (Entry.Cell == Cell)
+	{
+		OutFloor = Entry;
+		return true;
+	}
+
+	if (InOutBudget <= 0)
+	{
+		return false;
+	}
+	--InOutBudget;
+
+	// Down from one step above the feet: a start inside geometry means a wall or a ledge taller than a step
+	const ECollisionChannel Channel = Move.UpdatedComponent ? Move.UpdatedComponent->GetCollisionObjectType() : ECC_Pawn;
+	const FVector Start(Location.X, Location.Y, FeetZ + Move.MaxStepHeight);
+	const FVector End(Location.X, Location.Y, FeetZ - Move.MaxStepHeight - HalfHeight);
+
+	FHitResult Hit;
+	PARKOUR_COUNT(LineTraces);
+	const bool bHit = Move.GetWorld()->LineTraceSingleByChannel(Hit, Start, End, Channel, FloorQueryParams, FloorResponseParams);
+
+	Entry.Cell = Cell;
+	Entry.bBlocked = bHit && Hit.bStartPenetrating;
+	Entry.bWalkable = bHit && !Entry.bBlocked && Move.IsWalkable(Hit);
+	Entry.ImpactZ = bHit ? Hit.ImpactPoint.Z : FeetZ;
+	Entry.Normal = bHit ? Hit.ImpactNormal : FVector::UpVector;
+	Entry.SurfaceIndex = bHit ? Move.GetSlideSurfaceCache().Resolve(Hit.GetComponent()) : FTrialSlideSurfaceCache::DefaultIndex;
+
+	OutFloor = Entry;
+	return true;
+}
+
+void FSlideTrajectoryPredictor::Push(const FSlideTrajectorySample& Sample)
+{
+	Samples[(Head + Count) & (Capacity - 1)] = Sample;
+	++Count;
+}
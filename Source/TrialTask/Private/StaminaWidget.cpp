@@ -3,6 +3,7 @@
 #include "StaminaWidget.h"
 
 #include "CustomMovementComponent.h"
+#include "TrialTaskLLM.h"
 #include "Components/ProgressBar.h"
 
 void UStaminaWidget::SetMovementComponent(UCustomMovementComponent* InMoveComp)
@@ -14,6 +15,8 @@ void UStaminaWidget::NativeOnInitialized()
 {
     Super::NativeOnInitialized();
 
+    LLM_SCOPE_BYTAG(TrialTask_HUD);
+
     // Keeps the bar in a valid state even before a movement component is assigned
     if (PB_Stamina)
     {
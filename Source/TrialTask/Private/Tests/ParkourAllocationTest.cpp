@@ -0,0 +1,201 @@
+#include "CustomCharacter.h"
+#include "CustomMovementComponent.h"
+#include "ParkourAllocationScope.h"
+#include "TrialParkourObstacle.h"
+
+#include "Components/BoxComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && PARKOUR_ALLOC_TRACKING
+
+namespace ParkourAllocTest
+{
+	constexpr float FrameSeconds = 1.f / 60.f;
+	constexpr int32 MaxLapFrames = 60 * 15;
+	constexpr int32 MeasuredLaps = 3;
+	constexpr float SlideSeconds = 0.5f;
+
+	// Floor top at Z = 0. Obstacle heights are above the capsule centre, as FindParkourObstacle measures them.
+	constexpr float CapsuleCentreZ = 90.f;
+	constexpr float VaultFaceX = 2200.f;
+	constexpr float VaultHeight = 60.f;
+	constexpr float MantleFaceX = 3200.f;
+	constexpr float MantleHeight = 110.f;
+
+	// Parkour is pressed once the obstacle face is this close to the capsule centre
+	constexpr float PressDistance = 90.f;
+
+	static const FVector StartLocation(0.f, 0.f, CapsuleCentreZ + 10.f);
+
+	static AActor* SpawnBox(UWorld& World, const FVector& Center, const FVector& Extent, bool bParkourable)
+	{
+		AActor* Actor = World.SpawnActor<AActor>();
+		UBoxComponent* Box = NewObject<UBoxComponent>(Actor);
+		Box->SetBoxExtent(Extent, false);
+		Box->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+		Actor->SetRootComponent(Box);
+		Box->RegisterComponent();
+		Box->SetWorldLocation(Center);
+
+		if (bParkourable)
+		{
+			Actor->Tags.Add(TrialParkourObstacle::Tag);
+		}
+		return Actor;
+	}
+
+	struct FLapResult
+	{
+		bool bSprinted = false;
+		bool bSlid = false;
+		bool bVaulted = false;
+		bool bMantled = false;
+	};
+
+	enum class ELapStage : uint8
+	{
+		Sprint,
+		Slide,
+		Traverse
+	};
+
+	// Sprint, slide, sprint again, vault the low box, mantle the high one. Driven through the injected input path.
+	static FLapResult RunLap(UWorld& World, ACustomCharacter& Character, UCustomMovementComponent& Move)
+	{
+		Character.ResetForPool();
+		Character.TeleportTo(StartLocation, FRotator::ZeroRotator);
+		Character.GetController()->SetControlRotation(FRotator::ZeroRotator);
+		Character.InjectAction(ETrialInputAction::Sprint, true);
+
+		FLapResult Result;
+		ELapStage Stage = ELapStage::Sprint;
+		float SlideTime = 0.f;
+
+		for (int32 Frame = 0; Frame < MaxLapFrames; ++Frame)
+		{
+			Character.InjectMoveInput(FVector2D(0.f, 1.f));
+
+			switch (Stage)
+			{
+			case ELapStage::Sprint:
+				Result.bSprinted |= Character.IsSprintActive();
+				if (Result.bSprinted && Move.CanStartSlide() && Move.GetHorizontalSpeed() >= Move.SlideMinStartSpeed)
+				{
+					Character.InjectAction(ETrialInputAction::Crouch, true);
+					Stage = ELapStage::Slide;
+				}
+				break;
+
+			case ELapStage::Slide:
+				Result.bSlid |= Character.IsSlideActive();
+				SlideTime += FrameSeconds;
+				if (SlideTime >= SlideSeconds || !Character.IsSlideActive())
+				{
+					Character.InjectAction(ETrialInputAction::Crouch, false);
+					Character.InjectAction(ETrialInputAction::Sprint, false);
+					Character.InjectAction(ETrialInputAction::Sprint, true);
+					Stage = ELapStage::Traverse;
+				}
+				break;
+
+			case ELapStage::Traverse:
+				Result.bVaulted |= Character.IsVaulting();
+				Result.bMantled |= Character.IsMantling();
+				if (!Character.IsParkouring())
+				{
+					if (Result.bMantled)
+					{
+						Character.InjectAction(ETrialInputAction::Sprint, false);
+						return Result;
+					}
+
+					const float FaceX = Result.bVaulted ? MantleFaceX : VaultFaceX;
+					if (FaceX - Character.GetActorLocation().X <= PressDistance)
+					{
+						Character.InjectAction(ETrialInputAction::Parkour, true);
+					}
+				}
+				break;
+			}
+
+			World.Tick(LEVELTICK_All, FrameSeconds);
+		}
+
+		Character.InjectAction(ETrialInputAction::Sprint, false);
+		return Result;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FParkourSteadyStateAllocationTest, "TrialTask.Parkour.SteadyStateAllocations",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FParkourSteadyStateAllocationTest::RunTest(const FString& Parameters)
+{
+	using namespace ParkourAllocTest;
+
+	if (!ParkourAlloc::IsCountingMallocInstalled())
+	{
+		AddWarning(TEXT("Skipped: needs the counting allocator (run with -ParkourAllocCheck)"));
+		return true;
+	}
+
+	IConsoleVariable* AllocCheck = IConsoleManager::Get().FindConsoleVariable(TEXT("Parkour.AllocCheck"));
+	const int32 SavedAllocCheck = AllocCheck->GetInt();
+	AllocCheck->Set(1);
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("ParkourAllocTest"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	const FURL URL;
+	World->SetGameMode(URL);
+	World->InitializeActorsForPlay(URL);
+	World->BeginPlay();
+
+	SpawnBox(*World, FVector(2000.f, 0.f, -50.f), FVector(4000.f, 1000.f, 50.f), false);
+	SpawnBox(*World, FVector(VaultFaceX + 20.f, 0.f, (CapsuleCentreZ + VaultHeight) * 0.5f), FVector(20.f, 300.f, (CapsuleCentreZ + VaultHeight) * 0.5f), true);
+	SpawnBox(*World, FVector(MantleFaceX + 300.f, 0.f, (CapsuleCentreZ + MantleHeight) * 0.5f), FVector(300.f, 300.f, (CapsuleCentreZ + MantleHeight) * 0.5f), true);
+
+	ACustomCharacter* Character = World->SpawnActor<ACustomCharacter>(StartLocation, FRotator::ZeroRotator);
+	APlayerController* Controller = World->SpawnActor<APlayerController>();
+	UCustomMovementComponent* Move = Character ? Cast<UCustomMovementComponent>(Character->GetCharacterMovement()) : nullptr;
+
+	if (TestNotNull(TEXT("Character"), Move) && TestNotNull(TEXT("Controller"), Controller))
+	{
+		Controller->Possess(Character);
+
+		// First lap warms up lazy engine-side state (scene query caches, timer storage, stat names)
+		RunLap(*World, *Character, *Move);
+		FParkourAllocSite::ResetAll();
+
+		for (int32 Lap = 0; Lap < MeasuredLaps; ++Lap)
+		{
+			const FLapResult Result = RunLap(*World, *Character, *Move);
+			TestTrue(FString::Printf(TEXT("Lap %d sprinted"), Lap), Result.bSprinted);
+			TestTrue(FString::Printf(TEXT("Lap %d slid"), Lap), Result.bSlid);
+			TestTrue(FString::Printf(TEXT("Lap %d vaulted"), Lap), Result.bVaulted);
+			TestTrue(FString::Printf(TEXT("Lap %d mantled"), Lap), Result.bMantled);
+		}
+
+		FParkourAllocSite::ForEachSite([this](const FParkourAllocSite& Site)
+		{
+			if (Site.Allocations > 0)
+			{
+				AddError(FString::Printf(TEXT("%s allocated %llu block(s) over %llu steady-state calls"), Site.Name, Site.Allocations, Site.Calls));
+			}
+		});
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	AllocCheck->Set(SavedAllocCheck);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS && PARKOUR_ALLOC_TRACKING
@@ -0,0 +1,54 @@
+#include "TrialDeterministicSim.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace TrialRollbackTest
+{
+	constexpr int32 NumFrames = 3600;
+	constexpr int32 Seeds[] = { 1234, 7, 90210, 424242 };
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTrialRollbackDesyncTest, "TrialTask.Rollback.TwoInstanceDesync",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FTrialRollbackDesyncTest::RunTest(const FString& Parameters)
+{
+	using namespace TrialRollbackTest;
+
+	// Class default tuning, so the result does not depend on what is loaded
+	const FTrialDetParams Params = FTrialDetParams::FromMovement(nullptr);
+	const float BudgetMs = IConsoleManager::Get().FindConsoleVariable(TEXT("Trial.Rollback.BudgetMs"))->GetFloat();
+
+	// Up to the edge of the resim window (a larger request is clamped to it)
+	const int32 Delays[] = { 0, 4, (int32)FTrialRollbackSim::MaxResimFrames - 1, 100 };
+
+	for (const int32 Seed : Seeds)
+	{
+		for (const int32 Delay : Delays)
+		{
+			const FTrialDesyncCheckResult Result = TrialDeterministicSim::RunDesyncCheck(Params, NumFrames, Delay, Seed);
+			const FString Context = FString::Printf(TEXT("Seed %d, MaxDelay %d"), Seed, Result.MaxDelay);
+
+			TestTrue(FString::Printf(TEXT("%s: delay inside the resim window"), *Context), Result.MaxDelay < (int32)FTrialRollbackSim::MaxResimFrames);
+			TestEqual(FString::Printf(TEXT("%s: desync frame"), *Context), Result.DesyncFrame, (int32)INDEX_NONE);
+			if (Delay > 0)
+			{
+				TestTrue(FString::Printf(TEXT("%s: late inputs caused resims"), *Context), Result.Resims > 0);
+			}
+
+			// Timing depends on the machine running the test, so over budget is reported but does not fail it
+			if (Result.WorstResimMs > BudgetMs)
+			{
+				AddWarning(FString::Printf(TEXT("%s: worst %u-frame resim took %.2f us (budget %.0f us)"),
+					*Context, FTrialRollbackSim::MaxResimFrames, 1000.0 * Result.WorstResimMs, 1000.0 * BudgetMs));
+			}
+		}
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,196 @@
+#include "TraversalNetState.h"
+
+#include "ParkourStats.h"
+
+#include "Engine/Engine.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Serialization/Archive.h"
+
+static TAutoConsoleVariable<float> CVarTrialNetStateReportInterval(
+	TEXT("Trial.NetState.ReportInterval"),
+	0.f,
+	TEXT("If > 0, logs traversal net state bytes per pawn per second every N seconds."));
+
+// Size of the same data sent unquantized: 3 FVectors, stamina and alpha floats, 5 bools, phase byte
+static constexpr uint32 UnquantizedBits = 3 * 3 * 32 + 32 + 32 + 5 + 8;
+
+// Keeps the origin inside the 31-bit zigzag range of the wire format (+/- 10,000 km)
+static constexpr int32 MaxOriginCm = 1 << 29;
+
+namespace
+{
+	// FArchive bit access with the WriteBits/ReadBits shape the wire helpers expect
+	struct FArchiveBitWriter
+	{
+		FArchive& Ar;
+		void WriteBits(uint32 Value, uint32 NumBits) { Ar.SerializeBits(&Value, NumBits); }
+	};
+
+	struct FArchiveBitReader
+	{
+		FArchive& Ar;
+		uint32 ReadBits(uint32 NumBits)
+		{
+			uint32 Value = 0;
+			Ar.SerializeBits(&Value, NumBits);
+			return Value;
+		}
+	};
+
+	int32 QuantizeCm(double Value, int32 Limit)
+	{
+		return (int32)FMath::Clamp<double>(FMath::RoundToDouble(Value), -Limit, Limit);
+	}
+
+	uint8 QuantizeUnit(float Value)
+	{
+		return (uint8)FMath::RoundToInt(FMath::Clamp(Value, 0.f, 1.f) * 255.f);
+	}
+}
+
+FTraversalNetStatePacked FTraversalNetState::Pack() const
+{
+	FTraversalNetStatePacked Packed;
+	Packed.Flags = Flags;
+	Packed.Stamina = QuantizeUnit(StaminaNormalized);
+
+	if (!Packed.IsTraversing())
+	{
+		return Packed;
+	}
+
+	Packed.PhaseAlpha = QuantizeUnit(PhaseAlpha);
+
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		Packed.Origin[Axis] = QuantizeCm(ObstacleOrigin[Axis], MaxOriginCm);
+	}
+
+	const FVector* Points[3] = { &ParkourStart, &ParkourApex, &ParkourTarget };
+	for (int32 Point = 0; Point < 3; ++Point)
+	{
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			Packed.Offsets[Point][Axis] = (int16)QuantizeCm((*Points[Point])[Axis] - Packed.Origin[Axis], MAX_int16);
+		}
+	}
+	return Packed;
+}
+
+void FTraversalNetState::Unpack(const FTraversalNetStatePacked& Packed)
+{
+	Flags = Packed.Flags;
+	StaminaNormalized = Packed.Stamina / 255.f;
+	PhaseAlpha = Packed.PhaseAlpha / 255.f;
+
+	ObstacleOrigin = FVector(Packed.Origin[0], Packed.Origin[1], Packed.Origin[2]);
+
+	FVector* Points[3] = { &ParkourStart, &ParkourApex, &ParkourTarget };
+	for (int32 Point = 0; Point < 3; ++Point)
+	{
+		*Points[Point] = ObstacleOrigin + FVector(Packed.Offsets[Point][0], Packed.Offsets[Point][1], Packed.Offsets[Point][2]);
+	}
+}
+
+bool FTraversalNetState::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	// Classic replication has no acked baseline for plain structs, so this is always the full packed state
+	if (Ar.IsSaving())
+	{
+		FArchiveBitWriter Writer{ Ar };
+		FTraversalNetStats::NoteWrite(TraversalNetStateWire::Write(Writer, Pack()), false);
+	}
+	else
+	{
+		FArchiveBitReader Reader{ Ar };
+		FTraversalNetStatePacked Packed;
+		TraversalNetStateWire::Read(Reader, Packed);
+		Unpack(Packed);
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
+// --------------------
+// Bandwidth stats
+// --------------------
+
+uint64 FTraversalNetStats::Bits = 0;
+uint64 FTraversalNetStats::Writes = 0;
+uint64 FTraversalNetStats::DeltaWrites = 0;
+int32 FTraversalNetStats::NumPawns = 0;
+double FTraversalNetStats::WindowStart = 0.0;
+
+void FTraversalNetStats::NoteWrite(uint32 NumBits, bool bDelta)
+{
+	const double Now = FPlatformTime::Seconds();
+	if (WindowStart == 0.0)
+	{
+		WindowStart = Now;
+	}
+
+	Bits += NumBits;
+	++Writes;
+	DeltaWrites += bDelta ? 1 : 0;
+
+	CSV_CUSTOM_STAT(Parkour, TraversalNetBits, (int32)NumBits, ECsvCustomStatOp::Accumulate);
+
+	const float Interval = CVarTrialNetStateReportInterval.GetValueOnAnyThread();
+	if (Interval > 0.f && Now - WindowStart >= Interval)
+	{
+		Report();
+		Reset();
+	}
+}
+
+// Client connections of the server worlds being measured (the state is written once per connection)
+static int32 CountServerClientConnections()
+{
+	int32 Connections = 0;
+	if (GEngine)
+	{
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			const UWorld* World = Context.World();
+			const UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
+			if (NetDriver && NetDriver->IsServer())
+			{
+				Connections += NetDriver->ClientConnections.Num();
+			}
+		}
+	}
+	return Connections;
+}
+
+void FTraversalNetStats::Report()
+{
+	const double Seconds = (WindowStart > 0.0) ? FPlatformTime::Seconds() - WindowStart : 0.0;
+	const int32 Connections = CountServerClientConnections();
+	const int32 Streams = FMath::Max(1, NumPawns) * FMath::Max(1, Connections);
+	const double BytesPerPawnSec = (Seconds > 0.0) ? (Bits / 8.0) / Streams / Seconds : 0.0;
+	const double AvgBits = Writes ? (double)Bits / Writes : 0.0;
+
+	UE_LOG(LogTemp, Display, TEXT("NETSTATE,Pawns=%d,Connections=%d,Seconds=%.1f,Writes=%llu,AvgBits=%.1f,UnquantizedBits=%u,DeltaPct=%.0f,BytesPerPawnSec=%.1f"),
+		NumPawns, Connections, Seconds, Writes, AvgBits, UnquantizedBits, Writes ? 100.0 * DeltaWrites / Writes : 0.0, BytesPerPawnSec);
+}
+
+void FTraversalNetStats::Reset()
+{
+	Bits = 0;
+	Writes = 0;
+	DeltaWrites = 0;
+	WindowStart = 0.0;
+}
+
+static FAutoConsoleCommand CmdTrialNetStateReport(
+	TEXT("Trial.NetState.Report"),
+	TEXT("Prints traversal net state bandwidth (bytes per pawn per second) since the last reset."),
+	FConsoleCommandDelegate::CreateStatic(&FTraversalNetStats::Report));
+
+static FAutoConsoleCommand CmdTrialNetStateReset(
+	TEXT("Trial.NetState.Reset"),
+	TEXT("Clears the traversal net state bandwidth counters."),
+	FConsoleCommandDelegate::CreateStatic(&FTraversalNetStats::Reset));
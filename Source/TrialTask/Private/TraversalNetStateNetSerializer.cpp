@@ -0,0 +1,266 @@
+#include "TraversalNetStateNetSerializer.h"
+
+#if UE_WITH_IRIS
+
+#include "TraversalNetState.h"
+
+#include "Iris/ReplicationState/PropertyNetSerializerInfoRegistry.h"
+#include "Iris/Serialization/NetBitStreamReader.h"
+#include "Iris/Serialization/NetBitStreamWriter.h"
+#include "Iris/Serialization/NetSerializerDelegates.h"
+
+namespace UE::Net
+{
+
+struct FTraversalNetStateNetSerializer
+{
+	static constexpr uint32 Version = 0;
+
+	// SerializeDelta below only sends the parts that differ from the acked baseline
+	static constexpr bool bUseDefaultDelta = false;
+
+	typedef FTraversalNetState SourceType;
+	typedef FTraversalNetStatePacked QuantizedType;
+	typedef FTraversalNetStateNetSerializerConfig ConfigType;
+
+	static const ConfigType DefaultConfig;
+
+	static void Serialize(FNetSerializationContext& Context, const FNetSerializeArgs& Args);
+	static void Deserialize(FNetSerializationContext& Context, const FNetDeserializeArgs& Args);
+
+	static void SerializeDelta(FNetSerializationContext& Context, const FNetSerializeDeltaArgs& Args);
+	static void DeserializeDelta(FNetSerializationContext& Context, const FNetDeserializeDeltaArgs& Args);
+
+	static void Quantize(FNetSerializationContext& Context, const FNetQuantizeArgs& Args);
+	static void Dequantize(FNetSerializationContext& Context, const FNetDequantizeArgs& Args);
+
+	static bool IsEqual(FNetSerializationContext& Context, const FNetIsEqualArgs& Args);
+	static bool Validate(FNetSerializationContext& Context, const FNetValidateArgs& Args);
+
+private:
+	class FNetSerializerRegistryDelegates final : private UE::Net::FNetSerializerRegistryDelegates
+	{
+	public:
+		virtual ~FNetSerializerRegistryDelegates();
+
+	private:
+		virtual void OnPreFreezeNetSerializerRegistry() override;
+	};
+
+	static FTraversalNetStateNetSerializer::FNetSerializerRegistryDelegates NetSerializerRegistryDelegates;
+};
+
+UE_NET_IMPLEMENT_SERIALIZER(FTraversalNetStateNetSerializer);
+
+const FTraversalNetStateNetSerializer::ConfigType FTraversalNetStateNetSerializer::DefaultConfig;
+FTraversalNetStateNetSerializer::FNetSerializerRegistryDelegates FTraversalNetStateNetSerializer::NetSerializerRegistryDelegates;
+
+static const FName PropertyNetSerializerRegistry_NAME_TraversalNetState("TraversalNetState");
+UE_NET_IMPLEMENT_NAMED_STRUCT_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_TraversalNetState, FTraversalNetStateNetSerializer);
+
+namespace TraversalNetStateNetSerializerPrivate
+{
+	// Iris bit streams with the WriteBits/ReadBits shape the wire helpers expect
+	struct FWriter
+	{
+		FNetBitStreamWriter& Stream;
+		void WriteBits(uint32 Value, uint32 NumBits) { Stream.WriteBits(Value, NumBits); }
+	};
+
+	struct FReader
+	{
+		FNetBitStreamReader& Stream;
+		uint32 ReadBits(uint32 NumBits) { return Stream.ReadBits(NumBits); }
+	};
+
+	bool SameOrigin(const FTraversalNetStatePacked& A, const FTraversalNetStatePacked& B)
+	{
+		return FMemory::Memcmp(A.Origin, B.Origin, sizeof(A.Origin)) == 0;
+	}
+
+	bool SameOffsets(const FTraversalNetStatePacked& A, const FTraversalNetStatePacked& B, int32 Point)
+	{
+		return FMemory::Memcmp(A.Offsets[Point], B.Offsets[Point], sizeof(A.Offsets[Point])) == 0;
+	}
+}
+
+void FTraversalNetStateNetSerializer::Serialize(FNetSerializationContext& Context, const FNetSerializeArgs& Args)
+{
+	using namespace TraversalNetStateNetSerializerPrivate;
+
+	const QuantizedType& Value = *reinterpret_cast<const QuantizedType*>(Args.Source);
+	FWriter Writer{ *Context.GetBitStreamWriter() };
+
+	FTraversalNetStats::NoteWrite(TraversalNetStateWire::Write(Writer, Value), false);
+}
+
+void FTraversalNetStateNetSerializer::Deserialize(FNetSerializationContext& Context, const FNetDeserializeArgs& Args)
+{
+	using namespace TraversalNetStateNetSerializerPrivate;
+
+	QuantizedType& Target = *reinterpret_cast<QuantizedType*>(Args.Target);
+	FReader Reader{ *Context.GetBitStreamReader() };
+
+	TraversalNetStateWire::Read(Reader, Target);
+}
+
+void FTraversalNetStateNetSerializer::SerializeDelta(FNetSerializationContext& Context, const FNetSerializeDeltaArgs& Args)
+{
+	using namespace TraversalNetStateNetSerializerPrivate;
+
+	const QuantizedType& Value = *reinterpret_cast<const QuantizedType*>(Args.Source);
+	const QuantizedType& Prev = *reinterpret_cast<const QuantizedType*>(Args.Prev);
+	FNetBitStreamWriter& Stream = *Context.GetBitStreamWriter();
+	FWriter Writer{ Stream };
+
+	uint32 Bits = 2;
+
+	// Flags first: the reader needs them to know whether traversal data follows
+	if (Stream.WriteBool(Value.Flags != Prev.Flags))
+	{
+		Stream.WriteBits(Value.Flags, TraversalNetFlags::NumBits);
+		Bits += TraversalNetFlags::NumBits;
+	}
+
+	if (Stream.WriteBool(Value.Stamina != Prev.Stamina))
+	{
+		Stream.WriteBits(Value.Stamina, 8);
+		Bits += 8;
+	}
+
+	if (Value.IsTraversing())
+	{
+		// A new traversal (or one the baseline never saw) is sent whole
+		if (!Prev.IsTraversing())
+		{
+			Bits += TraversalNetStateWire::WriteTraversal(Writer, Value);
+		}
+		else
+		{
+			Bits += 5;
+
+			if (Stream.WriteBool(Value.PhaseAlpha != Prev.PhaseAlpha))
+			{
+				Stream.WriteBits(Value.PhaseAlpha, 8);
+				Bits += 8;
+			}
+
+			if (Stream.WriteBool(!SameOrigin(Value, Prev)))
+			{
+				for (int32 Axis = 0; Axis < 3; ++Axis)
+				{
+					Bits += TraversalNetStateWire::WriteInt(Writer, Value.Origin[Axis]);
+				}
+			}
+
+			for (int32 Point = 0; Point < 3; ++Point)
+			{
+				if (Stream.WriteBool(!SameOffsets(Value, Prev, Point)))
+				{
+					for (int32 Axis = 0; Axis < 3; ++Axis)
+					{
+						Bits += TraversalNetStateWire::WriteInt(Writer, Value.Offsets[Point][Axis]);
+					}
+				}
+			}
+		}
+	}
+
+	FTraversalNetStats::NoteWrite(Bits, true);
+}
+
+void FTraversalNetStateNetSerializer::DeserializeDelta(FNetSerializationContext& Context, const FNetDeserializeDeltaArgs& Args)
+{
+	using namespace TraversalNetStateNetSerializerPrivate;
+
+	QuantizedType& Target = *reinterpret_cast<QuantizedType*>(Args.Target);
+	const QuantizedType& Prev = *reinterpret_cast<const QuantizedType*>(Args.Prev);
+	FNetBitStreamReader& Stream = *Context.GetBitStreamReader();
+	FReader Reader{ Stream };
+
+	QuantizedType Value;
+	Value.Flags = Stream.ReadBool() ? (uint8)Stream.ReadBits(TraversalNetFlags::NumBits) : Prev.Flags;
+	Value.Stamina = Stream.ReadBool() ? (uint8)Stream.ReadBits(8) : Prev.Stamina;
+
+	if (Value.IsTraversing())
+	{
+		if (!Prev.IsTraversing())
+		{
+			TraversalNetStateWire::ReadTraversal(Reader, Value);
+		}
+		else
+		{
+			Value.PhaseAlpha = Stream.ReadBool() ? (uint8)Stream.ReadBits(8) : Prev.PhaseAlpha;
+
+			const bool bOriginChanged = Stream.ReadBool();
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				Value.Origin[Axis] = bOriginChanged ? TraversalNetStateWire::ReadInt(Reader) : Prev.Origin[Axis];
+			}
+
+			for (int32 Point = 0; Point < 3; ++Point)
+			{
+				const bool bPointChanged = Stream.ReadBool();
+				for (int32 Axis = 0; Axis < 3; ++Axis)
+				{
+					Value.Offsets[Point][Axis] = bPointChanged ? (int16)TraversalNetStateWire::ReadInt(Reader) : Prev.Offsets[Point][Axis];
+				}
+			}
+		}
+	}
+
+	Target = Value;
+}
+
+void FTraversalNetStateNetSerializer::Quantize(FNetSerializationContext& Context, const FNetQuantizeArgs& Args)
+{
+	const SourceType& Source = *reinterpret_cast<const SourceType*>(Args.Source);
+	QuantizedType& Target = *reinterpret_cast<QuantizedType*>(Args.Target);
+
+	Target = Source.Pack();
+}
+
+void FTraversalNetStateNetSerializer::Dequantize(FNetSerializationContext& Context, const FNetDequantizeArgs& Args)
+{
+	const QuantizedType& Source = *reinterpret_cast<const QuantizedType*>(Args.Source);
+	SourceType& Target = *reinterpret_cast<SourceType*>(Args.Target);
+
+	Target.Unpack(Source);
+}
+
+bool FTraversalNetStateNetSerializer::IsEqual(FNetSerializationContext& Context, const FNetIsEqualArgs& Args)
+{
+	if (Args.bStateIsQuantized)
+	{
+		return *reinterpret_cast<const QuantizedType*>(Args.Source0) == *reinterpret_cast<const QuantizedType*>(Args.Source1);
+	}
+
+	return *reinterpret_cast<const SourceType*>(Args.Source0) == *reinterpret_cast<const SourceType*>(Args.Source1);
+}
+
+bool FTraversalNetStateNetSerializer::Validate(FNetSerializationContext& Context, const FNetValidateArgs& Args)
+{
+	const SourceType& Source = *reinterpret_cast<const SourceType*>(Args.Source);
+
+	return (uint8)Source.GetMode() < (uint8)ETraversalMode::Num
+		&& FMath::IsFinite(Source.StaminaNormalized)
+		&& FMath::IsFinite(Source.PhaseAlpha)
+		&& !Source.ObstacleOrigin.ContainsNaN()
+		&& !Source.ParkourStart.ContainsNaN()
+		&& !Source.ParkourApex.ContainsNaN()
+		&& !Source.ParkourTarget.ContainsNaN();
+}
+
+FTraversalNetStateNetSerializer::FNetSerializerRegistryDelegates::~FNetSerializerRegistryDelegates()
+{
+	UE_NET_UNREGISTER_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_TraversalNetState);
+}
+
+void FTraversalNetStateNetSerializer::FNetSerializerRegistryDelegates::OnPreFreezeNetSerializerRegistry()
+{
+	UE_NET_REGISTER_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_TraversalNetState);
+}
+
+}
+
+#endif // UE_WITH_IRIS
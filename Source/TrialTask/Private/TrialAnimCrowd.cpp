@@ -0,0 +1,284 @@
+#include "TrialAnimCrowd.h"
+
+#include "CustomCharacter.h"
+#include "TrialAnimInstance.h"
+#include "TrialTaskLLM.h"
+
+#include "AnimationSharingManager.h"
+#include "AnimationSharingSetup.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "IAnimationBudgetAllocator.h"
+#include "SignificanceManager.h"
+#include "SkeletalMeshComponentBudgeted.h"
+
+static TAutoConsoleVariable<int32> CVarTrialAnimBudget(
+	TEXT("Trial.Anim.Budget"),
+	1,
+	TEXT("Runs character animation through the animation budget allocator (0 = every mesh ticks every frame)."));
+
+static TAutoConsoleVariable<float> CVarTrialAnimBudgetMs(
+	TEXT("Trial.Anim.BudgetMs"),
+	2.0f,
+	TEXT("Game thread + worker milliseconds per frame the allocator aims to spend on character animation."));
+
+static TAutoConsoleVariable<float> CVarTrialAnimSignificanceDistance(
+	TEXT("Trial.Anim.SignificanceDistance"),
+	5000.0f,
+	TEXT("Distance from the local view at which a character's animation significance reaches zero."));
+
+static TAutoConsoleVariable<FString> CVarTrialAnimSharingSetup(
+	TEXT("Trial.Anim.SharingSetup"),
+	TEXT(""),
+	TEXT("Animation sharing setup asset (state processor UTrialAnimSharingStateProcessor) used from the next world start. Empty = no sharing."));
+
+namespace TrialAnimCrowd
+{
+	static const FName SignificanceTag(TEXT("TrialCharacter"));
+
+	// Local view of the last Tick; one local player
+	static FVector ViewLocation = FVector::ZeroVector;
+
+	static float Significance(const AActor* Actor, const FVector& View)
+	{
+		const ACustomCharacter* Character = Cast<ACustomCharacter>(Actor);
+		if (!Character) return 0.f;
+
+		// Vault / mantle montages stay at full quality whatever the distance
+		if (Character->IsParkouring()) return 1.f;
+
+		const float MaxDistance = FMath::Max(1.f, CVarTrialAnimSignificanceDistance.GetValueOnGameThread());
+		return 1.f - FMath::Clamp(FVector::Dist(Character->GetActorLocation(), View) / MaxDistance, 0.f, 1.f);
+	}
+
+	static bool IsLocalPlayer(const ACustomCharacter* Character)
+	{
+		return Character->IsLocallyControlled() && Character->IsPlayerControlled();
+	}
+}
+
+// --------------------
+// SHARING STATE
+// --------------------
+
+void UTrialAnimSharingStateProcessor::ProcessActorState_Implementation(int32& OutState, AActor* InActor, uint8 CurrentState, uint8 OnDemandState, bool& bShouldProcess)
+{
+	OutState = (int32)UTrialAnimInstance::ComputeShareState(Cast<ACharacter>(InActor));
+	bShouldProcess = true;
+}
+
+UEnum* UTrialAnimSharingStateProcessor::GetAnimationStateEnum_Implementation()
+{
+	return StaticEnum<ETrialAnimShareState>();
+}
+
+// --------------------
+// SUBSYSTEM
+// --------------------
+
+bool UTrialAnimCrowdSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// Nothing is rendered on a dedicated server; its meshes only tick when rendered
+	return !IsRunningDedicatedServer() && Super::ShouldCreateSubsystem(Outer);
+}
+
+bool UTrialAnimCrowdSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UTrialAnimCrowdSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTrialAnimCrowdSubsystem, STATGROUP_Tickables);
+}
+
+void UTrialAnimCrowdSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	LLM_SCOPE_BYTAG(TrialTask_Anim);
+
+	ApplyBudget();
+
+	if (!bSignificanceRegistered)
+	{
+		USkeletalMeshComponentBudgeted::SetOnCalculateSignificance(FOnCalculateSignificance::CreateStatic(&UTrialAnimCrowdSubsystem::CalculateBudgetSignificance));
+		bSignificanceRegistered = true;
+	}
+
+	const FString SetupPath = CVarTrialAnimSharingSetup.GetValueOnGameThread();
+	if (!SetupPath.IsEmpty() && UAnimationSharingManager::AnimationSharingEnabled())
+	{
+		if (const UAnimationSharingSetup* Setup = LoadObject<UAnimationSharingSetup>(nullptr, *SetupPath))
+		{
+			bSharingActive = UAnimationSharingManager::CreateAnimationSharingManager(&InWorld, Setup);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("ANIMCROWD: sharing setup %s not found"), *SetupPath);
+		}
+	}
+}
+
+void UTrialAnimCrowdSubsystem::Deinitialize()
+{
+	Characters.Empty();
+	PinnedCharacters.Empty();
+	bSharingActive = false;
+
+	Super::Deinitialize();
+}
+
+void UTrialAnimCrowdSubsystem::ApplyBudget()
+{
+	IAnimationBudgetAllocator* Allocator = IAnimationBudgetAllocator::Get(GetWorld());
+	if (!Allocator) return;
+
+	FAnimationBudgetAllocatorParameters Parameters;
+	Parameters.BudgetInMs = FMath::Max(0.1f, CVarTrialAnimBudgetMs.GetValueOnGameThread());
+	Allocator->SetParameters(Parameters);
+	Allocator->SetEnabled(CVarTrialAnimBudget.GetValueOnGameThread() != 0);
+}
+
+void UTrialAnimCrowdSubsystem::RegisterCharacter(ACustomCharacter* Character)
+{
+	UWorld* World = GetWorld();
+	if (!Character || !World) return;
+
+	LLM_SCOPE_BYTAG(TrialTask_Anim);
+
+	const bool bNew = !Characters.Contains(Character);
+	Characters.AddUnique(Character);
+
+	USkeletalMeshComponentBudgeted* Mesh = Cast<USkeletalMeshComponentBudgeted>(Character->GetMesh());
+	USignificanceManager* Significance = USignificanceManager::Get(World);
+	UAnimationSharingManager* Sharing = bSharingActive ? UAnimationSharingManager::GetAnimationSharingManager(World) : nullptr;
+
+	// The player's own character: full rate, own pose (also when a pooled remote pawn becomes the local one)
+	if (TrialAnimCrowd::IsLocalPlayer(Character))
+	{
+		if (Mesh)
+		{
+			Mesh->SetAutoCalculateSignificance(false);
+			if (IAnimationBudgetAllocator* Allocator = IAnimationBudgetAllocator::Get(World))
+			{
+				Allocator->SetComponentSignificance(Mesh, 1.f, true, false, false);
+			}
+		}
+		if (Significance) Significance->UnregisterObject(Character);
+		if (Sharing) Sharing->UnregisterActor(Character);
+		PinnedCharacters.AddUnique(Character);
+		return;
+	}
+
+	// Remote pawn (also a pooled one that stopped being the local one): drop the local pin, distance falloff
+	// and full significance mid traversal come from CalculateBudgetSignificance (off by default per component)
+	const bool bWasPinned = PinnedCharacters.Remove(Character) > 0;
+	if (Mesh)
+	{
+		if (IAnimationBudgetAllocator* Allocator = IAnimationBudgetAllocator::Get(World))
+		{
+			Allocator->SetComponentSignificance(Mesh, 1.f, false, false, true);
+		}
+		Mesh->SetAutoCalculateSignificance(true);
+	}
+
+	if (Significance && !Significance->GetManagedObject(Character))
+	{
+		Significance->RegisterObject(Character, TrialAnimCrowd::SignificanceTag,
+			[](USignificanceManager::FManagedObjectInfo* Info, const FTransform& View)
+			{
+				return TrialAnimCrowd::Significance(Cast<AActor>(Info->GetObject()), View.GetLocation());
+			});
+	}
+
+	const USkeletalMesh* MeshAsset = Mesh ? Mesh->GetSkeletalMeshAsset() : nullptr;
+	if (Sharing && MeshAsset && (bNew || bWasPinned))
+	{
+		Sharing->RegisterActorWithSkeletonBP(Character, MeshAsset->GetSkeleton());
+	}
+}
+
+void UTrialAnimCrowdSubsystem::UnregisterCharacter(ACustomCharacter* Character)
+{
+	UWorld* World = GetWorld();
+	if (!Character || !World) return;
+
+	Characters.Remove(Character);
+	PinnedCharacters.Remove(Character);
+
+	if (USignificanceManager* Significance = USignificanceManager::Get(World))
+	{
+		Significance->UnregisterObject(Character);
+	}
+	if (UAnimationSharingManager* Sharing = bSharingActive ? UAnimationSharingManager::GetAnimationSharingManager(World) : nullptr)
+	{
+		Sharing->UnregisterActor(Character);
+	}
+}
+
+float UTrialAnimCrowdSubsystem::CalculateBudgetSignificance(USkeletalMeshComponentBudgeted* Component)
+{
+	return Component ? TrialAnimCrowd::Significance(Component->GetOwner(), TrialAnimCrowd::ViewLocation) : 0.f;
+}
+
+void UTrialAnimCrowdSubsystem::Tick(float DeltaTime)
+{
+	UWorld* World = GetWorld();
+	APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+	if (!PC) return;
+
+	FVector Location;
+	FRotator Rotation;
+	PC->GetPlayerViewPoint(Location, Rotation);
+	TrialAnimCrowd::ViewLocation = Location;
+
+	// The sharing manager reads significance from here; nothing else updates it
+	if (USignificanceManager* Significance = USignificanceManager::Get(World))
+	{
+		const FTransform View(Rotation, Location);
+		Significance->Update(MakeArrayView(&View, 1));
+	}
+}
+
+void UTrialAnimCrowdSubsystem::Report() const
+{
+	int32 Alive = 0;
+	int32 Local = 0;
+	for (const TWeakObjectPtr<ACustomCharacter>& Character : Characters)
+	{
+		if (const ACustomCharacter* C = Character.Get())
+		{
+			++Alive;
+			Local += TrialAnimCrowd::IsLocalPlayer(C) ? 1 : 0;
+		}
+	}
+
+	const IAnimationBudgetAllocator* Allocator = IAnimationBudgetAllocator::Get(GetWorld());
+	UE_LOG(LogTemp, Display, TEXT("ANIMCROWD,Characters=%d,Local=%d,Sharing=%d,Budget=%d,BudgetMs=%.2f"),
+		Alive, Local, bSharingActive ? 1 : 0, (Allocator && Allocator->GetEnabled()) ? 1 : 0, CVarTrialAnimBudgetMs.GetValueOnGameThread());
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CmdTrialAnimReport(
+	TEXT("Trial.Anim.Report"),
+	TEXT("Logs an ANIMCROWD line (registered characters, sharing and budget state). Live cost: stat AnimationBudgetAllocator."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (const UTrialAnimCrowdSubsystem* Crowd = World ? World->GetSubsystem<UTrialAnimCrowdSubsystem>() : nullptr)
+		{
+			Crowd->Report();
+		}
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdTrialAnimApplyBudget(
+	TEXT("Trial.Anim.ApplyBudget"),
+	TEXT("Pushes Trial.Anim.Budget / Trial.Anim.BudgetMs to the animation budget allocator."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UTrialAnimCrowdSubsystem* Crowd = World ? World->GetSubsystem<UTrialAnimCrowdSubsystem>() : nullptr)
+		{
+			Crowd->ApplyBudget();
+		}
+	}));
@@ -4,13 +4,19 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "CustomMovementComponent.h"
 #include "CustomCharacter.h"
+#include "ParkourStats.h"
+#include "TrialTaskLLM.h"
 
 #include "KismetAnimationLibrary.h"
 
+DECLARE_CYCLE_STAT(TEXT("TrialAnimUpdate"), STAT_TrialAnimUpdate, STATGROUP_Parkour);
+
 void UTrialAnimInstance::NativeInitializeAnimation()
 {
 	Super::NativeInitializeAnimation();
 
+	LLM_SCOPE_BYTAG(TrialTask_Anim);
+
 	CachedCharacter = Cast<ACharacter>(TryGetPawnOwner());
 	CachedMoveComp = CachedCharacter ? Cast<UCustomMovementComponent>(CachedCharacter->GetCharacterMovement()) : nullptr;
 }
@@ -19,6 +25,9 @@ void UTrialAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 {
 	Super::NativeUpdateAnimation(DeltaSeconds);
 
+	PARKOUR_SCOPE(STAT_TrialAnimUpdate);
+	LLM_SCOPE_BYTAG(TrialTask_Anim);
+
 	if (!CachedCharacter)
 	{
 		CachedCharacter = Cast<ACharacter>(TryGetPawnOwner());
@@ -40,6 +49,7 @@ void UTrialAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 		bIsParkouring = false;
 		bIsVaulting = false;
 		bIsMantling = false;
+		ShareState = ETrialAnimShareState::Idle;
 		return;
 	}
 
@@ -48,22 +58,16 @@ void UTrialAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 
 	bIsInAir = !CachedMoveComp->IsMovingOnGround();
 	bIsCrouched = CachedCharacter->bIsCrouched;
-	bIsSliding = CachedMoveComp->IsSliding();
 
-	const float HorizontalSpeed = CachedMoveComp->GetHorizontalSpeed();
-	const float Walk = FMath::Max(CachedMoveComp->GetWalkSpeed(), 1.0f);
-	const float Sprint = FMath::Max(CachedMoveComp->GetSprintSpeed(), Walk + 1.0f);
+	// One read of the packed mode instead of asking character and movement component separately
+	const FPackedTraversalState Traversal = CachedMoveComp->GetTraversalState();
+	bIsSliding = Traversal.IsSliding();
+	bIsParkouring = Traversal.IsTraversing();
+	bIsVaulting = Traversal.IsVaulting();
+	bIsMantling = Traversal.IsMantling();
 
-	if (HorizontalSpeed <= Walk)
-	{
-		Speed = HorizontalSpeed / Walk;
-	}
-	else
-	{
-		const float SprintRange = Sprint - Walk;
-		const float Alpha = FMath::Clamp((HorizontalSpeed - Walk) / SprintRange, 0.0f, 1.0f);
-		Speed = 1.0f + Alpha;
-	}
+	Speed = NormalizeSpeed(*CachedMoveComp);
+	ShareState = ClassifyShareState(Speed, bIsInAir, bIsSliding, bIsCrouched, bIsParkouring);
 
 	Direction = UKismetAnimationLibrary::CalculateDirection(Vel, CachedCharacter->GetActorRotation());
 	Direction = FMath::Clamp(Direction, -DirectionClampAbs, DirectionClampAbs);
@@ -71,16 +75,50 @@ void UTrialAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 	if (const ACustomCharacter* CC = Cast<ACustomCharacter>(CachedCharacter))
 	{
 		bJumpRequested = CC->bJumpRequested;
-		bIsParkouring = CC->IsParkouring();
-		bIsVaulting = CC->IsVaulting();
-		bIsMantling = CC->IsMantling();
 	}
 	else
 	{
 		bJumpRequested = false;
-		bIsParkouring = false;
-		bIsVaulting = false;
-		bIsMantling = false;
 	}
 }
 
+float UTrialAnimInstance::NormalizeSpeed(const UCustomMovementComponent& Move)
+{
+	const float HorizontalSpeed = Move.GetHorizontalSpeed();
+	const float Walk = FMath::Max(Move.GetWalkSpeed(), 1.0f);
+	const float Sprint = FMath::Max(Move.GetSprintSpeed(), Walk + 1.0f);
+
+	if (HorizontalSpeed <= Walk)
+	{
+		return HorizontalSpeed / Walk;
+	}
+
+	const float SprintRange = Sprint - Walk;
+	const float Alpha = FMath::Clamp((HorizontalSpeed - Walk) / SprintRange, 0.0f, 1.0f);
+	return 1.0f + Alpha;
+}
+
+ETrialAnimShareState UTrialAnimInstance::ClassifyShareState(float NormalizedSpeed, bool bInAir, bool bSliding, bool bCrouched, bool bTraversing)
+{
+	if (bTraversing) return ETrialAnimShareState::Traversal;
+	if (bSliding) return ETrialAnimShareState::Slide;
+	if (bInAir) return ETrialAnimShareState::Air;
+	if (bCrouched) return ETrialAnimShareState::Crouch;
+
+	// Speed bands of BS_Locomotion
+	if (NormalizedSpeed < 0.05f) return ETrialAnimShareState::Idle;
+	if (NormalizedSpeed <= 1.1f) return ETrialAnimShareState::Walk;
+	return ETrialAnimShareState::Sprint;
+}
+
+ETrialAnimShareState UTrialAnimInstance::ComputeShareState(const ACharacter* Character)
+{
+	const UCustomMovementComponent* Move = Character ? Cast<UCustomMovementComponent>(Character->GetCharacterMovement()) : nullptr;
+	if (!Move)
+	{
+		return ETrialAnimShareState::Idle;
+	}
+
+	const FPackedTraversalState Traversal = Move->GetTraversalState();
+	return ClassifyShareState(NormalizeSpeed(*Move), !Move->IsMovingOnGround(), Traversal.IsSliding(), Character->bIsCrouched, Traversal.IsTraversing());
+}
@@ -0,0 +1,292 @@
+#include "TrialBotController.h"
+
+#include "CustomCharacter.h"
+#include "TrialInputTarget.h"
+#include "TrialStressMap.h"
+
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerStart.h"
+#include "HAL/IConsoleManager.h"
+
+ATrialBotController::ATrialBotController()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = true;
+
+	// Server-only brains: nothing about the bot controller needs to reach clients
+	bReplicates = false;
+	bWantsPlayerState = false;
+}
+
+void ATrialBotController::SetBehavior(FName InBehaviorName, int32 Seed)
+{
+	BehaviorName = InBehaviorName;
+	Random.Initialize(Seed);
+
+	const FTrialBotBehavior* Found = Behaviors.FindByPredicate([InBehaviorName](const FTrialBotBehavior& B) { return B.Name == InBehaviorName; });
+	Behavior = Found ? *Found : FTrialBotBehavior();
+
+	ResetTimers();
+}
+
+void ATrialBotController::OnPossess(APawn* InPawn)
+{
+	Super::OnPossess(InPawn);
+
+	BotInput = Cast<ITrialInputTarget>(InPawn);
+	BotPawn = BotInput ? InPawn : nullptr;
+	if (BotPawn)
+	{
+		TargetYaw = BotPawn->GetActorRotation().Yaw;
+		SetControlRotation(FRotator(0.f, TargetYaw, 0.f));
+	}
+	ResetTimers();
+}
+
+void ATrialBotController::OnUnPossess()
+{
+	if (BotInput && bSprintHeld)
+	{
+		BotInput->InjectAction(ETrialInputAction::Sprint, false);
+	}
+	bSprintHeld = false;
+	BotPawn = nullptr;
+	BotInput = nullptr;
+
+	Super::OnUnPossess();
+}
+
+void ATrialBotController::ResetTimers()
+{
+	DecisionAccum = Random.FRand() * DecisionInterval;
+	SlideTimer = NextInterval(Behavior.SlideInterval);
+	SlideHoldLeft = 0.f;
+	ParkourTimer = NextInterval(Behavior.ParkourInterval);
+	JumpTimer = NextInterval(Behavior.JumpInterval);
+	TurnTimer = NextInterval(Behavior.TurnInterval);
+	StuckTime = 0.f;
+}
+
+float ATrialBotController::NextInterval(float Base)
+{
+	// +-25% jitter so hundreds of bots don't act on the same frame
+	return Base > 0.f ? Base * Random.FRandRange(0.75f, 1.25f) : 0.f;
+}
+
+void ATrialBotController::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	if (!BotPawn || !BotInput)
+	{
+		return;
+	}
+
+	DecisionAccum += DeltaSeconds;
+	if (DecisionAccum >= DecisionInterval)
+	{
+		Decide(DecisionAccum);
+		DecisionAccum = 0.f;
+	}
+
+	// Continuous input, same as a held key / moving mouse
+	const float CurrentYaw = GetControlRotation().Yaw;
+	const float YawError = FMath::FindDeltaAngleDegrees(CurrentYaw, TargetYaw);
+	const float YawStep = FMath::Clamp(YawError, -Behavior.TurnRateDegPerSec * DeltaSeconds, Behavior.TurnRateDegPerSec * DeltaSeconds);
+
+	BotInput->InjectLookInput(FVector2D(YawStep, 0.f));
+	BotInput->InjectMoveInput(FVector2D(0.f, 1.f));
+}
+
+void ATrialBotController::Decide(float DeltaSeconds)
+{
+	// Sprint: keep it held, re-press after stamina ran out (the movement component drops it)
+	if (Behavior.bSprint && !BotInput->IsSprintActive() && !BotInput->IsSlideActive() && !BotInput->IsTraversalActive())
+	{
+		BotInput->InjectAction(ETrialInputAction::Sprint, true);
+		bSprintHeld = true;
+	}
+
+	// Slide: press crouch on the interval, release after the hold time
+	if (SlideHoldLeft > 0.f)
+	{
+		SlideHoldLeft -= DeltaSeconds;
+		if (SlideHoldLeft <= 0.f)
+		{
+			BotInput->InjectAction(ETrialInputAction::Crouch, false);
+		}
+	}
+	else if (Behavior.SlideInterval > 0.f && (SlideTimer -= DeltaSeconds) <= 0.f)
+	{
+		BotInput->InjectAction(ETrialInputAction::Crouch, true);
+		SlideHoldLeft = Behavior.SlideHoldTime;
+		SlideTimer = NextInterval(Behavior.SlideInterval);
+	}
+
+	if (Behavior.ParkourInterval > 0.f && (ParkourTimer -= DeltaSeconds) <= 0.f)
+	{
+		BotInput->InjectAction(ETrialInputAction::Parkour, true);
+		ParkourTimer = NextInterval(Behavior.ParkourInterval);
+	}
+
+	if (Behavior.JumpInterval > 0.f && (JumpTimer -= DeltaSeconds) <= 0.f)
+	{
+		BotInput->InjectAction(ETrialInputAction::Jump, true);
+		BotInput->InjectAction(ETrialInputAction::Jump, false);
+		JumpTimer = NextInterval(Behavior.JumpInterval);
+	}
+
+	// Heading: periodic random turns, turn around when stuck against something
+	const float Speed = BotPawn->GetVelocity().Size2D();
+	StuckTime = (Speed < 50.f && !BotInput->IsTraversalActive()) ? StuckTime + DeltaSeconds : 0.f;
+
+	if (StuckTime > 1.f)
+	{
+		TargetYaw = GetControlRotation().Yaw + 180.f + Random.FRandRange(-45.f, 45.f);
+		StuckTime = 0.f;
+	}
+	else if (Behavior.TurnInterval > 0.f && (TurnTimer -= DeltaSeconds) <= 0.f)
+	{
+		TargetYaw = GetControlRotation().Yaw + Random.FRandRange(-Behavior.MaxTurnDegrees, Behavior.MaxTurnDegrees);
+		TurnTimer = NextInterval(Behavior.TurnInterval);
+	}
+}
+
+// --------------------
+// SPAWNING
+// --------------------
+
+UClass* ATrialBotController::FindBotPawnClass(const FString& ClassName)
+{
+	if (ClassName.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	// Full path (/Script/TrialTask.TrialMoverCharacter, /Game/...BP_X.BP_X_C) or a native class name
+	UClass* PawnClass = FSoftClassPath(ClassName).TryLoadClass<APawn>();
+	if (!PawnClass)
+	{
+		PawnClass = FindFirstObject<UClass>(*ClassName, EFindFirstObjectOptions::NativeFirst);
+	}
+
+	if (!PawnClass || !PawnClass->IsChildOf(APawn::StaticClass()) || !PawnClass->ImplementsInterface(UTrialInputTarget::StaticClass()))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("BOTS: '%s' is not a pawn implementing ITrialInputTarget"), *ClassName);
+		return nullptr;
+	}
+	return PawnClass;
+}
+
+int32 ATrialBotController::SpawnBots(UWorld* World, int32 Count, FName InBehaviorName, TArray<APawn*>* OutPawns, UClass* PawnClass)
+{
+	if (!World || Count <= 0 || World->GetNetMode() == NM_Client)
+	{
+		return 0;
+	}
+
+	const ATrialBotController* CDO = GetDefault<ATrialBotController>();
+
+	if (!PawnClass)
+	{
+		PawnClass = CDO->BotCharacterClass.TryLoadClass<APawn>();
+	}
+	if (!PawnClass || !PawnClass->ImplementsInterface(UTrialInputTarget::StaticClass()))
+	{
+		PawnClass = ACustomCharacter::StaticClass();
+	}
+
+	// A generated stress map's spawn points take over from the level's own starts
+	TArray<FTransform> Starts;
+	TArray<FTransform> StressStarts;
+	for (TActorIterator<APlayerStart> It(World); It; ++It)
+	{
+		(It->PlayerStartTag == TrialStressMap::SpawnTag ? StressStarts : Starts).Add(It->GetActorTransform());
+	}
+	if (StressStarts.Num() > 0)
+	{
+		Starts = MoveTemp(StressStarts);
+	}
+	if (Starts.Num() == 0)
+	{
+		Starts.Add(FTransform::Identity);
+	}
+
+	FActorSpawnParameters Params;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	// Square grid around each start so bots don't spawn inside each other
+	const int32 PerStart = FMath::DivideAndRoundUp(Count, Starts.Num());
+	const int32 Side = FMath::CeilToInt(FMath::Sqrt((float)PerStart));
+	const float Spacing = 250.f;
+
+	int32 Spawned = 0;
+	for (int32 i = 0; i < Count; ++i)
+	{
+		const FTransform& Origin = Starts[i % Starts.Num()];
+		const int32 Slot = i / Starts.Num();
+		const FVector Offset((Slot % Side - Side / 2) * Spacing, (Slot / Side - Side / 2) * Spacing, 0.f);
+
+		APawn* Pawn = World->SpawnActor<APawn>(PawnClass, Origin.TransformPosition(Offset), Origin.Rotator(), Params);
+		if (!Pawn) continue;
+
+		ATrialBotController* Bot = World->SpawnActor<ATrialBotController>(ATrialBotController::StaticClass(), Params);
+		if (!Bot)
+		{
+			Pawn->Destroy();
+			continue;
+		}
+
+		const FName Name = !InBehaviorName.IsNone() ? InBehaviorName
+			: (CDO->Behaviors.Num() > 0 ? CDO->Behaviors[i % CDO->Behaviors.Num()].Name : NAME_None);
+
+		Bot->SetBehavior(Name, i);
+		Bot->Possess(Pawn);
+
+		if (OutPawns)
+		{
+			OutPawns->Add(Pawn);
+		}
+		++Spawned;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("BOTS: spawned %d/%d (%s, behavior=%s)"), Spawned, Count, *PawnClass->GetName(), InBehaviorName.IsNone() ? TEXT("mixed") : *InBehaviorName.ToString());
+	return Spawned;
+}
+
+int32 ATrialBotController::DespawnBots(UWorld* World)
+{
+	int32 Removed = 0;
+	if (!World) return 0;
+
+	for (TActorIterator<ATrialBotController> It(World); It; ++It)
+	{
+		if (APawn* Pawn = It->GetPawn())
+		{
+			Pawn->Destroy();
+		}
+		It->Destroy();
+		++Removed;
+	}
+	return Removed;
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CmdTrialSpawnBots(
+	TEXT("Trial.SpawnBots"),
+	TEXT("Trial.SpawnBots <Count> [Behavior|None] [PawnClass]. Spawns bot-driven pawns (server/standalone). Behaviors cycle when omitted, PawnClass defaults to BotCharacterClass."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 Count = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1;
+		const FName Behavior = Args.Num() > 1 ? FName(*Args[1]) : NAME_None;
+		UClass* PawnClass = Args.Num() > 2 ? ATrialBotController::FindBotPawnClass(Args[2]) : nullptr;
+		ATrialBotController::SpawnBots(World, Count, Behavior, nullptr, PawnClass);
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdTrialDespawnBots(
+	TEXT("Trial.DespawnBots"),
+	TEXT("Destroys every bot controller and its pawn."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UE_LOG(LogTemp, Display, TEXT("BOTS: removed %d"), ATrialBotController::DespawnBots(World));
+	}));
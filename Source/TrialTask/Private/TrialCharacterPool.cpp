@@ -0,0 +1,310 @@
+#include "TrialCharacterPool.h"
+
+#include "CustomCharacter.h"
+#include "TrialBotController.h"
+#include "TrialTaskLLM.h"
+
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+bool UTrialCharacterPool::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UTrialCharacterPool::Deinitialize()
+{
+	// Parked actors go away with the world
+	Free.Empty();
+
+	Super::Deinitialize();
+}
+
+int32 UTrialCharacterPool::Prewarm(TSubclassOf<ACustomCharacter> Class, int32 Count)
+{
+	if (!Class || Count <= 0) return 0;
+
+	LLM_SCOPE_BYTAG(TrialTask);
+
+	FTrialCharacterPoolList& List = Free.FindOrAdd(Class.Get());
+	List.Characters.Reserve(List.Characters.Num() + Count);
+
+	int32 Spawned = 0;
+	for (int32 i = 0; i < Count; ++i)
+	{
+		if (ACustomCharacter* Character = SpawnParked(Class.Get(), FTransform::Identity))
+		{
+			List.Characters.Add(Character);
+			++Spawned;
+		}
+	}
+	return Spawned;
+}
+
+ACustomCharacter* UTrialCharacterPool::Acquire(TSubclassOf<ACustomCharacter> Class, const FTransform& Transform, AController* Controller)
+{
+	UWorld* World = GetWorld();
+	if (!Class || !World || World->GetNetMode() == NM_Client)
+	{
+		return nullptr;
+	}
+
+	ACustomCharacter* Character = nullptr;
+	if (FTrialCharacterPoolList* List = Free.Find(Class.Get()))
+	{
+		while (!Character && List->Characters.Num() > 0)
+		{
+			Character = List->Characters.Pop(EAllowShrinking::No);
+			if (!IsValid(Character))
+			{
+				Character = nullptr;
+			}
+		}
+	}
+
+	if (Character)
+	{
+		Unpark(Character, Transform);
+	}
+	else
+	{
+		LLM_SCOPE_BYTAG(TrialTask);
+
+		FActorSpawnParameters Params;
+		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+		Character = World->SpawnActor<ACustomCharacter>(Class.Get(), Transform, Params);
+	}
+
+	if (Character && Controller)
+	{
+		Controller->Possess(Character);
+	}
+	return Character;
+}
+
+void UTrialCharacterPool::Release(ACustomCharacter* Character)
+{
+	if (!IsValid(Character) || !Character->HasAuthority())
+	{
+		return;
+	}
+
+	FTrialCharacterPoolList& List = Free.FindOrAdd(Character->GetClass());
+	if (List.Characters.Contains(Character))
+	{
+		return;
+	}
+
+	Park(Character);
+	List.Characters.Add(Character);
+}
+
+int32 UTrialCharacterPool::GetNumFree(TSubclassOf<ACustomCharacter> Class) const
+{
+	const FTrialCharacterPoolList* List = Free.Find(Class.Get());
+	return List ? List->Characters.Num() : 0;
+}
+
+ACustomCharacter* UTrialCharacterPool::SpawnParked(UClass* Class, const FTransform& Transform)
+{
+	FActorSpawnParameters Params;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	ACustomCharacter* Character = GetWorld()->SpawnActor<ACustomCharacter>(Class, Transform, Params);
+	if (Character)
+	{
+		Park(Character);
+	}
+	return Character;
+}
+
+void UTrialCharacterPool::Park(ACustomCharacter* Character)
+{
+	Character->ResetForPool();
+
+	if (AController* Controller = Character->GetController())
+	{
+		Controller->UnPossess();
+	}
+
+	Character->SetActorHiddenInGame(true);
+	Character->SetActorEnableCollision(false);
+	Character->SetActorTickEnabled(false);
+
+	if (UCharacterMovementComponent* Move = Character->GetCharacterMovement())
+	{
+		Move->SetComponentTickEnabled(false);
+	}
+	if (USkeletalMeshComponent* Mesh = Character->GetMesh())
+	{
+		Mesh->SetComponentTickEnabled(false);
+	}
+
+	// Hidden state goes out with the last update before the channel goes dormant
+	Character->SetNetDormancy(DORM_DormantAll);
+}
+
+void UTrialCharacterPool::Unpark(ACustomCharacter* Character, const FTransform& Transform)
+{
+	Character->SetNetDormancy(DORM_Awake);
+
+	Character->SetActorLocationAndRotation(Transform.GetLocation(), Transform.Rotator(), false, nullptr, ETeleportType::ResetPhysics);
+	Character->SetActorHiddenInGame(false);
+	Character->SetActorEnableCollision(true);
+	Character->SetActorTickEnabled(true);
+
+	if (USkeletalMeshComponent* Mesh = Character->GetMesh())
+	{
+		Mesh->SetComponentTickEnabled(true);
+	}
+	if (UCharacterMovementComponent* Move = Character->GetCharacterMovement())
+	{
+		Move->SetComponentTickEnabled(true);
+		Move->SetMovementMode(MOVE_Walking);
+	}
+}
+
+// --------------------
+// CONSOLE
+// --------------------
+
+static UClass* ResolvePoolClass(UWorld* World, const TArray<FString>& Args, int32 Index)
+{
+	if (Args.IsValidIndex(Index))
+	{
+		if (UClass* Class = FSoftClassPath(Args[Index]).TryLoadClass<ACustomCharacter>())
+		{
+			return Class;
+		}
+	}
+
+	const AGameModeBase* GameMode = World ? World->GetAuthGameMode() : nullptr;
+	if (GameMode && GameMode->DefaultPawnClass && GameMode->DefaultPawnClass->IsChildOf(ACustomCharacter::StaticClass()))
+	{
+		return GameMode->DefaultPawnClass;
+	}
+	return ACustomCharacter::StaticClass();
+}
+
+// Spawn-to-controllable: from the request until the character is possessed and its local setup
+// (mapping context, HUD) is done. Fresh spawns also pay construction, BeginPlay and anim init;
+// their destruction / GC happens outside the timed window.
+static void MeasurePoolLatency(UWorld* World, UClass* Class, int32 Iterations)
+{
+	UTrialCharacterPool* Pool = World ? World->GetSubsystem<UTrialCharacterPool>() : nullptr;
+	if (!Pool || World->GetNetMode() == NM_Client)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("POOL: needs a server or standalone game world"));
+		return;
+	}
+
+	// The local player takes each character (its pawn is restored afterwards); otherwise a temporary bot controller
+	APlayerController* PC = World->GetFirstPlayerController();
+	APawn* OriginalPawn = PC ? PC->GetPawn() : nullptr;
+	AController* Controller = PC;
+	if (!Controller)
+	{
+		Controller = World->SpawnActor<ATrialBotController>();
+	}
+	if (!Controller) return;
+
+	const FTransform At = OriginalPawn
+		? FTransform(OriginalPawn->GetActorRotation(), OriginalPawn->GetActorLocation() + OriginalPawn->GetActorForwardVector() * 300.f)
+		: FTransform::Identity;
+
+	if (Pool->GetNumFree(Class) == 0)
+	{
+		Pool->Prewarm(Class, 1);
+	}
+
+	auto Measure = [&](bool bPooled, double& OutAvgMs, double& OutMaxMs)
+	{
+		double SumMs = 0.0;
+		OutMaxMs = 0.0;
+
+		// Iteration -1 pays first-use costs (class load, shader / widget caches) and is not counted
+		for (int32 i = -1; i < Iterations; ++i)
+		{
+			const double Start = FPlatformTime::Seconds();
+
+			ACustomCharacter* Character = nullptr;
+			if (bPooled)
+			{
+				Character = Pool->Acquire(Class, At, Controller);
+			}
+			else
+			{
+				FActorSpawnParameters Params;
+				Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+				Character = World->SpawnActor<ACustomCharacter>(Class, At, Params);
+				if (Character)
+				{
+					Controller->Possess(Character);
+				}
+			}
+
+			const double Ms = (FPlatformTime::Seconds() - Start) * 1000.0;
+			if (!Character) continue;
+
+			if (i >= 0)
+			{
+				SumMs += Ms;
+				OutMaxMs = FMath::Max(OutMaxMs, Ms);
+			}
+
+			if (bPooled)
+			{
+				Pool->Release(Character);
+			}
+			else
+			{
+				Controller->UnPossess();
+				Character->Destroy();
+			}
+		}
+
+		OutAvgMs = SumMs / FMath::Max(1, Iterations);
+	};
+
+	double SpawnAvg = 0.0, SpawnMax = 0.0, PooledAvg = 0.0, PooledMax = 0.0;
+	Measure(false, SpawnAvg, SpawnMax);
+	Measure(true, PooledAvg, PooledMax);
+
+	if (PC && OriginalPawn)
+	{
+		PC->Possess(OriginalPawn);
+	}
+	else if (!PC)
+	{
+		Controller->Destroy();
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("POOL,Class=%s,Iterations=%d,SpawnAvgMs=%.3f,SpawnMaxMs=%.3f,PooledAvgMs=%.3f,PooledMaxMs=%.3f,Speedup=%.1fx"),
+		*Class->GetName(), Iterations, SpawnAvg, SpawnMax, PooledAvg, PooledMax, PooledAvg > 0.0 ? SpawnAvg / PooledAvg : 0.0);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CmdTrialPoolPrewarm(
+	TEXT("Trial.Pool.Prewarm"),
+	TEXT("Trial.Pool.Prewarm <Count> [CharacterClass]. Spawns parked characters for respawn (server/standalone). Class defaults to the game mode pawn."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UTrialCharacterPool* Pool = World ? World->GetSubsystem<UTrialCharacterPool>() : nullptr;
+		if (!Pool) return;
+
+		UClass* Class = ResolvePoolClass(World, Args, 1);
+		const int32 Spawned = Pool->Prewarm(Class, Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1);
+		UE_LOG(LogTemp, Display, TEXT("POOL: prewarmed %d %s (%d free)"), Spawned, *Class->GetName(), Pool->GetNumFree(Class));
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdTrialPoolLatency(
+	TEXT("Trial.Pool.Latency"),
+	TEXT("Trial.Pool.Latency [Iterations] [CharacterClass]. Spawn-to-controllable time of SpawnActor vs pool Acquire; logs a POOL line."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 Iterations = FMath::Max(1, Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 20);
+		MeasurePoolLatency(World, ResolvePoolClass(World, Args, 1), Iterations);
+	}));
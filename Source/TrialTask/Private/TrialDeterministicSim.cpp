@@ -0,0 +1,464 @@
+#include "TrialDeterministicSim.h"
+
+#include "CustomMovementComponent.h"
+#include "ParkourStats.h"
+
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/Crc.h"
+
+static TAutoConsoleVariable<float> CVarTrialRollbackBudgetMs(
+	TEXT("Trial.Rollback.BudgetMs"),
+	0.25f,
+	TEXT("Per-frame budget for a worst-case (MaxResimFrames) resimulation, checked by Trial.Rollback.DesyncCheck."));
+
+namespace
+{
+	uint64 ISqrt(uint64 Value)
+	{
+		uint64 Result = 0;
+		uint64 Bit = uint64(1) << 62;
+
+		while (Bit > Value)
+		{
+			Bit >>= 2;
+		}
+		while (Bit != 0)
+		{
+			if (Value >= Result + Bit)
+			{
+				Value -= Result + Bit;
+				Result = (Result >> 1) + Bit;
+			}
+			else
+			{
+				Result >>= 1;
+			}
+			Bit >>= 2;
+		}
+		return Result;
+	}
+
+	FTrialFixed Length(FTrialFixed X, FTrialFixed Y)
+	{
+		return FTrialFixed::FromRaw((int64)ISqrt((uint64)(X.Raw * X.Raw + Y.Raw * Y.Raw)));
+	}
+
+	void ClampLength(FTrialFixed& X, FTrialFixed& Y, FTrialFixed Max)
+	{
+		const FTrialFixed Len = Length(X, Y);
+		if (Len > Max && Len.Raw > 0)
+		{
+			X = X * Max / Len;
+			Y = Y * Max / Len;
+		}
+	}
+
+	// Removes Amount of speed along the current direction, stopping at zero
+	void Decelerate(FTrialFixed& X, FTrialFixed& Y, FTrialFixed Amount)
+	{
+		const FTrialFixed Len = Length(X, Y);
+		if (Len <= Amount)
+		{
+			X = FTrialFixed();
+			Y = FTrialFixed();
+			return;
+		}
+		X -= X * Amount / Len;
+		Y -= Y * Amount / Len;
+	}
+}
+
+FTrialDetParams FTrialDetParams::FromMovement(const UCustomMovementComponent* Move, int32 TickRate)
+{
+	const UCustomMovementComponent* Src = Move ? Move : GetDefault<UCustomMovementComponent>();
+
+	FTrialDetParams P;
+	P.TickRate = FMath::Max(1, TickRate);
+
+	const float Dt = 1.f / P.TickRate;
+	P.Dt = FTrialFixed::FromFloat(Dt);
+
+	P.WalkSpeed = FTrialFixed::FromFloat(Src->WalkSpeed);
+	P.SprintSpeed = FTrialFixed::FromFloat(Src->SprintSpeed);
+	P.AccelPerTick = FTrialFixed::FromFloat(Src->MaxAcceleration * Dt);
+	P.BrakePerTick = FTrialFixed::FromFloat(Src->BrakingDecelerationWalking * Dt);
+
+	P.StaminaMax = FTrialFixed::FromFloat(Src->StaminaMax);
+	P.RegenPerTick = FTrialFixed::FromFloat(Src->StaminaRegenPerSec * Dt);
+	P.SprintDrainPerTick = FTrialFixed::FromFloat(Src->SprintDrainPerSec * Dt);
+	P.SlideDrainPerTick = FTrialFixed::FromFloat(Src->SlideDrainPerSec * Dt);
+	P.MinStaminaToSprint = FTrialFixed::FromFloat(Src->MinStaminaToSprint);
+	P.MinStaminaToSlide = FTrialFixed::FromFloat(Src->MinStaminaToSlide);
+
+	P.SlideMinStartSpeed = FTrialFixed::FromFloat(Src->SlideMinStartSpeed);
+	P.SlideGraceStartSpeed = FTrialFixed::FromFloat(Src->SlideMinStartSpeed * UCustomMovementComponent::PostSprintSlideGraceSpeedScale);
+	P.SlideMinSpeedToKeep = FTrialFixed::FromFloat(Src->SlideMinSpeedToKeep);
+	P.SlideFlatDecelPerTick = FTrialFixed::FromFloat(Src->SlideFlatDecel * Dt);
+	P.SlideSteerAccelPerTick = FTrialFixed::FromFloat(Src->SlideSteerAccel * Dt);
+	P.SlideMaxSpeedFlat = FTrialFixed::FromFloat(Src->SlideMaxSpeedFlat);
+	P.SlideGraceTicks = FMath::CeilToInt(Src->PostSprintSlideGraceTime * P.TickRate);
+
+	return P;
+}
+
+uint32 FTrialDetState::Checksum() const
+{
+	return FCrc::MemCrc32(this, sizeof(*this));
+}
+
+void TrialDeterministicSim::Step(FTrialDetState& S, const FTrialDetInput& Input, const FTrialDetParams& P)
+{
+	const bool bCrouch = (Input.Buttons & FTrialDetInput::Crouch) != 0;
+	const bool bSprintHeld = (Input.Buttons & FTrialDetInput::Sprint) != 0;
+	const bool bWasCrouch = (S.Flags & FTrialDetState::CrouchHeld) != 0;
+
+	// Grace window counter (TickComponent)
+	if (!(S.Flags & FTrialDetState::Sprinting))
+	{
+		S.TicksSinceSprintEnded = FMath::Min(S.TicksSinceSprintEnded + 1, 1 << 20);
+	}
+
+	// Input direction, length clamped to 1
+	FTrialFixed DirX = FTrialFixed::FromRaw(Input.MoveX * FTrialFixed::One / 127);
+	FTrialFixed DirY = FTrialFixed::FromRaw(Input.MoveY * FTrialFixed::One / 127);
+	ClampLength(DirX, DirY, FTrialFixed::FromInt(1));
+	const bool bHasInput = DirX.Raw != 0 || DirY.Raw != 0;
+
+	const FTrialFixed Speed = Length(S.VelX, S.VelY);
+
+	// Crouch edges (CrouchPressed -> CanStartSlide / StartSlide, CrouchReleased -> StopSlide)
+	if (bCrouch && !bWasCrouch && !(S.Flags & FTrialDetState::Sliding))
+	{
+		const bool bHasSpeed = Speed >= P.SlideMinStartSpeed;
+		const bool bInGrace = S.TicksSinceSprintEnded <= P.SlideGraceTicks && Speed >= P.SlideGraceStartSpeed;
+		if (S.Stamina >= P.MinStaminaToSlide && (bHasSpeed || bInGrace))
+		{
+			S.Flags |= FTrialDetState::Sliding;
+		}
+	}
+	else if (!bCrouch && bWasCrouch)
+	{
+		S.Flags &= ~FTrialDetState::Sliding;
+	}
+	S.Flags = bCrouch ? (S.Flags | FTrialDetState::CrouchHeld) : (S.Flags & ~FTrialDetState::CrouchHeld);
+
+	if (S.Flags & FTrialDetState::Sliding)
+	{
+		// PhysSlide, flat branch: steering plus constant decel against the pre-steer direction
+		FTrialFixed VelX = S.VelX;
+		FTrialFixed VelY = S.VelY;
+
+		if (bHasInput)
+		{
+			VelX += DirX * P.SlideSteerAccelPerTick;
+			VelY += DirY * P.SlideSteerAccelPerTick;
+		}
+		if (Speed.Raw > 0)
+		{
+			VelX -= S.VelX * P.SlideFlatDecelPerTick / Speed;
+			VelY -= S.VelY * P.SlideFlatDecelPerTick / Speed;
+		}
+
+		ClampLength(VelX, VelY, P.SlideMaxSpeedFlat);
+		S.VelX = VelX;
+		S.VelY = VelY;
+
+		if (Length(S.VelX, S.VelY) < P.SlideMinSpeedToKeep)
+		{
+			S.Flags &= ~FTrialDetState::Sliding;
+		}
+	}
+	else
+	{
+		const FTrialFixed MaxSpeed = (S.Flags & FTrialDetState::Sprinting) ? P.SprintSpeed : P.WalkSpeed;
+
+		if (bHasInput)
+		{
+			S.VelX += DirX * P.AccelPerTick;
+			S.VelY += DirY * P.AccelPerTick;
+			// Above max speed (e.g. right after a slide) speed bleeds off at the braking rate instead of snapping
+			ClampLength(S.VelX, S.VelY, FTrialFixed::Max(MaxSpeed, Speed - P.BrakePerTick));
+		}
+		else
+		{
+			Decelerate(S.VelX, S.VelY, P.BrakePerTick);
+		}
+	}
+
+	S.PosX += S.VelX * P.Dt;
+	S.PosY += S.VelY * P.Dt;
+
+	const bool bSliding = (S.Flags & FTrialDetState::Sliding) != 0;
+	bool bSprinting = (S.Flags & FTrialDetState::Sprinting) != 0;
+
+	// UpdateStamina
+	if (bSprinting && !bSliding)
+	{
+		S.Stamina = FTrialFixed::Max(FTrialFixed(), S.Stamina - P.SprintDrainPerTick);
+	}
+	else if (bSliding)
+	{
+		S.Stamina = FTrialFixed::Max(FTrialFixed(), S.Stamina - P.SlideDrainPerTick);
+	}
+	else
+	{
+		S.Stamina = FTrialFixed::Min(P.StaminaMax, S.Stamina + P.RegenPerTick);
+	}
+
+	if (bSprinting && S.Stamina.Raw == 0)
+	{
+		bSprinting = false;
+		S.TicksSinceSprintEnded = 0;
+	}
+
+	// UpdateMaxSpeed
+	const bool bShouldSprint = bSprintHeld && !bSliding && S.Stamina >= P.MinStaminaToSprint;
+	if (bShouldSprint)
+	{
+		bSprinting = true;
+	}
+	else if (bSprinting)
+	{
+		bSprinting = false;
+		S.TicksSinceSprintEnded = 0;
+	}
+	S.Flags = bSprinting ? (S.Flags | FTrialDetState::Sprinting) : (S.Flags & ~FTrialDetState::Sprinting);
+
+	++S.Frame;
+}
+
+// --------------------
+// Rollback
+// --------------------
+
+void FTrialRollbackSim::Init(const FTrialDetState& Initial, const FTrialDetParams& InParams)
+{
+	Params = InParams;
+	Current = Initial;
+	LastResimMs = 0.0;
+	LastResimFrames = 0;
+}
+
+void FTrialRollbackSim::Advance(const FTrialDetInput& Input)
+{
+	const uint32 Slot = Current.Frame % HistorySize;
+	Snapshots[Slot] = Current;
+	Inputs[Slot] = Input;
+
+	TrialDeterministicSim::Step(Current, Input, Params);
+}
+
+bool FTrialRollbackSim::Correct(uint32 Frame, const FTrialDetInput& Input)
+{
+	if (Frame >= Current.Frame)
+	{
+		// Not simulated yet, nothing to correct
+		return true;
+	}
+	if (Current.Frame - Frame > MaxResimFrames)
+	{
+		return false;
+	}
+
+	const uint32 Slot = Frame % HistorySize;
+	if (Inputs[Slot] == Input)
+	{
+		LastResimFrames = 0;
+		return true;
+	}
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	Inputs[Slot] = Input;
+	const uint32 End = Current.Frame;
+	Current = Snapshots[Slot];
+
+	for (uint32 F = Frame; F < End; ++F)
+	{
+		const uint32 S = F % HistorySize;
+		Snapshots[S] = Current;
+		TrialDeterministicSim::Step(Current, Inputs[S], Params);
+	}
+
+	LastResimFrames = End - Frame;
+	LastResimMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+
+	CSV_CUSTOM_STAT(Parkour, RollbackResimFrames, (int32)LastResimFrames, ECsvCustomStatOp::Accumulate);
+	return true;
+}
+
+uint32 FTrialRollbackSim::GetChecksum(uint32 Frame) const
+{
+	return (Frame == Current.Frame) ? Current.Checksum() : Snapshots[Frame % HistorySize].Checksum();
+}
+
+// --------------------
+// Desync check (two local instances)
+// --------------------
+
+namespace
+{
+	TArray<FTrialDetInput> MakeInputScript(int32 NumFrames, FRandomStream& Stream)
+	{
+		TArray<FTrialDetInput> Script;
+		Script.SetNumUninitialized(NumFrames);
+
+		FTrialDetInput Held;
+		for (int32 F = 0; F < NumFrames; ++F)
+		{
+			// Bot-like: hold a direction for a while, sprint in bursts, tap crouch to slide
+			if (Stream.FRand() < 0.05f)
+			{
+				Held.MoveX = (int8)Stream.RandRange(-127, 127);
+				Held.MoveY = (int8)Stream.RandRange(0, 127);
+			}
+			if (Stream.FRand() < 0.03f)
+			{
+				Held.Buttons ^= FTrialDetInput::Sprint;
+			}
+			if (Stream.FRand() < 0.04f)
+			{
+				Held.Buttons ^= FTrialDetInput::Crouch;
+			}
+			Script[F] = Held;
+		}
+		return Script;
+	}
+}
+
+FTrialDesyncCheckResult TrialDeterministicSim::RunDesyncCheck(const FTrialDetParams& Params, int32 NumFrames, int32 MaxDelay, int32 Seed)
+{
+	FTrialDesyncCheckResult Result;
+	NumFrames = FMath::Max(1, NumFrames);
+
+	// An input delivered D frames late is corrected D + 1 frames back (B has already advanced this frame)
+	Result.MaxDelay = FMath::Clamp(MaxDelay, 0, (int32)FTrialRollbackSim::MaxResimFrames - 1);
+
+	FRandomStream Stream(Seed);
+	const TArray<FTrialDetInput> Script = MakeInputScript(NumFrames, Stream);
+
+	FTrialDetState Initial;
+	Initial.Stamina = Params.StaminaMax;
+
+	// Reference: every input on time, no rollback
+	TArray<uint32> RefChecksums;
+	RefChecksums.SetNumUninitialized(NumFrames + 1);
+	{
+		FTrialDetState Ref = Initial;
+		RefChecksums[0] = Ref.Checksum();
+		for (int32 F = 0; F < NumFrames; ++F)
+		{
+			TrialDeterministicSim::Step(Ref, Script[F], Params);
+			RefChecksums[F + 1] = Ref.Checksum();
+		}
+	}
+
+	// Instance A: local player (inputs on time). Instance B: remote peer (inputs arrive late, predicted meanwhile).
+	FTrialRollbackSim A;
+	FTrialRollbackSim B;
+	A.Init(Initial, Params);
+	B.Init(Initial, Params);
+
+	TArray<int32> Arrival;
+	Arrival.SetNumUninitialized(NumFrames);
+	for (int32 F = 0; F < NumFrames; ++F)
+	{
+		Arrival[F] = F + Stream.RandRange(0, Result.MaxDelay);
+	}
+
+	int32 Confirmed = 0;	// inputs [0, Confirmed) delivered to B
+	FTrialDetInput LastKnown;
+	double ResimMsTotal = 0.0;
+
+	for (int32 F = 0; F < NumFrames && !Result.HasDesync(); ++F)
+	{
+		A.Advance(Script[F]);
+		if (A.GetChecksum(F + 1) != RefChecksums[F + 1])
+		{
+			Result.DesyncFrame = F + 1;
+			break;
+		}
+
+		B.Advance(LastKnown);
+
+		// Deliver everything that arrived by now (in frame order, like a reliable input stream)
+		while (Confirmed <= F && Arrival[Confirmed] <= F)
+		{
+			if (!B.Correct(Confirmed, Script[Confirmed]))
+			{
+				Result.DesyncFrame = Confirmed;
+				break;
+			}
+			if (B.GetLastResimFrames() > 0)
+			{
+				++Result.Resims;
+				ResimMsTotal += B.GetLastResimMs();
+				Result.MaxResimMs = FMath::Max(Result.MaxResimMs, B.GetLastResimMs());
+			}
+			LastKnown = Script[Confirmed];
+			++Confirmed;
+		}
+
+		// Every state whose inputs are all confirmed must match the reference bit for bit
+		if (!Result.HasDesync() && B.GetFrame() - Confirmed < FTrialRollbackSim::HistorySize
+			&& B.GetChecksum(Confirmed) != RefChecksums[Confirmed])
+		{
+			Result.DesyncFrame = Confirmed;
+		}
+	}
+	Result.AvgResimMs = Result.Resims ? ResimMsTotal / Result.Resims : 0.0;
+
+	// Worst case cost: resimulate MaxResimFrames from a mispredicted input
+	if (NumFrames > (int32)FTrialRollbackSim::MaxResimFrames)
+	{
+		const uint32 Frame = A.GetFrame() - FTrialRollbackSim::MaxResimFrames;
+		FTrialDetInput Flipped = Script[Frame];
+		Flipped.Buttons ^= FTrialDetInput::Sprint;
+
+		constexpr int32 Runs = 200;
+		for (int32 Run = 0; Run < Runs; ++Run)
+		{
+			FTrialRollbackSim Scratch = A;
+			Scratch.Correct(Frame, Flipped);
+			Result.WorstResimMs = FMath::Max(Result.WorstResimMs, Scratch.GetLastResimMs());
+		}
+	}
+
+	return Result;
+}
+
+namespace
+{
+	void RunDesyncCheckCommand(const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 NumFrames = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 3600;
+		const int32 MaxDelay = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 8;
+		const int32 Seed = Args.Num() > 2 ? FCString::Atoi(*Args[2]) : 1234;
+
+		// Tuning of the local pawn if there is one, class defaults otherwise
+		const UCustomMovementComponent* Move = nullptr;
+		if (const APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr)
+		{
+			const ACharacter* Character = Cast<ACharacter>(PC->GetPawn());
+			Move = Character ? Cast<UCustomMovementComponent>(Character->GetCharacterMovement()) : nullptr;
+		}
+
+		const FTrialDesyncCheckResult Result = TrialDeterministicSim::RunDesyncCheck(FTrialDetParams::FromMovement(Move), NumFrames, MaxDelay, Seed);
+
+		const float BudgetMs = CVarTrialRollbackBudgetMs.GetValueOnGameThread();
+		const bool bPassed = !Result.HasDesync() && Result.WorstResimMs <= BudgetMs;
+
+		UE_LOG(LogTemp, Display, TEXT("ROLLBACK,Frames=%d,MaxDelay=%d,Seed=%d,Resims=%u,AvgResimUs=%.2f,MaxResimUs=%.2f,Worst%uFrameResimUs=%.2f,BudgetUs=%.0f,DesyncFrame=%d,Result=%s"),
+			NumFrames, Result.MaxDelay, Seed, Result.Resims, 1000.0 * Result.AvgResimMs, 1000.0 * Result.MaxResimMs,
+			FTrialRollbackSim::MaxResimFrames, 1000.0 * Result.WorstResimMs, 1000.0 * BudgetMs, Result.DesyncFrame, bPassed ? TEXT("PASS") : TEXT("FAIL"));
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CmdTrialRollbackDesyncCheck(
+	TEXT("Trial.Rollback.DesyncCheck"),
+	TEXT("Runs two deterministic sim instances (one with late inputs + rollback) against a reference and reports desyncs and resim cost. Args: [Frames=3600] [MaxDelay=8] [Seed=1234]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunDesyncCheckCommand));
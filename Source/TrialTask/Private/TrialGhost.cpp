@@ -0,0 +1,641 @@
+#include "TrialGhost.h"
+
+#include "CustomCharacter.h"
+#include "ParkourStats.h"
+#include "TrialTaskLLM.h"
+
+#include "Async/MappedFileHandle.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryWriter.h"
+
+DECLARE_CYCLE_STAT(TEXT("GhostPlayback"), STAT_GhostPlayback, STATGROUP_Parkour);
+
+// --------------------
+// FORMAT
+// --------------------
+
+namespace TrialGhostFormat
+{
+	enum EChannel : uint8
+	{
+		LocX = 1 << 0,
+		LocY = 1 << 1,
+		LocZ = 1 << 2,
+		VelX = 1 << 3,
+		VelY = 1 << 4,
+		VelZ = 1 << 5,
+		YawChanged = 1 << 6,
+		StateChanged = 1 << 7,
+	};
+
+	constexpr float LocationStep = 1.f;
+	constexpr float VelocityStep = 2.f;
+	constexpr float YawUnitsPerDegree = 65536.f / 360.f;
+
+	static void WriteVarInt(TArray<uint8>& Out, int32 Value)
+	{
+		uint32 ZigZag = ((uint32)Value << 1) ^ (uint32)(Value >> 31);
+		while (ZigZag >= 0x80)
+		{
+			Out.Add((uint8)(ZigZag | 0x80));
+			ZigZag >>= 7;
+		}
+		Out.Add((uint8)ZigZag);
+	}
+
+	static bool ReadVarInt(const uint8* Data, int64 Size, int64& InOutOffset, int32& OutValue)
+	{
+		uint32 ZigZag = 0;
+		for (int32 Shift = 0; Shift < 35; Shift += 7)
+		{
+			if (InOutOffset >= Size) return false;
+
+			const uint8 Byte = Data[InOutOffset++];
+			ZigZag |= (uint32)(Byte & 0x7F) << Shift;
+			if ((Byte & 0x80) == 0)
+			{
+				OutValue = (int32)(ZigZag >> 1) ^ -(int32)(ZigZag & 1);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	FQuantSample Quantize(const FVector& Location, const FVector& Velocity, float Yaw, uint8 State)
+	{
+		FQuantSample Sample;
+		Sample.Location = FIntVector(
+			FMath::RoundToInt(Location.X / LocationStep),
+			FMath::RoundToInt(Location.Y / LocationStep),
+			FMath::RoundToInt(Location.Z / LocationStep));
+		Sample.Velocity = FIntVector(
+			FMath::RoundToInt(Velocity.X / VelocityStep),
+			FMath::RoundToInt(Velocity.Y / VelocityStep),
+			FMath::RoundToInt(Velocity.Z / VelocityStep));
+		Sample.Yaw = (uint16)(FMath::RoundToInt(FRotator::ClampAxis(Yaw) * YawUnitsPerDegree) & 0xFFFF);
+		Sample.State = State;
+		return Sample;
+	}
+
+	void Encode(TArray<uint8>& Out, const FQuantSample& Prev, const FQuantSample& Sample)
+	{
+		const FIntVector DLoc = Sample.Location - Prev.Location;
+		const FIntVector DVel = Sample.Velocity - Prev.Velocity;
+		const int16 DYaw = (int16)(Sample.Yaw - Prev.Yaw);
+
+		uint8 Flags = 0;
+		if (DLoc.X) Flags |= LocX;
+		if (DLoc.Y) Flags |= LocY;
+		if (DLoc.Z) Flags |= LocZ;
+		if (DVel.X) Flags |= VelX;
+		if (DVel.Y) Flags |= VelY;
+		if (DVel.Z) Flags |= VelZ;
+		if (DYaw) Flags |= YawChanged;
+		if (Sample.State != Prev.State) Flags |= StateChanged;
+
+		Out.Add(Flags);
+		if (Flags & LocX) WriteVarInt(Out, DLoc.X);
+		if (Flags & LocY) WriteVarInt(Out, DLoc.Y);
+		if (Flags & LocZ) WriteVarInt(Out, DLoc.Z);
+		if (Flags & VelX) WriteVarInt(Out, DVel.X);
+		if (Flags & VelY) WriteVarInt(Out, DVel.Y);
+		if (Flags & VelZ) WriteVarInt(Out, DVel.Z);
+		if (Flags & YawChanged) WriteVarInt(Out, DYaw);
+		if (Flags & StateChanged) Out.Add(Sample.State);
+	}
+
+	bool Decode(const uint8* Data, int64 Size, int64& InOutOffset, FQuantSample& InOutSample)
+	{
+		if (InOutOffset >= Size) return false;
+		const uint8 Flags = Data[InOutOffset++];
+
+		auto ApplyDelta = [&](EChannel Channel, int32& InOutValue)
+		{
+			int32 Delta = 0;
+			if (!(Flags & Channel)) return true;
+			if (!ReadVarInt(Data, Size, InOutOffset, Delta)) return false;
+			InOutValue += Delta;
+			return true;
+		};
+
+		int32 Yaw = InOutSample.Yaw;
+		if (!ApplyDelta(LocX, InOutSample.Location.X) || !ApplyDelta(LocY, InOutSample.Location.Y) || !ApplyDelta(LocZ, InOutSample.Location.Z)
+			|| !ApplyDelta(VelX, InOutSample.Velocity.X) || !ApplyDelta(VelY, InOutSample.Velocity.Y) || !ApplyDelta(VelZ, InOutSample.Velocity.Z)
+			|| !ApplyDelta(YawChanged, Yaw))
+		{
+			return false;
+		}
+		InOutSample.Yaw = (uint16)(Yaw & 0xFFFF);
+
+		if (Flags & StateChanged)
+		{
+			if (InOutOffset >= Size) return false;
+			InOutSample.State = Data[InOutOffset++];
+		}
+		return true;
+	}
+}
+
+// --------------------
+// RECORDER
+// --------------------
+
+FTrialGhostRecorder::FTrialGhostRecorder(uint32 InSampleRate)
+	: SampleRate(FMath::Max(1u, InSampleRate))
+{
+	// A minute at a few bytes per sample
+	Data.Reserve(SampleRate * 60 * 4);
+}
+
+void FTrialGhostRecorder::AddSample(const FVector& Location, const FVector& Velocity, float Yaw, uint8 State)
+{
+	// The first record is a delta from zero, i.e. absolute
+	const TrialGhostFormat::FQuantSample Sample = TrialGhostFormat::Quantize(Location, Velocity, Yaw, State);
+	TrialGhostFormat::Encode(Data, Prev, Sample);
+	Prev = Sample;
+	++NumSamples;
+}
+
+bool FTrialGhostRecorder::SaveToFile(const FString& Path) const
+{
+	TArray<uint8> Bytes;
+	Bytes.Reserve(TrialGhostFormat::HeaderBytes + Data.Num());
+
+	FMemoryWriter Ar(Bytes);
+	uint32 FileMagic = TrialGhostFormat::Magic;
+	uint32 FileVersion = TrialGhostFormat::Version;
+	uint32 FileSampleRate = SampleRate;
+	uint32 FileNumSamples = (uint32)NumSamples;
+	Ar << FileMagic << FileVersion << FileSampleRate << FileNumSamples;
+
+	Bytes.Append(Data);
+	return FFileHelper::SaveArrayToFile(Bytes, *Path);
+}
+
+// --------------------
+// TRACK
+// --------------------
+
+FTrialGhostTrack::~FTrialGhostTrack()
+{
+	// Region before the handle it was mapped from
+	Region.Reset();
+	Handle.Reset();
+}
+
+TSharedPtr<FTrialGhostTrack> FTrialGhostTrack::Open(const FString& Path)
+{
+	TSharedPtr<FTrialGhostTrack> Track = MakeShared<FTrialGhostTrack>();
+
+	const uint8* Bytes = nullptr;
+	int64 NumBytes = 0;
+
+	IPlatformFile::FOpenMappedResult Mapped = FPlatformFileManager::Get().GetPlatformFile().OpenMappedEx(*Path);
+	if (Mapped.HasValue())
+	{
+		Track->Handle = Mapped.StealValue();
+		Track->Region.Reset(Track->Handle->MapRegion(0, Track->Handle->GetFileSize()));
+	}
+
+	if (Track->Region)
+	{
+		Bytes = Track->Region->GetMappedPtr();
+		NumBytes = Track->Region->GetMappedSize();
+	}
+	else
+	{
+		Track->Handle.Reset();
+		if (!FFileHelper::LoadFileToArray(Track->Loaded, *Path))
+		{
+			return nullptr;
+		}
+		Bytes = Track->Loaded.GetData();
+		NumBytes = Track->Loaded.Num();
+	}
+
+	if (NumBytes < TrialGhostFormat::HeaderBytes)
+	{
+		return nullptr;
+	}
+
+	uint32 Header[4];
+	FMemory::Memcpy(Header, Bytes, sizeof(Header));
+	if (Header[0] != TrialGhostFormat::Magic || Header[1] != TrialGhostFormat::Version || Header[2] == 0 || Header[3] < 2)
+	{
+		return nullptr;
+	}
+
+	Track->SampleRate = Header[2];
+	Track->NumSamples = Header[3];
+	Track->Data = Bytes + TrialGhostFormat::HeaderBytes;
+	Track->Size = NumBytes - TrialGhostFormat::HeaderBytes;
+	return Track;
+}
+
+// --------------------
+// SUBSYSTEM
+// --------------------
+
+namespace TrialGhost
+{
+	static const TCHAR* MeshPath = TEXT("/Engine/BasicShapes/Cylinder.Cylinder");
+
+	// Unit cylinder to a character-sized column
+	static const FVector MeshScale(0.7, 0.7, 1.8);
+}
+
+FString UTrialGhostSubsystem::ResolvePath(const FString& Name)
+{
+	if (FPaths::IsRelative(Name) && !Name.Contains(TEXT("/")) && !Name.Contains(TEXT("\\")))
+	{
+		return FPaths::ProjectSavedDir() / TEXT("Ghosts") / FPaths::SetExtension(Name, TEXT("tgh"));
+	}
+	return Name;
+}
+
+bool UTrialGhostSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UTrialGhostSubsystem::Deinitialize()
+{
+	Recorder.Reset();
+	ClearGhosts();
+
+	Super::Deinitialize();
+}
+
+TStatId UTrialGhostSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTrialGhostSubsystem, STATGROUP_Tickables);
+}
+
+bool UTrialGhostSubsystem::StartRecording(ACustomCharacter* Character, uint32 SampleRate)
+{
+	if (!Character) return false;
+
+	LLM_SCOPE_BYTAG(TrialTask);
+
+	Recorder = MakeUnique<FTrialGhostRecorder>(SampleRate);
+	RecordedCharacter = Character;
+	RecordAccumulator = 0.f;
+
+	// Sample 0 is the start
+	TickRecording(0.f);
+	return true;
+}
+
+bool UTrialGhostSubsystem::StopRecording(const FString& Path)
+{
+	if (!Recorder) return false;
+
+	const bool bSaved = Recorder->GetNumSamples() >= 2 && Recorder->SaveToFile(Path);
+	UE_LOG(LogTemp, Display, TEXT("GHOSTREC,File=%s,Saved=%d,Samples=%d,Rate=%u,Bytes=%d,BytesPerSample=%.2f"),
+		*Path, bSaved ? 1 : 0, Recorder->GetNumSamples(), Recorder->GetSampleRate(), Recorder->GetNumBytes(),
+		Recorder->GetNumSamples() > 0 ? (double)Recorder->GetNumBytes() / Recorder->GetNumSamples() : 0.0);
+
+	Recorder.Reset();
+	RecordedCharacter.Reset();
+	return bSaved;
+}
+
+void UTrialGhostSubsystem::TickRecording(float DeltaTime)
+{
+	const ACustomCharacter* Character = RecordedCharacter.Get();
+	if (!Character)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("GHOSTREC: recorded character is gone, recording dropped"));
+		Recorder.Reset();
+		return;
+	}
+
+	const float Step = 1.f / Recorder->GetSampleRate();
+
+	const FVector Location = Character->GetActorLocation();
+	const FVector Velocity = Character->GetVelocity();
+	const float Yaw = Character->GetActorRotation().Yaw;
+	const uint8 StateBits = Character->GetTraversalModeState().Bits
+		& (FPackedTraversalState::ModeMask | FPackedTraversalState::CrouchRequestedBit);
+
+	if (Recorder->GetNumSamples() == 0)
+	{
+		RecordAccumulator = 0.f;
+		Recorder->AddSample(Location, Velocity, Yaw, StateBits);
+	}
+	else
+	{
+		// One sample per step, so playback time stays in step with recorded time when a frame is longer than Step
+		const float ToYaw = RecordPrevYaw + FRotator::NormalizeAxis(Yaw - RecordPrevYaw);
+		RecordAccumulator += DeltaTime;
+		while (RecordAccumulator >= Step)
+		{
+			RecordAccumulator -= Step;
+
+			// The sample is due RecordAccumulator seconds before the end of this frame
+			const float Alpha = DeltaTime > 0.f ? FMath::Clamp(1.f - RecordAccumulator / DeltaTime, 0.f, 1.f) : 1.f;
+			Recorder->AddSample(FMath::Lerp(RecordPrevLocation, Location, Alpha), FMath::Lerp(RecordPrevVelocity, Velocity, Alpha),
+				FMath::Lerp(RecordPrevYaw, ToYaw, Alpha), StateBits);
+		}
+	}
+
+	RecordPrevLocation = Location;
+	RecordPrevVelocity = Velocity;
+	RecordPrevYaw = Yaw;
+}
+
+int32 UTrialGhostSubsystem::AddGhosts(const FString& Path, int32 Count, float StaggerSeconds)
+{
+	if (Count <= 0 || !EnsureVisuals()) return 0;
+
+	LLM_SCOPE_BYTAG(TrialTask);
+
+	uint16 TrackIndex = 0;
+	if (const uint16* Found = TrackByPath.Find(Path))
+	{
+		TrackIndex = *Found;
+	}
+	else
+	{
+		TSharedPtr<FTrialGhostTrack> Track = FTrialGhostTrack::Open(Path);
+		if (!Track || Tracks.Num() > MAX_uint16)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("GHOSTS: can't open %s"), *Path);
+			return 0;
+		}
+		TrackIndex = (uint16)Tracks.Add(Track);
+		TrackByPath.Add(Path, TrackIndex);
+	}
+
+	const FTrialGhostTrack& Track = *Tracks[TrackIndex];
+	const float Duration = (Track.GetNumSamples() - 1) / (float)Track.GetSampleRate();
+
+	Ghosts.Reserve(Ghosts.Num() + Count);
+	InstanceTransforms.Reserve(Ghosts.Num() + Count);
+
+	TArray<FTransform> NewInstances;
+	NewInstances.Reserve(Count);
+	for (int32 i = 0; i < Count; ++i)
+	{
+		FGhost& Ghost = Ghosts.AddDefaulted_GetRef();
+		Ghost.Track = TrackIndex;
+		RestartGhost(Ghost);
+
+		// Staggered ghosts start further into the loop
+		Ghost.Time = Duration > 0.f ? FMath::Fmod(i * StaggerSeconds, Duration) : 0.f;
+		AdvanceGhost(Ghost);
+
+		NewInstances.Add(FTransform::Identity);
+	}
+
+	Visuals->AddInstances(NewInstances, false, true);
+	return Count;
+}
+
+void UTrialGhostSubsystem::ClearGhosts()
+{
+	Ghosts.Reset();
+	InstanceTransforms.Reset();
+	Tracks.Reset();
+	TrackByPath.Reset();
+	AvgUpdateMicros = 0.0;
+
+	if (Visuals)
+	{
+		Visuals->ClearInstances();
+	}
+}
+
+void UTrialGhostSubsystem::RestartGhost(FGhost& Ghost) const
+{
+	const FTrialGhostTrack& Track = *Tracks[Ghost.Track];
+
+	Ghost.Offset = 0;
+	Ghost.Prev = TrialGhostFormat::FQuantSample();
+	TrialGhostFormat::Decode(Track.GetData(), Track.GetSize(), Ghost.Offset, Ghost.Prev);
+	Ghost.Next = Ghost.Prev;
+	TrialGhostFormat::Decode(Track.GetData(), Track.GetSize(), Ghost.Offset, Ghost.Next);
+	Ghost.NextIndex = 1;
+}
+
+void UTrialGhostSubsystem::AdvanceGhost(FGhost& Ghost) const
+{
+	const FTrialGhostTrack& Track = *Tracks[Ghost.Track];
+	const float Step = 1.f / Track.GetSampleRate();
+
+	while (Ghost.Time >= Ghost.NextIndex * Step)
+	{
+		Ghost.Prev = Ghost.Next;
+		const bool bDecoded = Ghost.NextIndex + 1 < Track.GetNumSamples()
+			&& TrialGhostFormat::Decode(Track.GetData(), Track.GetSize(), Ghost.Offset, Ghost.Next);
+
+		if (!bDecoded)
+		{
+			// End of the run: loop. A truncated file restarts at its last good record.
+			const bool bTruncated = Ghost.NextIndex + 1 < Track.GetNumSamples();
+			const float Duration = (Track.GetNumSamples() - 1) * Step;
+			Ghost.Time = bTruncated ? 0.f : FMath::Fmod(Ghost.Time, Duration);
+			RestartGhost(Ghost);
+			continue;
+		}
+		++Ghost.NextIndex;
+	}
+}
+
+void UTrialGhostSubsystem::Tick(float DeltaTime)
+{
+	if (Recorder)
+	{
+		TickRecording(DeltaTime);
+	}
+
+	if (Ghosts.Num() > 0 && Visuals)
+	{
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		TickPlayback(DeltaTime);
+		const double Micros = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0;
+		AvgUpdateMicros = AvgUpdateMicros > 0.0 ? FMath::Lerp(AvgUpdateMicros, Micros, 0.05) : Micros;
+	}
+}
+
+void UTrialGhostSubsystem::TickPlayback(float DeltaTime)
+{
+	PARKOUR_SCOPE(STAT_GhostPlayback);
+	LLM_SCOPE_BYTAG(TrialTask);
+
+	InstanceTransforms.SetNum(Ghosts.Num(), EAllowShrinking::No);
+
+	bool bStateChanged = false;
+	for (int32 i = 0; i < Ghosts.Num(); ++i)
+	{
+		FGhost& Ghost = Ghosts[i];
+		const FTrialGhostTrack& Track = *Tracks[Ghost.Track];
+		const float Step = 1.f / Track.GetSampleRate();
+
+		Ghost.Time += DeltaTime;
+		AdvanceGhost(Ghost);
+
+		const float Alpha = FMath::Clamp((Ghost.Time - (Ghost.NextIndex - 1) * Step) / Step, 0.f, 1.f);
+
+		// Hermite between samples: the velocity stream keeps curves round at low sample rates
+		const FVector P0 = FVector(Ghost.Prev.Location) * TrialGhostFormat::LocationStep;
+		const FVector P1 = FVector(Ghost.Next.Location) * TrialGhostFormat::LocationStep;
+		const FVector T0 = FVector(Ghost.Prev.Velocity) * (TrialGhostFormat::VelocityStep * Step);
+		const FVector T1 = FVector(Ghost.Next.Velocity) * (TrialGhostFormat::VelocityStep * Step);
+		const FVector Location = FMath::CubicInterp(P0, T0, P1, T1, Alpha);
+
+		const float YawUnits = Ghost.Prev.Yaw + (int16)(Ghost.Next.Yaw - Ghost.Prev.Yaw) * Alpha;
+		const FQuat Rotation(FVector::UpVector, FMath::DegreesToRadians(YawUnits / TrialGhostFormat::YawUnitsPerDegree));
+
+		InstanceTransforms[i] = FTransform(Rotation, Location, TrialGhost::MeshScale);
+
+		const uint8 State = Ghost.Prev.State;
+		if (State != Ghost.ShownState)
+		{
+			Ghost.ShownState = State;
+			Visuals->SetCustomDataValue(i, 0, (float)(State & FPackedTraversalState::ModeMask), false);
+			bStateChanged = true;
+		}
+	}
+
+	Visuals->BatchUpdateInstancesTransforms(0, InstanceTransforms, true, true, true);
+	if (bStateChanged)
+	{
+		Visuals->MarkRenderStateDirty();
+	}
+}
+
+bool UTrialGhostSubsystem::EnsureVisuals()
+{
+	if (Visuals) return true;
+
+	UWorld* World = GetWorld();
+	UStaticMesh* Mesh = LoadObject<UStaticMesh>(nullptr, TrialGhost::MeshPath);
+	if (!World || !Mesh) return false;
+
+	FActorSpawnParameters Params;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	Params.ObjectFlags |= RF_Transient;
+
+	VisualsActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, Params);
+	if (!VisualsActor) return false;
+
+	// Visual only: no collision, navigation or shadows
+	Visuals = NewObject<UInstancedStaticMeshComponent>(VisualsActor, TEXT("GhostVisuals"));
+	Visuals->SetMobility(EComponentMobility::Movable);
+	Visuals->SetStaticMesh(Mesh);
+	Visuals->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Visuals->SetCanEverAffectNavigation(false);
+	Visuals->SetCastShadow(false);
+	Visuals->NumCustomDataFloats = 1;
+
+	VisualsActor->SetRootComponent(Visuals);
+	Visuals->RegisterComponent();
+	return true;
+}
+
+void UTrialGhostSubsystem::Report() const
+{
+	int64 TrackBytes = 0;
+	int32 MappedTracks = 0;
+	for (const TSharedPtr<FTrialGhostTrack>& Track : Tracks)
+	{
+		TrackBytes += Track->GetSize() + TrialGhostFormat::HeaderBytes;
+		MappedTracks += Track->IsMapped() ? 1 : 0;
+	}
+
+	const int32 Num = Ghosts.Num();
+	const int64 InstanceBytes = Visuals ? (int64)Visuals->GetResourceSizeBytes(EResourceSizeMode::Exclusive) : 0;
+
+	// Ghost cursor + transform scratch + its share of the instance buffers; tracks are shared and reported apart
+	const int64 PerGhostBytes = (int64)sizeof(FGhost) + (int64)sizeof(FTransform) + (Num > 0 ? InstanceBytes / Num : 0);
+
+	UE_LOG(LogTemp, Display, TEXT("GHOSTS,Ghosts=%d,Tracks=%d,Mapped=%d,UpdateUs=%.1f,PerGhostUs=%.3f,PerGhostBytes=%lld,InstanceKB=%.1f,TrackKB=%.1f"),
+		Num, Tracks.Num(), MappedTracks, AvgUpdateMicros, Num > 0 ? AvgUpdateMicros / Num : 0.0,
+		PerGhostBytes, InstanceBytes / 1024.0, TrackBytes / 1024.0);
+}
+
+// --------------------
+// CONSOLE
+// --------------------
+
+namespace TrialGhostConsole
+{
+	static ACustomCharacter* FindLocalCharacter(UWorld* World)
+	{
+		APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+		return PC ? Cast<ACustomCharacter>(PC->GetPawn()) : nullptr;
+	}
+
+	static UTrialGhostSubsystem* Get(UWorld* World)
+	{
+		return World ? World->GetSubsystem<UTrialGhostSubsystem>() : nullptr;
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CmdTrialGhostRecord(
+	TEXT("Trial.Ghost.Record"),
+	TEXT("Trial.Ghost.Record [Rate=30]. Starts recording the local character as a ghost run."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UTrialGhostSubsystem* Ghosts = TrialGhostConsole::Get(World);
+		ACustomCharacter* Pawn = TrialGhostConsole::FindLocalCharacter(World);
+		if (Ghosts && Pawn)
+		{
+			Ghosts->StartRecording(Pawn, (uint32)FMath::Clamp(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 30, 1, 120));
+		}
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdTrialGhostStopRecord(
+	TEXT("Trial.Ghost.StopRecord"),
+	TEXT("Trial.Ghost.StopRecord <name>. Stops recording and writes the ghost file."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UTrialGhostSubsystem* Ghosts = TrialGhostConsole::Get(World))
+		{
+			Ghosts->StopRecording(UTrialGhostSubsystem::ResolvePath(Args.Num() > 0 ? Args[0] : TEXT("LastGhost")));
+		}
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdTrialGhostPlay(
+	TEXT("Trial.Ghost.Play"),
+	TEXT("Trial.Ghost.Play <name> [Count=1] [StaggerSec=0.5]. Plays Count looping ghosts of a ghost file."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UTrialGhostSubsystem* Ghosts = TrialGhostConsole::Get(World))
+		{
+			const FString Path = UTrialGhostSubsystem::ResolvePath(Args.Num() > 0 ? Args[0] : TEXT("LastGhost"));
+			const int32 Count = FMath::Max(1, Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 1);
+			const float Stagger = Args.Num() > 2 ? FCString::Atof(*Args[2]) : 0.5f;
+			Ghosts->AddGhosts(Path, Count, Stagger);
+		}
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdTrialGhostClear(
+	TEXT("Trial.Ghost.Clear"),
+	TEXT("Removes all ghosts."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UTrialGhostSubsystem* Ghosts = TrialGhostConsole::Get(World))
+		{
+			Ghosts->ClearGhosts();
+		}
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdTrialGhostReport(
+	TEXT("Trial.Ghost.Report"),
+	TEXT("Logs a GHOSTS line: ghost count, playback CPU per frame and per ghost, memory per ghost and shared track memory."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UTrialGhostSubsystem* Ghosts = TrialGhostConsole::Get(World))
+		{
+			Ghosts->Report();
+		}
+	}));
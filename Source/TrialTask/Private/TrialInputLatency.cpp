@@ -0,0 +1,215 @@
+#include "TrialInputLatency.h"
+
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarTrialLatencyProbe(
+	TEXT("Trial.Latency.Probe"),
+	0,
+	TEXT("Timestamps input edges of the local character and their first capsule motion (Trial.Latency.Report)."));
+
+static TAutoConsoleVariable<int32> CVarTrialTickEarlySprint(
+	TEXT("Trial.Tick.EarlySprint"),
+	0,
+	TEXT("1: the movement component resolves sprint requests before moving, so a sprint press takes effect the same frame.\n")
+	TEXT("0: resolved after moving (sprint speed applies from the next frame)."));
+
+namespace TrialInputLatency
+{
+	// An edge older than this never produced motion
+	constexpr double StaleSeconds = 1.0;
+
+	static const TCHAR* ActionNames[] = { TEXT("Move"), TEXT("Sprint"), TEXT("Slide"), TEXT("Parkour") };
+	static_assert(UE_ARRAY_COUNT(ActionNames) == (int32)ETrialLatencyAction::Num, "Name every latency action");
+
+	struct FPending
+	{
+		const APawn* Pawn = nullptr;	// identity only, never dereferenced
+		uint64 Frame = 0;
+		double Seconds = 0.0;
+	};
+
+	struct FHistogram
+	{
+		uint32 Buckets[FTrialInputLatency::NumBuckets] = {};
+		uint32 Samples = 0;
+		uint32 Dropped = 0;
+		double SumMs = 0.0;
+		double MaxMs = 0.0;
+	};
+
+	static FPending Pending[(int32)ETrialLatencyAction::Num];
+	static FHistogram Histograms[(int32)ETrialLatencyAction::Num];
+}
+
+uint8 FTrialInputLatency::PendingMask = 0;
+
+bool FTrialInputLatency::IsEnabled()
+{
+	return CVarTrialLatencyProbe.GetValueOnGameThread() != 0;
+}
+
+bool FTrialInputLatency::UseEarlySprint()
+{
+	return CVarTrialTickEarlySprint.GetValueOnGameThread() != 0;
+}
+
+void FTrialInputLatency::NoteInput(const APawn* Pawn, ETrialLatencyAction Action)
+{
+	using namespace TrialInputLatency;
+
+	if (!IsEnabled() || !Pawn || !Pawn->IsLocallyControlled() || !Pawn->IsPlayerControlled())
+	{
+		return;
+	}
+
+	const uint8 Bit = 1u << (uint8)Action;
+	if (PendingMask & Bit)
+	{
+		++Histograms[(int32)Action].Dropped;
+	}
+
+	FPending& Edge = Pending[(int32)Action];
+	Edge.Pawn = Pawn;
+	Edge.Frame = GFrameCounter;
+	Edge.Seconds = FPlatformTime::Seconds();
+	PendingMask |= Bit;
+}
+
+void FTrialInputLatency::CloseEdge(const APawn* Pawn, ETrialLatencyAction Action)
+{
+	using namespace TrialInputLatency;
+
+	FPending& Edge = Pending[(int32)Action];
+	if (Edge.Pawn != Pawn)
+	{
+		return;
+	}
+
+	PendingMask &= ~(1u << (uint8)Action);
+
+	FHistogram& Histogram = Histograms[(int32)Action];
+	const double Ms = (FPlatformTime::Seconds() - Edge.Seconds) * 1000.0;
+	if (Ms > StaleSeconds * 1000.0)
+	{
+		++Histogram.Dropped;
+		return;
+	}
+
+	const uint64 Frames = GFrameCounter - Edge.Frame;
+	++Histogram.Buckets[FMath::Min<uint64>(Frames, NumBuckets - 1)];
+	++Histogram.Samples;
+	Histogram.SumMs += Ms;
+	Histogram.MaxMs = FMath::Max(Histogram.MaxMs, Ms);
+}
+
+void FTrialInputLatency::Report()
+{
+	using namespace TrialInputLatency;
+
+	// Edges still waiting past the stale limit never moved anything
+	const double Now = FPlatformTime::Seconds();
+	for (int32 i = 0; i < (int32)ETrialLatencyAction::Num; ++i)
+	{
+		if ((PendingMask & (1u << i)) && Now - Pending[i].Seconds > StaleSeconds)
+		{
+			PendingMask &= ~(1u << i);
+			++Histograms[i].Dropped;
+		}
+	}
+
+	for (int32 i = 0; i < (int32)ETrialLatencyAction::Num; ++i)
+	{
+		const FHistogram& H = Histograms[i];
+		UE_LOG(LogTemp, Display, TEXT("LATENCY,Action=%s,Samples=%u,Dropped=%u,F0=%u,F1=%u,F2=%u,F3=%u,F4=%u,F5Plus=%u,AvgMs=%.2f,MaxMs=%.2f,EarlySprint=%d"),
+			ActionNames[i], H.Samples, H.Dropped, H.Buckets[0], H.Buckets[1], H.Buckets[2], H.Buckets[3], H.Buckets[4], H.Buckets[5],
+			H.Samples ? H.SumMs / H.Samples : 0.0, H.MaxMs, UseEarlySprint() ? 1 : 0);
+	}
+}
+
+void FTrialInputLatency::Reset()
+{
+	using namespace TrialInputLatency;
+
+	PendingMask = 0;
+	for (int32 i = 0; i < (int32)ETrialLatencyAction::Num; ++i)
+	{
+		Pending[i] = FPending();
+		Histograms[i] = FHistogram();
+	}
+}
+
+static FAutoConsoleCommand CmdTrialLatencyReport(
+	TEXT("Trial.Latency.Report"),
+	TEXT("Logs one LATENCY line per action: input-to-motion frame histogram (F0 = same frame), average / max ms, dropped edges."),
+	FConsoleCommandDelegate::CreateStatic(&FTrialInputLatency::Report));
+
+static FAutoConsoleCommand CmdTrialLatencyReset(
+	TEXT("Trial.Latency.Reset"),
+	TEXT("Clears the latency histograms."),
+	FConsoleCommandDelegate::CreateStatic(&FTrialInputLatency::Reset));
+
+// --------------------
+// TICK ORDER
+// --------------------
+
+namespace TrialTickOrder
+{
+	static void LogTickFunction(const TCHAR* Label, const UObject* Owner, const FTickFunction& Tick)
+	{
+		FString Prereqs;
+		for (const FTickPrerequisite& Prereq : Tick.GetPrerequisites())
+		{
+			if (const UObject* Object = Prereq.PrerequisiteObject.Get())
+			{
+				Prereqs += Prereqs.IsEmpty() ? Object->GetName() : (TEXT("|") + Object->GetName());
+			}
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("TICKORDER,Tick=%s,Object=%s,Group=%s,EndGroup=%s,Prereqs=%s"),
+			Label, Owner ? *Owner->GetName() : TEXT("None"),
+			*UEnum::GetValueAsString(Tick.TickGroup.GetValue()), *UEnum::GetValueAsString(Tick.EndTickGroup.GetValue()),
+			Prereqs.IsEmpty() ? TEXT("None") : *Prereqs);
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CmdTrialTickOrder(
+	TEXT("Trial.Tick.Order"),
+	TEXT("Trial.Tick.Order [TickGroup]. Logs TICKORDER lines (group, prerequisites) for the local player controller, character, movement and mesh.\n")
+	TEXT("With TickGroup (0 = PrePhysics, 1 = StartPhysics, 2 = DuringPhysics, ...) moves the character and its movement into that group ")
+	TEXT("and makes both explicit dependents of the controller, so input handled this frame is always moved this frame."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+		ACharacter* Character = PC ? Cast<ACharacter>(PC->GetPawn()) : nullptr;
+		if (!Character) return;
+
+		UCharacterMovementComponent* Move = Character->GetCharacterMovement();
+
+		if (Args.Num() > 0)
+		{
+			const int32 Group = FMath::Clamp(FCString::Atoi(*Args[0]), (int32)TG_PrePhysics, (int32)TG_PostUpdateWork);
+			Character->SetTickGroup((ETickingGroup)Group);
+			Character->AddTickPrerequisiteActor(PC);
+			if (Move)
+			{
+				Move->SetTickGroup((ETickingGroup)Group);
+				Move->AddTickPrerequisiteActor(PC);
+			}
+		}
+
+		TrialTickOrder::LogTickFunction(TEXT("Controller"), PC, PC->PrimaryActorTick);
+		TrialTickOrder::LogTickFunction(TEXT("Character"), Character, Character->PrimaryActorTick);
+		if (Move)
+		{
+			TrialTickOrder::LogTickFunction(TEXT("Movement"), Move, Move->PrimaryComponentTick);
+		}
+		if (USkeletalMeshComponent* Mesh = Character->GetMesh())
+		{
+			TrialTickOrder::LogTickFunction(TEXT("Mesh"), Mesh, Mesh->PrimaryComponentTick);
+		}
+	}));
@@ -0,0 +1,144 @@
+#include "TrialInputRecording.h"
+
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+static_assert((uint8)ETrialInputAction::Count <= 8, "Action edges are packed into one byte");
+
+namespace TrialInputRecording
+{
+	enum EFrameFlags : uint8
+	{
+		MoveChanged = 1 << 0,
+		RotationChanged = 1 << 1,
+	};
+
+	static void SerializeInitial(FArchive& Ar, FTrialReplayInitialState& State)
+	{
+		Ar << State.Location << State.Rotation << State.ControlRotation << State.Velocity;
+		Ar << State.Stamina << State.MovementMode << State.CustomMovementMode << State.bIsCrouched << State.HeldActionMask;
+	}
+}
+
+bool FTrialInputRecording::SaveToFile(const FString& Path) const
+{
+	using namespace TrialInputRecording;
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Ar(Bytes);
+
+	uint32 FileMagic = Magic;
+	uint32 FileVersion = Version;
+	int32 NumFrames = Frames.Num();
+	Ar << FileMagic << FileVersion << NumFrames;
+
+	FTrialReplayInitialState InitialCopy = Initial;
+	SerializeInitial(Ar, InitialCopy);
+
+	FTrialInputFrame Prev;
+	Prev.ControlRotation = FRotator3f(Initial.ControlRotation);
+
+	for (const FTrialInputFrame& Frame : Frames)
+	{
+		uint8 Flags = 0;
+		if (Frame.Move != Prev.Move) Flags |= MoveChanged;
+		if (!(Frame.ControlRotation == Prev.ControlRotation)) Flags |= RotationChanged;
+
+		FTrialInputFrame Copy = Frame;
+		Ar << Flags << Copy.PressedMask << Copy.ReleasedMask << Copy.DeltaSeconds;
+
+		if (Flags & MoveChanged)
+		{
+			Ar << Copy.Move.X << Copy.Move.Y;
+		}
+		if (Flags & RotationChanged)
+		{
+			Ar << Copy.ControlRotation.Pitch << Copy.ControlRotation.Yaw << Copy.ControlRotation.Roll;
+		}
+
+		Prev = Frame;
+	}
+
+	return FFileHelper::SaveArrayToFile(Bytes, *Path);
+}
+
+bool FTrialInputRecording::LoadFromFile(const FString& Path)
+{
+	using namespace TrialInputRecording;
+
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *Path))
+	{
+		return false;
+	}
+
+	FMemoryReader Ar(Bytes);
+
+	uint32 FileMagic = 0;
+	uint32 FileVersion = 0;
+	int32 NumFrames = 0;
+	Ar << FileMagic << FileVersion << NumFrames;
+
+	if (FileMagic != Magic || FileVersion != Version || NumFrames < 0)
+	{
+		return false;
+	}
+
+	SerializeInitial(Ar, Initial);
+
+	Frames.Reset(NumFrames);
+
+	FTrialInputFrame Prev;
+	Prev.ControlRotation = FRotator3f(Initial.ControlRotation);
+
+	for (int32 i = 0; i < NumFrames && !Ar.IsError(); ++i)
+	{
+		FTrialInputFrame Frame = Prev;
+		uint8 Flags = 0;
+		Ar << Flags << Frame.PressedMask << Frame.ReleasedMask << Frame.DeltaSeconds;
+
+		if (Flags & MoveChanged)
+		{
+			Ar << Frame.Move.X << Frame.Move.Y;
+		}
+		if (Flags & RotationChanged)
+		{
+			Ar << Frame.ControlRotation.Pitch << Frame.ControlRotation.Yaw << Frame.ControlRotation.Roll;
+		}
+
+		Frames.Add(Frame);
+		Prev = Frame;
+	}
+
+	return !Ar.IsError() && Frames.Num() == NumFrames;
+}
+
+FTrialInputRecorder::FTrialInputRecorder(const FTrialReplayInitialState& Initial)
+{
+	Recording.Initial = Initial;
+	Recording.Frames.Reserve(60 * 60);
+}
+
+void FTrialInputRecorder::NoteAction(ETrialInputAction Action, bool bPressed)
+{
+	const uint8 Bit = 1u << (uint8)Action;
+	if (bPressed)
+	{
+		Pending.PressedMask |= Bit;
+	}
+	else
+	{
+		Pending.ReleasedMask |= Bit;
+	}
+}
+
+void FTrialInputRecorder::CommitFrame(float DeltaSeconds, const FRotator& ControlRotation)
+{
+	Pending.DeltaSeconds = DeltaSeconds;
+	Pending.ControlRotation = FRotator3f(ControlRotation);
+	Recording.Frames.Add(Pending);
+
+	// Axes are re-sent every frame they're held, edges are one-shot
+	Pending = FTrialInputFrame();
+}
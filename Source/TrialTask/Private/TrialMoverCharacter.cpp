@@ -0,0 +1,263 @@
+#include "TrialMoverCharacter.h"
+
+#include "CustomCharacter.h"
+#include "TrialMoverComponent.h"
+#include "TrialTaskLLM.h"
+
+#include "Camera/CameraComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "GameFramework/PlayerController.h"
+#include "MoverDataModelTypes.h"
+
+#include "EnhancedInputSubsystems.h"
+#include "EnhancedInputComponent.h"
+
+ATrialMoverCharacter::ATrialMoverCharacter(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	LLM_SCOPE_BYTAG(TrialTask);
+
+	// Mover runs its own simulation tick; the pawn only gathers input
+	PrimaryActorTick.bCanEverTick = false;
+
+	CapsuleComponent = CreateDefaultSubobject<UCapsuleComponent>(TEXT("CollisionCylinder"));
+	CapsuleComponent->InitCapsuleSize(34.f, 88.f);
+	CapsuleComponent->SetCollisionProfileName(UCollisionProfile::Pawn_ProfileName);
+	RootComponent = CapsuleComponent;
+
+	Mesh = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("CharacterMesh0"));
+	Mesh->SetupAttachment(CapsuleComponent);
+	Mesh->SetRelativeLocation(FVector(0.f, 0.f, -88.f));
+	Mesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+	// Created everywhere so the class default is the same in every process; servers deactivate it in BeginPlay
+	FirstPersonCamera = CreateDefaultSubobject<UCameraComponent>(TEXT("FirstPersonCamera"));
+	FirstPersonCamera->SetupAttachment(CapsuleComponent);
+	FirstPersonCamera->SetRelativeLocation(FVector(0.f, 0.f, 64.f));
+	FirstPersonCamera->bUsePawnControlRotation = true;
+
+	MoverComponent = CreateDefaultSubobject<UTrialMoverComponent>(TEXT("MoverComponent"));
+
+	// Mover replicates its own sync state
+	bReplicates = true;
+	SetReplicatingMovement(false);
+
+	bUseControllerRotationYaw = false;
+	bUseControllerRotationPitch = false;
+	bUseControllerRotationRoll = false;
+
+	AutoPossessAI = EAutoPossessAI::Disabled;
+}
+
+const ACustomCharacter* ATrialMoverCharacter::GetTuningSource() const
+{
+	UClass* SourceClass = TuningSourceClass.TryLoadClass<ACustomCharacter>();
+	return SourceClass ? SourceClass->GetDefaultObject<ACustomCharacter>() : GetDefault<ACustomCharacter>();
+}
+
+void ATrialMoverCharacter::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	// Before BeginPlay so the first simulated frame already uses the CMC numbers
+	const ACustomCharacter* Source = GetTuningSource();
+	if (Source && MoverComponent)
+	{
+		if (const UCapsuleComponent* SourceCapsule = Source->GetCapsuleComponent())
+		{
+			CapsuleComponent->SetCapsuleSize(SourceCapsule->GetUnscaledCapsuleRadius(), SourceCapsule->GetUnscaledCapsuleHalfHeight());
+		}
+		MoverComponent->ApplyTuning(*Source);
+	}
+}
+
+void ATrialMoverCharacter::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (IsNetMode(NM_DedicatedServer))
+	{
+		// No viewport to view through
+		FirstPersonCamera->Deactivate();
+		return;
+	}
+
+	APlayerController* LocalPC = Cast<APlayerController>(GetController());
+	if (!LocalPC || !LocalPC->IsLocalController())
+	{
+		return;
+	}
+
+	const ACustomCharacter* Source = GetTuningSource();
+	ULocalPlayer* LP = LocalPC->GetLocalPlayer();
+	UEnhancedInputLocalPlayerSubsystem* Subsystem = LP ? LP->GetSubsystem<UEnhancedInputLocalPlayerSubsystem>() : nullptr;
+	if (Subsystem && Source && Source->DefaultMappingContext)
+	{
+		Subsystem->ClearAllMappings();
+		Subsystem->AddMappingContext(Source->DefaultMappingContext, 0);
+	}
+}
+
+void ATrialMoverCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
+{
+	Super::SetupPlayerInputComponent(PlayerInputComponent);
+
+	UEnhancedInputComponent* EIC = Cast<UEnhancedInputComponent>(PlayerInputComponent);
+	const ACustomCharacter* Source = GetTuningSource();
+	if (!EIC || !Source) return;
+
+	if (Source->IA_MoveForward)
+	{
+		EIC->BindAction(Source->IA_MoveForward, ETriggerEvent::Triggered, this, &ATrialMoverCharacter::MoveForward);
+	}
+
+	if (Source->IA_MoveRight)
+	{
+		EIC->BindAction(Source->IA_MoveRight, ETriggerEvent::Triggered, this, &ATrialMoverCharacter::MoveRight);
+	}
+
+	if (Source->IA_Look)
+	{
+		EIC->BindAction(Source->IA_Look, ETriggerEvent::Triggered, this, &ATrialMoverCharacter::Look);
+	}
+
+	if (Source->IA_Jump)
+	{
+		EIC->BindAction(Source->IA_Jump, ETriggerEvent::Started, this, &ATrialMoverCharacter::JumpPressed);
+		EIC->BindAction(Source->IA_Jump, ETriggerEvent::Completed, this, &ATrialMoverCharacter::JumpReleased);
+	}
+
+	if (Source->IA_Sprint)
+	{
+		EIC->BindAction(Source->IA_Sprint, ETriggerEvent::Started, this, &ATrialMoverCharacter::SprintPressed);
+		EIC->BindAction(Source->IA_Sprint, ETriggerEvent::Completed, this, &ATrialMoverCharacter::SprintReleased);
+	}
+
+	if (Source->IA_Crouch)
+	{
+		EIC->BindAction(Source->IA_Crouch, ETriggerEvent::Started, this, &ATrialMoverCharacter::CrouchPressed);
+		EIC->BindAction(Source->IA_Crouch, ETriggerEvent::Completed, this, &ATrialMoverCharacter::CrouchReleased);
+	}
+
+	if (Source->IA_Parkour)
+	{
+		EIC->BindAction(Source->IA_Parkour, ETriggerEvent::Started, this, &ATrialMoverCharacter::ParkourPressed);
+	}
+}
+
+FVector ATrialMoverCharacter::GetVelocity() const
+{
+	return MoverComponent ? MoverComponent->GetVelocity() : FVector::ZeroVector;
+}
+
+// --------------------
+// INPUT
+// --------------------
+
+void ATrialMoverCharacter::MoveForward(const FInputActionValue& Value)
+{
+	PendingMove.Y += Value.Get<float>();
+}
+
+void ATrialMoverCharacter::MoveRight(const FInputActionValue& Value)
+{
+	PendingMove.X += Value.Get<float>();
+}
+
+void ATrialMoverCharacter::Look(const FInputActionValue& Value)
+{
+	const FVector2D Axis = Value.Get<FVector2D>();
+	AddControllerYawInput(Axis.X);
+	AddControllerPitchInput(Axis.Y * -1.0f);
+}
+
+void ATrialMoverCharacter::InjectMoveInput(const FVector2D& Axes)
+{
+	PendingMove += Axes;
+}
+
+void ATrialMoverCharacter::InjectLookInput(const FVector2D& Axes)
+{
+	if (!Controller) return;
+
+	// AddController*Input only works for player controllers; other controllers rotate directly
+	if (!Controller->IsLocalPlayerController())
+	{
+		FRotator ControlRot = Controller->GetControlRotation();
+		ControlRot.Yaw += Axes.X;
+		ControlRot.Pitch = FMath::ClampAngle(ControlRot.Pitch - Axes.Y, -89.f, 89.f);
+		Controller->SetControlRotation(ControlRot);
+		return;
+	}
+
+	Look(FInputActionValue(Axes));
+}
+
+void ATrialMoverCharacter::InjectAction(ETrialInputAction Action, bool bPressed)
+{
+	switch (Action)
+	{
+	case ETrialInputAction::Jump:
+		bJumpJustPressed |= bPressed && !bJumpHeld;
+		bJumpHeld = bPressed;
+		break;
+	case ETrialInputAction::Sprint:
+		bSprintHeld = bPressed;
+		break;
+	case ETrialInputAction::Crouch:
+		bCrouchJustPressed |= bPressed && !bCrouchHeld;
+		bCrouchHeld = bPressed;
+		break;
+	case ETrialInputAction::Parkour:
+		bParkourJustPressed |= bPressed;
+		break;
+	default:
+		break;
+	}
+}
+
+bool ATrialMoverCharacter::IsSprintActive() const
+{
+	return MoverComponent && MoverComponent->IsSprinting();
+}
+
+bool ATrialMoverCharacter::IsSlideActive() const
+{
+	return MoverComponent && MoverComponent->IsSliding();
+}
+
+bool ATrialMoverCharacter::IsTraversalActive() const
+{
+	return MoverComponent && MoverComponent->IsTraversing();
+}
+
+void ATrialMoverCharacter::ProduceInput_Implementation(int32 SimTimeMs, FMoverInputCmdContext& InputCmdResult)
+{
+	FCharacterDefaultInputs& CharacterInputs = InputCmdResult.InputCollection.FindOrAddMutableDataByType<FCharacterDefaultInputs>();
+	FTrialMoverInputs& TrialInputs = InputCmdResult.InputCollection.FindOrAddMutableDataByType<FTrialMoverInputs>();
+
+	const FRotator ControlRot = Controller ? Controller->GetControlRotation() : GetActorRotation();
+	const FRotator YawRot(0.f, ControlRot.Yaw, 0.f);
+
+	// Same axes as MoveForward / MoveRight of the CMC character: forward and right of the control yaw
+	const FVector MoveIntent = YawRot.RotateVector(FVector(PendingMove.Y, PendingMove.X, 0.f)).GetClampedToMaxSize(1.f);
+
+	CharacterInputs.ControlRotation = ControlRot;
+	CharacterInputs.SetMoveInput(EMoveInputType::DirectionalIntent, MoveIntent);
+	CharacterInputs.OrientationIntent = YawRot.Vector(); // first person: body follows the camera yaw
+	CharacterInputs.bIsJumpPressed = bJumpHeld;
+	CharacterInputs.bIsJumpJustPressed = bJumpJustPressed;
+
+	TrialInputs.bSprintHeld = bSprintHeld;
+	TrialInputs.bCrouchHeld = bCrouchHeld;
+	TrialInputs.bCrouchJustPressed = bCrouchJustPressed;
+	TrialInputs.bParkourJustPressed = bParkourJustPressed;
+
+	// Edges and per-frame axes are consumed, held buttons persist
+	PendingMove = FVector2D::ZeroVector;
+	bJumpJustPressed = false;
+	bCrouchJustPressed = false;
+	bParkourJustPressed = false;
+}
@@ -0,0 +1,422 @@
+#include "TrialMoverComponent.h"
+
+#include "CustomMovementComponent.h"
+#include "ParkourStats.h"
+#include "TrialMoverModes.h"
+#include "TrialParkourObstacle.h"
+#include "TrialTaskLLM.h"
+
+#include "Components/CapsuleComponent.h"
+#include "DefaultMovementSet/Settings/CommonLegacyMovementSettings.h"
+#include "Engine/NetSerialization.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("MoverFindTraversal"), STAT_MoverFindTraversal, STATGROUP_Parkour);
+
+namespace TrialMoverModes
+{
+	const FName Slide(TEXT("TrialSlide"));
+	const FName Traversal(TEXT("TrialTraversal"));
+}
+
+// --------------------
+// INPUT / SYNC STATE
+// --------------------
+
+bool FTrialMoverInputs::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	Super::NetSerialize(Ar, Map, bOutSuccess);
+
+	uint8 Bits = (bSprintHeld ? 1 : 0) | (bCrouchHeld ? 2 : 0) | (bCrouchJustPressed ? 4 : 0) | (bParkourJustPressed ? 8 : 0);
+	Ar.SerializeBits(&Bits, 4);
+
+	if (Ar.IsLoading())
+	{
+		bSprintHeld = (Bits & 1) != 0;
+		bCrouchHeld = (Bits & 2) != 0;
+		bCrouchJustPressed = (Bits & 4) != 0;
+		bParkourJustPressed = (Bits & 8) != 0;
+	}
+
+	bOutSuccess = true;
+	return true;
+}
+
+void FTrialMoverInputs::ToString(FAnsiStringBuilderBase& Out) const
+{
+	Super::ToString(Out);
+	Out.Appendf("Sprint=%d Crouch=%d CrouchPressed=%d ParkourPressed=%d\n", bSprintHeld, bCrouchHeld, bCrouchJustPressed, bParkourJustPressed);
+}
+
+void FTrialMoverInputs::Merge(const FMoverDataStructBase& From)
+{
+	// Several input frames folded into one sim step: keep the edges, take the latest held state
+	const FTrialMoverInputs& Other = static_cast<const FTrialMoverInputs&>(From);
+	bSprintHeld = Other.bSprintHeld;
+	bCrouchHeld = Other.bCrouchHeld;
+	bCrouchJustPressed |= Other.bCrouchJustPressed;
+	bParkourJustPressed |= Other.bParkourJustPressed;
+}
+
+bool FTrialMoverSyncState::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	Super::NetSerialize(Ar, Map, bOutSuccess);
+
+	Ar << Stamina;
+	Ar << TimeSinceSprintEnded;
+
+	uint8 Bits = (bSprinting ? 1 : 0) | (bSliding ? 2 : 0) | ((uint8)Parkour << 2) | ((uint8)Phase << 4);
+	Ar.SerializeBits(&Bits, 6);
+
+	if (Ar.IsLoading())
+	{
+		bSprinting = (Bits & 1) != 0;
+		bSliding = (Bits & 2) != 0;
+		Parkour = (EParkourType)((Bits >> 2) & 3);
+		Phase = (EParkourPhase)((Bits >> 4) & 3);
+	}
+
+	// Traversal points only while traversing
+	if (Parkour != EParkourType::None)
+	{
+		Ar << PhaseElapsed;
+		bOutSuccess &= SerializePackedVector<10, 24>(ParkourStart, Ar);
+		bOutSuccess &= SerializePackedVector<10, 24>(ParkourApex, Ar);
+		bOutSuccess &= SerializePackedVector<10, 24>(ParkourTarget, Ar);
+	}
+
+	return true;
+}
+
+void FTrialMoverSyncState::ToString(FAnsiStringBuilderBase& Out) const
+{
+	Super::ToString(Out);
+	Out.Appendf("Stamina=%.2f Sprint=%d Slide=%d Parkour=%d Phase=%d Elapsed=%.3f\n", Stamina, bSprinting, bSliding, (int32)Parkour, (int32)Phase, PhaseElapsed);
+}
+
+bool FTrialMoverSyncState::ShouldReconcile(const FMoverDataStructBase& AuthorityState) const
+{
+	const FTrialMoverSyncState& Auth = static_cast<const FTrialMoverSyncState&>(AuthorityState);
+
+	return bSprinting != Auth.bSprinting
+		|| bSliding != Auth.bSliding
+		|| Parkour != Auth.Parkour
+		|| Phase != Auth.Phase
+		|| FMath::Abs(Stamina - Auth.Stamina) > 1.f;
+}
+
+void FTrialMoverSyncState::Interpolate(const FMoverDataStructBase& From, const FMoverDataStructBase& To, float Pct)
+{
+	const FTrialMoverSyncState& A = static_cast<const FTrialMoverSyncState&>(From);
+	const FTrialMoverSyncState& B = static_cast<const FTrialMoverSyncState&>(To);
+
+	// Mode bits and traversal points snap, stamina is smooth for the HUD
+	*this = Pct < 0.5f ? A : B;
+	Stamina = FMath::Lerp(A.Stamina, B.Stamina, Pct);
+}
+
+// --------------------
+// TUNING
+// --------------------
+
+void FTrialMoverTuning::CopyFrom(const ACustomCharacter& Character, const UCustomMovementComponent& Move)
+{
+	WalkSpeed = Move.WalkSpeed;
+	SprintSpeed = Move.SprintSpeed;
+	BrakingDecelerationWalking = Move.BrakingDecelerationWalking;
+	StaminaMax = Move.StaminaMax;
+	StaminaRegenPerSec = Move.StaminaRegenPerSec;
+	SprintDrainPerSec = Move.SprintDrainPerSec;
+	SlideDrainPerSec = Move.SlideDrainPerSec;
+	MinStaminaToSprint = Move.MinStaminaToSprint;
+	MinStaminaToSlide = Move.MinStaminaToSlide;
+	SlideMinStartSpeed = Move.SlideMinStartSpeed;
+	SlideMinSpeedToKeep = Move.SlideMinSpeedToKeep;
+	SlideFlatDecel = Move.SlideFlatDecel;
+	SlideMaxSpeedFlat = Move.SlideMaxSpeedFlat;
+	SlideMaxSpeedDownhill = Move.SlideMaxSpeedDownhill;
+	SlideUphillDecel = Move.SlideUphillDecel;
+	SlideDownhillAccel = Move.SlideDownhillAccel;
+	SlideSteerAccel = Move.SlideSteerAccel;
+	SlideSlopeAngleMinDeg = Move.SlideSlopeAngleMinDeg;
+	PostSprintSlideGraceTime = Move.PostSprintSlideGraceTime;
+
+	ParkourFrontCheckDistance = Character.ParkourFrontCheckDistance;
+	ParkourFrontCheckRadius = Character.ParkourFrontCheckRadius;
+	ParkourTopTraceHeight = Character.ParkourTopTraceHeight;
+	VaultMaxObstacleHeight = Character.VaultMaxObstacleHeight;
+	MantleMaxObstacleHeight = Character.MantleMaxObstacleHeight;
+	ParkourLandForwardOffset = Character.ParkourLandForwardOffset;
+	ParkourLandUpOffset = Character.ParkourLandUpOffset;
+	ParkourLandingForwardExtra = Character.ParkourLandingForwardExtra;
+	ParkourLandingCapsuleInflate = Character.ParkourLandingCapsuleInflate;
+	VaultToApexDuration = Character.VaultToApexDuration;
+	VaultToTargetDuration = Character.VaultToTargetDuration;
+	MantleToApexDuration = Character.MantleToApexDuration;
+	MantleToTargetDuration = Character.MantleToTargetDuration;
+	ApexForwardExtra = Character.ApexForwardExtra;
+	ApexUpExtra = Character.ApexUpExtra;
+}
+
+float FTrialMoverTuning::GetPhaseDuration(EParkourType Type, EParkourPhase Phase) const
+{
+	const bool bVault = Type == EParkourType::Vault;
+	if (Phase == EParkourPhase::ToApex)
+	{
+		return bVault ? VaultToApexDuration : MantleToApexDuration;
+	}
+	if (Phase == EParkourPhase::ToTarget)
+	{
+		return bVault ? VaultToTargetDuration : MantleToTargetDuration;
+	}
+	return 0.f;
+}
+
+// --------------------
+// COMPONENT
+// --------------------
+
+UTrialMoverComponent::UTrialMoverComponent()
+{
+	LLM_SCOPE_BYTAG(TrialTask_Movement);
+
+	MovementModes.Add(DefaultModeNames::Walking, CreateDefaultSubobject<UTrialMoverWalkingMode>(TEXT("TrialWalkingMode")));
+	MovementModes.Add(DefaultModeNames::Falling, CreateDefaultSubobject<UTrialMoverFallingMode>(TEXT("TrialFallingMode")));
+	MovementModes.Add(TrialMoverModes::Slide, CreateDefaultSubobject<UTrialMoverSlideMode>(TEXT("TrialSlideMode")));
+	MovementModes.Add(TrialMoverModes::Traversal, CreateDefaultSubobject<UTrialMoverTraversalMode>(TEXT("TrialTraversalMode")));
+	StartingMovementMode = DefaultModeNames::Walking;
+
+	// Carried from frame to frame (and through rollbacks) like the default transform state
+	PersistentSyncStateDataTypes.Add(FMoverDataPersistence(FTrialMoverSyncState::StaticStruct(), true));
+
+	// Class defaults of the CMC character until ApplyTuning copies the tuning source. Instances only: while
+	// class default objects are being built the character's may not exist yet.
+	if (!HasAnyFlags(RF_ClassDefaultObject))
+	{
+		const ACustomCharacter* Defaults = GetDefault<ACustomCharacter>();
+		if (const UCustomMovementComponent* Move = Cast<UCustomMovementComponent>(Defaults->GetCharacterMovement()))
+		{
+			Tuning.CopyFrom(*Defaults, *Move);
+		}
+	}
+}
+
+void UTrialMoverComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	QueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(TrialMoverTraversal), false, GetOwner());
+
+	if (const UCapsuleComponent* Capsule = Cast<UCapsuleComponent>(GetUpdatedComponent()))
+	{
+		CapsuleRadius = Capsule->GetScaledCapsuleRadius();
+		CapsuleHalfHeight = Capsule->GetScaledCapsuleHalfHeight();
+	}
+}
+
+void UTrialMoverComponent::ApplyTuning(const ACustomCharacter& Source)
+{
+	const UCustomMovementComponent* Move = Cast<UCustomMovementComponent>(Source.GetCharacterMovement());
+	if (!Move)
+	{
+		return;
+	}
+
+	Tuning.CopyFrom(Source, *Move);
+
+	// Walking mode accelerates towards the sprint speed; UTrialMoverWalkingMode caps to the walk speed when not sprinting
+	if (UCommonLegacyMovementSettings* Settings = FindSharedSettings_Mutable<UCommonLegacyMovementSettings>())
+	{
+		Settings->MaxSpeed = Tuning.SprintSpeed;
+		Settings->Acceleration = Move->MaxAcceleration;
+		Settings->Deceleration = Move->BrakingDecelerationWalking;
+		Settings->GroundFriction = Move->GroundFriction;
+		Settings->MaxStepHeight = Move->MaxStepHeight;
+		Settings->MaxWalkSlopeCosine = Move->GetWalkableFloorZ();
+		Settings->JumpUpwardsSpeed = Move->JumpZVelocity;
+	}
+}
+
+const FTrialMoverSyncState* UTrialMoverComponent::GetTrialSyncState() const
+{
+	return GetSyncState().SyncStateCollection.FindDataByType<FTrialMoverSyncState>();
+}
+
+bool UTrialMoverComponent::IsSprinting() const
+{
+	const FTrialMoverSyncState* State = GetTrialSyncState();
+	return State && State->bSprinting;
+}
+
+bool UTrialMoverComponent::IsSliding() const
+{
+	const FTrialMoverSyncState* State = GetTrialSyncState();
+	return State && State->bSliding;
+}
+
+bool UTrialMoverComponent::IsTraversing() const
+{
+	const FTrialMoverSyncState* State = GetTrialSyncState();
+	return State && State->Parkour != EParkourType::None;
+}
+
+float UTrialMoverComponent::GetStamina() const
+{
+	const FTrialMoverSyncState* State = GetTrialSyncState();
+	return State ? State->Stamina : Tuning.StaminaMax;
+}
+
+// --------------------
+// SIMULATION HELPERS
+// --------------------
+
+void UTrialMoverComponent::TickStamina(FTrialMoverSyncState& State, const FTrialMoverInputs* Inputs, bool bOnGround, float DeltaSeconds) const
+{
+	if (DeltaSeconds <= 0.f) return;
+
+	if (!State.bSprinting)
+	{
+		State.TimeSinceSprintEnded += DeltaSeconds;
+	}
+
+	if (State.bSprinting && bOnGround && !State.bSliding)
+	{
+		State.Stamina = FMath::Max(0.f, State.Stamina - Tuning.SprintDrainPerSec * DeltaSeconds);
+	}
+	else if (State.bSliding)
+	{
+		State.Stamina = FMath::Max(0.f, State.Stamina - Tuning.SlideDrainPerSec * DeltaSeconds);
+	}
+	else
+	{
+		State.Stamina = FMath::Min(Tuning.StaminaMax, State.Stamina + Tuning.StaminaRegenPerSec * DeltaSeconds);
+	}
+
+	if (State.bSprinting && State.Stamina < KINDA_SMALL_NUMBER)
+	{
+		State.bSprinting = false;
+		State.TimeSinceSprintEnded = 0.f;
+	}
+
+	const bool bShouldSprint =
+		Inputs && Inputs->bSprintHeld &&
+		!State.bSliding &&
+		State.Parkour == EParkourType::None &&
+		bOnGround &&
+		State.Stamina >= Tuning.MinStaminaToSprint;
+
+	if (bShouldSprint)
+	{
+		State.bSprinting = true;
+	}
+	else if (State.bSprinting)
+	{
+		State.bSprinting = false;
+		State.TimeSinceSprintEnded = 0.f; // opens grace window for slide
+	}
+}
+
+bool UTrialMoverComponent::CanStartSlide(const FTrialMoverSyncState& State, float HorizontalSpeed) const
+{
+	if (State.bSliding) return false;
+	if (State.Stamina < Tuning.MinStaminaToSlide) return false;
+
+	const bool bHasSpeed = HorizontalSpeed >= Tuning.SlideMinStartSpeed;
+	const bool bInGrace = (State.TimeSinceSprintEnded <= Tuning.PostSprintSlideGraceTime) && (HorizontalSpeed >= (Tuning.SlideMinStartSpeed * UCustomMovementComponent::PostSprintSlideGraceSpeedScale));
+
+	return bHasSpeed || bInGrace;
+}
+
+bool UTrialMoverComponent::FindTraversal(const FVector& Location, const FQuat& Orientation, FTrialMoverSyncState& OutState) const
+{
+	PARKOUR_SCOPE(STAT_MoverFindTraversal);
+
+	const UWorld* World = GetWorld();
+	if (!World) return false;
+
+	const FVector Forward = FVector(Orientation.GetForwardVector().X, Orientation.GetForwardVector().Y, 0.f).GetSafeNormal();
+	if (Forward.IsNearlyZero()) return false;
+
+	// Obstacle in front (FindParkourObstacle)
+	const FVector Start = Location + FVector(0, 0, ParkourQueryOffsets::FrontSweepUp);
+	const FVector End = Start + Forward * Tuning.ParkourFrontCheckDistance;
+
+	FHitResult FrontHit;
+	PARKOUR_COUNT(Sweeps);
+	if (!World->SweepSingleByChannel(FrontHit, Start, End, FQuat::Identity, ECC_Visibility, FCollisionShape::MakeSphere(Tuning.ParkourFrontCheckRadius), QueryParams)
+		|| !FrontHit.GetActor())
+	{
+		return false;
+	}
+
+	FTrialParkourObstacleInfo Info;
+	if (!TrialParkourObstacle::Resolve(FrontHit, Info))
+	{
+		return false;
+	}
+
+	FVector TopPoint(FrontHit.ImpactPoint.X, FrontHit.ImpactPoint.Y, Info.TopZ);
+	if (!Info.bHasTop)
+	{
+		FHitResult TopHit;
+		PARKOUR_COUNT(LineTraces);
+		if (!World->LineTraceSingleByChannel(TopHit, FrontHit.ImpactPoint + FVector(0, 0, Tuning.ParkourTopTraceHeight), FrontHit.ImpactPoint - FVector(0, 0, Tuning.ParkourTopTraceHeight), ECC_Visibility, QueryParams))
+		{
+			return false;
+		}
+		TopPoint = TopHit.ImpactPoint;
+	}
+
+	// DecideParkourType
+	const float ObstacleHeight = TopPoint.Z - Location.Z;
+	const EParkourType Type = ObstacleHeight <= Tuning.VaultMaxObstacleHeight ? (Info.bAllowVault ? EParkourType::Vault : EParkourType::None)
+		: (ObstacleHeight <= Tuning.MantleMaxObstacleHeight && Info.bAllowMantle ? EParkourType::Mantle : EParkourType::None);
+	if (Type == EParkourType::None) return false;
+
+	const FCollisionShape FitShape = FCollisionShape::MakeCapsule(CapsuleRadius + Tuning.ParkourLandingCapsuleInflate, CapsuleHalfHeight);
+	auto Fits = [World, &FitShape, this](const FVector& At)
+	{
+		FHitResult Hit;
+		PARKOUR_COUNT(Sweeps);
+		return !World->SweepSingleByChannel(Hit, At, At, FQuat::Identity, ECC_WorldStatic, FitShape, QueryParams);
+	};
+
+	// Landing (ComputeSafeParkourLanding): ground under the far side, capsule fit, one forward fallback
+	const FVector Desired = TopPoint + Forward * (CapsuleRadius + Tuning.ParkourLandForwardOffset + Tuning.ParkourLandingForwardExtra);
+
+	FHitResult GroundHit;
+	PARKOUR_COUNT(LineTraces);
+	if (!World->LineTraceSingleByChannel(GroundHit, Desired + FVector(0, 0, 250.f), Desired - FVector(0, 0, 600.f), ECC_Visibility, QueryParams))
+	{
+		return false;
+	}
+
+	FVector Target = GroundHit.ImpactPoint;
+	Target.Z += CapsuleHalfHeight + Tuning.ParkourLandUpOffset;
+	if (!Fits(Target))
+	{
+		PARKOUR_COUNT(Fallbacks);
+		Target += Forward * (CapsuleRadius * ParkourQueryOffsets::LandingFallbackRadiusScale);
+		if (!Fits(Target)) return false;
+	}
+
+	// Apex (ComputeParkourApex_*): vault never fit-tests, mantle raises once if blocked
+	FVector Apex = TopPoint + Forward * (CapsuleRadius + Tuning.ApexForwardExtra);
+	Apex.Z = TopPoint.Z + CapsuleHalfHeight + Tuning.ApexUpExtra;
+	if (Type == EParkourType::Mantle && !Fits(Apex))
+	{
+		PARKOUR_COUNT(Fallbacks);
+		Apex.Z += ParkourQueryOffsets::RetryUp;
+		if (!Fits(Apex)) return false;
+	}
+
+	OutState.Parkour = Type;
+	OutState.Phase = EParkourPhase::ToApex;
+	OutState.PhaseElapsed = 0.f;
+	OutState.ParkourStart = Location;
+	OutState.ParkourApex = Apex;
+	OutState.ParkourTarget = Target;
+	OutState.bSprinting = false;
+	OutState.bSliding = false;
+	return true;
+}
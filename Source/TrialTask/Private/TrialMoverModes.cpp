@@ -0,0 +1,387 @@
+#include "TrialMoverModes.h"
+
+#include "ParkourStats.h"
+#include "TrialMoverComponent.h"
+
+#include "DefaultMovementSet/Settings/CommonLegacyMovementSettings.h"
+#include "MoveLibrary/FloorQueryUtils.h"
+#include "MoveLibrary/MovementUtils.h"
+#include "MoverDataModelTypes.h"
+#include "MoverSimulationTypes.h"
+
+DECLARE_CYCLE_STAT(TEXT("MoverWalkingTick"), STAT_MoverWalkingTick, STATGROUP_Parkour);
+DECLARE_CYCLE_STAT(TEXT("MoverSlideTick"), STAT_MoverSlideTick, STATGROUP_Parkour);
+DECLARE_CYCLE_STAT(TEXT("MoverTraversalTick"), STAT_MoverTraversalTick, STATGROUP_Parkour);
+
+namespace
+{
+	// Output copy of the Trial state; the persistent-data copy normally already added it
+	FTrialMoverSyncState& GetOutputTrialState(const FSimulationTickParams& Params, FMoverTickEndData& OutputState)
+	{
+		if (FTrialMoverSyncState* Existing = OutputState.SyncState.SyncStateCollection.FindMutableDataByType<FTrialMoverSyncState>())
+		{
+			return *Existing;
+		}
+
+		FTrialMoverSyncState& Added = OutputState.SyncState.SyncStateCollection.FindOrAddMutableDataByType<FTrialMoverSyncState>();
+		if (const FTrialMoverSyncState* Prior = Params.StartState.SyncState.SyncStateCollection.FindDataByType<FTrialMoverSyncState>())
+		{
+			Added = *Prior;
+		}
+		return Added;
+	}
+
+	const FTrialMoverInputs* GetTrialInputs(const FMoverTickStartData& StartState)
+	{
+		return StartState.InputCmd.InputCollection.FindDataByType<FTrialMoverInputs>();
+	}
+}
+
+// --------------------
+// WALKING / SPRINT
+// --------------------
+
+void UTrialMoverWalkingMode::GenerateMove_Implementation(const FMoverTickStartData& StartState, const FMoverTimeStep& TimeStep, FProposedMove& OutProposedMove) const
+{
+	Super::GenerateMove_Implementation(StartState, TimeStep, OutProposedMove);
+
+	const FTrialMoverSyncState* Trial = StartState.SyncState.SyncStateCollection.FindDataByType<FTrialMoverSyncState>();
+	const UTrialMoverComponent* Mover = GetMoverComponent<UTrialMoverComponent>();
+	if (!Mover || (Trial && Trial->bSprinting))
+	{
+		return;
+	}
+
+	// Not sprinting: brake down to the walk speed instead of snapping (CMC braking when over MaxWalkSpeed)
+	const FTrialMoverTuning& Tuning = Mover->GetTuning();
+	const FVector Velocity = OutProposedMove.LinearVelocity;
+	const FVector Horizontal(Velocity.X, Velocity.Y, 0.f);
+	const float Speed = Horizontal.Size();
+
+	if (Speed > Tuning.WalkSpeed)
+	{
+		const float Cap = FMath::Max(Tuning.WalkSpeed, Speed - Tuning.BrakingDecelerationWalking * TimeStep.StepMs * 0.001f);
+		OutProposedMove.LinearVelocity = Horizontal * (Cap / Speed) + FVector(0.f, 0.f, Velocity.Z);
+	}
+}
+
+void UTrialMoverWalkingMode::SimulationTick_Implementation(const FSimulationTickParams& Params, FMoverTickEndData& OutputState)
+{
+	PARKOUR_SCOPE(STAT_MoverWalkingTick);
+
+	Super::SimulationTick_Implementation(Params, OutputState);
+
+	const UTrialMoverComponent* Mover = GetMoverComponent<UTrialMoverComponent>();
+	if (!Mover) return;
+
+	const FTrialMoverInputs* Inputs = GetTrialInputs(Params.StartState);
+	FTrialMoverSyncState& Trial = GetOutputTrialState(Params, OutputState);
+
+	const FName NextMode = OutputState.MovementEndState.NextModeName;
+	const bool bStillWalking = NextMode.IsNone() || NextMode == DefaultModeNames::Walking;
+
+	Mover->TickStamina(Trial, Inputs, bStillWalking, Params.TimeStep.StepMs * 0.001f);
+
+	const FMoverDefaultSyncState* Sync = OutputState.SyncState.SyncStateCollection.FindDataByType<FMoverDefaultSyncState>();
+	if (!bStillWalking || !Inputs || !Sync)
+	{
+		return;
+	}
+
+	// ParkourPressed: detection runs inside the sim so it is predicted and replayed with the move
+	if (Inputs->bParkourJustPressed && Mover->FindTraversal(Sync->GetLocation_WorldSpace(), Sync->GetOrientation_WorldSpace().Quaternion(), Trial))
+	{
+		OutputState.MovementEndState.NextModeName = TrialMoverModes::Traversal;
+		return;
+	}
+
+	// CrouchPressed -> StartSlide
+	if (Inputs->bCrouchJustPressed && Mover->CanStartSlide(Trial, Sync->GetVelocity_WorldSpace().Size2D()))
+	{
+		Trial.bSliding = true;
+		OutputState.MovementEndState.NextModeName = TrialMoverModes::Slide;
+	}
+}
+
+// --------------------
+// FALLING
+// --------------------
+
+void UTrialMoverFallingMode::SimulationTick_Implementation(const FSimulationTickParams& Params, FMoverTickEndData& OutputState)
+{
+	Super::SimulationTick_Implementation(Params, OutputState);
+
+	if (const UTrialMoverComponent* Mover = GetMoverComponent<UTrialMoverComponent>())
+	{
+		Mover->TickStamina(GetOutputTrialState(Params, OutputState), GetTrialInputs(Params.StartState), false, Params.TimeStep.StepMs * 0.001f);
+	}
+}
+
+// --------------------
+// SLIDE
+// --------------------
+
+UTrialMoverSlideMode::UTrialMoverSlideMode()
+{
+	SharedSettingsClasses.Add(UCommonLegacyMovementSettings::StaticClass());
+}
+
+void UTrialMoverSlideMode::GenerateMove_Implementation(const FMoverTickStartData& StartState, const FMoverTimeStep& TimeStep, FProposedMove& OutProposedMove) const
+{
+	const UTrialMoverComponent* Mover = GetMoverComponent<UTrialMoverComponent>();
+	const FMoverDefaultSyncState* Sync = StartState.SyncState.SyncStateCollection.FindDataByType<FMoverDefaultSyncState>();
+	if (!Mover || !Sync)
+	{
+		return;
+	}
+
+	const FTrialMoverTuning& Tuning = Mover->GetTuning();
+	const float DeltaTime = TimeStep.StepMs * 0.001f;
+
+	// Floor from the end of the previous step (same position this step starts from)
+	FVector FloorNormal = FVector::UpVector;
+	FFloorCheckResult Floor;
+	const UMoverBlackboard* Blackboard = Mover->GetSimBlackboard();
+	if (Blackboard && Blackboard->TryGet(CommonBlackboard::LastFloorResult, Floor) && Floor.IsWalkableFloor())
+	{
+		FloorNormal = Floor.HitResult.ImpactNormal.GetSafeNormal();
+	}
+
+	// From here on this is UCustomMovementComponent::PhysSlide
+	const float CosSlope = FVector::DotProduct(FloorNormal, FVector::UpVector);
+	const float SlopeRad = FMath::Acos(FMath::Clamp(CosSlope, -1.f, 1.f));
+	const bool bIsOnSlope = FMath::RadiansToDegrees(SlopeRad) >= Tuning.SlideSlopeAngleMinDeg;
+
+	const FVector GravityDir(0.f, 0.f, -1.f);
+	const FVector Downhill = (GravityDir - FVector::DotProduct(GravityDir, FloorNormal) * FloorNormal).GetSafeNormal();
+
+	FVector Velocity = FVector::VectorPlaneProject(Sync->GetVelocity_WorldSpace(), FloorNormal);
+	const FVector VelDir = Velocity.GetSafeNormal();
+	const float AlongDownhill = FVector::DotProduct(VelDir, Downhill);
+
+	FVector Input = FVector::ZeroVector;
+	if (const FCharacterDefaultInputs* CharacterInputs = StartState.InputCmd.InputCollection.FindDataByType<FCharacterDefaultInputs>())
+	{
+		Input = FVector::VectorPlaneProject(CharacterInputs->GetMoveInput(), FloorNormal);
+	}
+	const FVector InputDir = Input.GetSafeNormal();
+
+	FVector Accel = FVector::ZeroVector;
+	if (!InputDir.IsNearlyZero())
+	{
+		Accel += InputDir * Tuning.SlideSteerAccel;
+	}
+
+	if (bIsOnSlope && !Downhill.IsNearlyZero())
+	{
+		const float SlopeStrength = FMath::Clamp(FMath::Sin(SlopeRad), 0.f, 1.f);
+		Accel += Downhill * (Tuning.SlideDownhillAccel * SlopeStrength);
+
+		if (AlongDownhill < -0.05f)
+		{
+			Accel += (-VelDir) * Tuning.SlideUphillDecel;
+		}
+	}
+	else
+	{
+		Accel += (-VelDir) * Tuning.SlideFlatDecel;
+	}
+
+	Velocity += Accel * DeltaTime;
+	Velocity = FVector::VectorPlaneProject(Velocity, FloorNormal);
+
+	const float MaxSpeed = bIsOnSlope ? Tuning.SlideMaxSpeedDownhill : Tuning.SlideMaxSpeedFlat;
+	if (Velocity.SizeSquared() > FMath::Square(MaxSpeed))
+	{
+		Velocity = Velocity.GetSafeNormal() * MaxSpeed;
+	}
+
+	OutProposedMove.LinearVelocity = Velocity;
+}
+
+void UTrialMoverSlideMode::SimulationTick_Implementation(const FSimulationTickParams& Params, FMoverTickEndData& OutputState)
+{
+	PARKOUR_SCOPE(STAT_MoverSlideTick);
+
+	const UTrialMoverComponent* Mover = GetMoverComponent<UTrialMoverComponent>();
+	USceneComponent* UpdatedComponent = Params.MovingComps.UpdatedComponent.Get();
+	const FMoverDefaultSyncState* StartSync = Params.StartState.SyncState.SyncStateCollection.FindDataByType<FMoverDefaultSyncState>();
+	if (!Mover || !UpdatedComponent || !StartSync)
+	{
+		return;
+	}
+
+	const FTrialMoverTuning& Tuning = Mover->GetTuning();
+	const FTrialMoverInputs* Inputs = GetTrialInputs(Params.StartState);
+	const float DeltaTime = Params.TimeStep.StepMs * 0.001f;
+
+	FTrialMoverSyncState& Trial = GetOutputTrialState(Params, OutputState);
+	FMoverDefaultSyncState& OutSync = OutputState.SyncState.SyncStateCollection.FindOrAddMutableDataByType<FMoverDefaultSyncState>();
+	OutputState.MovementEndState.RemainingMs = 0.f;
+
+	FVector Velocity = Params.ProposedMove.LinearVelocity;
+
+	// CrouchReleased -> StopSlide, or too slow to keep sliding
+	if (!Inputs || !Inputs->bCrouchHeld || Velocity.Size() < Tuning.SlideMinSpeedToKeep)
+	{
+		Trial.bSliding = false;
+		OutputState.MovementEndState.NextModeName = DefaultModeNames::Walking;
+		OutSync.SetTransforms_WorldSpace(StartSync->GetLocation_WorldSpace(), StartSync->GetOrientation_WorldSpace(), Velocity, nullptr);
+		Mover->TickStamina(Trial, Inputs, true, DeltaTime);
+		return;
+	}
+
+	const FQuat Rotation = UpdatedComponent->GetComponentQuat();
+	const FVector Delta = Velocity * DeltaTime;
+
+	FMovementRecord MoveRecord;
+	MoveRecord.SetDeltaSeconds(DeltaTime);
+
+	FHitResult Hit(1.f);
+	PARKOUR_COUNT(Sweeps);
+	UMovementUtils::TrySafeMoveUpdatedComponent(Params.MovingComps, Delta, Rotation, true, Hit, ETeleportType::None, MoveRecord);
+
+	if (Hit.IsValidBlockingHit())
+	{
+		// Slides along blocking surface
+		PARKOUR_COUNT(Fallbacks);
+		const FVector SlideDelta = FVector::VectorPlaneProject(Delta, Hit.Normal) * (1.f - Hit.Time);
+		FHitResult SlideHit(1.f);
+		UMovementUtils::TrySafeMoveUpdatedComponent(Params.MovingComps, SlideDelta, Rotation, true, SlideHit, ETeleportType::None, MoveRecord);
+
+		Velocity = FVector::VectorPlaneProject(Velocity, Hit.Normal);
+	}
+
+	// One floor query per step; the next GenerateMove reads it from the blackboard
+	const UCommonLegacyMovementSettings* Settings = Mover->FindSharedSettings<UCommonLegacyMovementSettings>();
+	FFloorCheckResult Floor;
+	PARKOUR_COUNT(FindFloors);
+	UFloorQueryUtils::FindFloor(Params.MovingComps, Settings ? Settings->FloorSweepDistance : 40.f, Settings ? Settings->MaxWalkSlopeCosine : 0.71f, UpdatedComponent->GetComponentLocation(), Floor);
+
+	if (Params.SimBlackboard)
+	{
+		Params.SimBlackboard->Set(CommonBlackboard::LastFloorResult, Floor);
+	}
+
+	if (!Floor.IsWalkableFloor())
+	{
+		// If ground is lost, ends slide and falls
+		Trial.bSliding = false;
+		OutputState.MovementEndState.NextModeName = DefaultModeNames::Falling;
+	}
+
+	OutSync.SetTransforms_WorldSpace(UpdatedComponent->GetComponentLocation(), UpdatedComponent->GetComponentRotation(), Velocity, nullptr);
+	Mover->TickStamina(Trial, Inputs, Floor.IsWalkableFloor(), DeltaTime);
+}
+
+// --------------------
+// VAULT / MANTLE
+// --------------------
+
+void UTrialMoverTraversalMode::GenerateMove_Implementation(const FMoverTickStartData& StartState, const FMoverTimeStep& TimeStep, FProposedMove& OutProposedMove) const
+{
+	const UTrialMoverComponent* Mover = GetMoverComponent<UTrialMoverComponent>();
+	const FTrialMoverSyncState* Trial = StartState.SyncState.SyncStateCollection.FindDataByType<FTrialMoverSyncState>();
+	const FMoverDefaultSyncState* Sync = StartState.SyncState.SyncStateCollection.FindDataByType<FMoverDefaultSyncState>();
+	if (!Mover || !Trial || !Sync || Trial->Parkour == EParkourType::None)
+	{
+		return;
+	}
+
+	// Velocity that reaches the end of the current phase on time (layered moves and animation read it)
+	const float Duration = FMath::Max(0.01f, Mover->GetTuning().GetPhaseDuration(Trial->Parkour, Trial->Phase));
+	const FVector PhaseEnd = Trial->Phase == EParkourPhase::ToApex ? Trial->ParkourApex : Trial->ParkourTarget;
+	const float TimeLeft = FMath::Max(Duration - Trial->PhaseElapsed, TimeStep.StepMs * 0.001f);
+
+	OutProposedMove.LinearVelocity = (PhaseEnd - Sync->GetLocation_WorldSpace()) / TimeLeft;
+}
+
+void UTrialMoverTraversalMode::SimulationTick_Implementation(const FSimulationTickParams& Params, FMoverTickEndData& OutputState)
+{
+	PARKOUR_SCOPE(STAT_MoverTraversalTick);
+
+	const UTrialMoverComponent* Mover = GetMoverComponent<UTrialMoverComponent>();
+	USceneComponent* UpdatedComponent = Params.MovingComps.UpdatedComponent.Get();
+	if (!Mover || !UpdatedComponent)
+	{
+		return;
+	}
+
+	const float DeltaTime = Params.TimeStep.StepMs * 0.001f;
+
+	FTrialMoverSyncState& Trial = GetOutputTrialState(Params, OutputState);
+	FMoverDefaultSyncState& OutSync = OutputState.SyncState.SyncStateCollection.FindOrAddMutableDataByType<FMoverDefaultSyncState>();
+	OutputState.MovementEndState.RemainingMs = 0.f;
+
+	auto EndTraversal = [&Trial, &OutputState]()
+	{
+		Trial.Parkour = EParkourType::None;
+		Trial.Phase = EParkourPhase::None;
+		Trial.PhaseElapsed = 0.f;
+		OutputState.MovementEndState.NextModeName = DefaultModeNames::Walking;
+	};
+
+	if (Trial.Parkour == EParkourType::None)
+	{
+		EndTraversal();
+		return;
+	}
+
+	// ParkourMoveStep: lerp along the current leg, swept
+	const float Duration = FMath::Max(0.01f, Mover->GetTuning().GetPhaseDuration(Trial.Parkour, Trial.Phase));
+	const bool bToApex = Trial.Phase == EParkourPhase::ToApex;
+	const FVector From = bToApex ? Trial.ParkourStart : Trial.ParkourApex;
+	const FVector To = bToApex ? Trial.ParkourApex : Trial.ParkourTarget;
+
+	Trial.PhaseElapsed += DeltaTime;
+	const float Alpha = FMath::Clamp(Trial.PhaseElapsed / Duration, 0.f, 1.f);
+
+	const FVector Current = UpdatedComponent->GetComponentLocation();
+	const FVector Delta = FMath::Lerp(From, To, Alpha) - Current;
+	const FQuat Rotation = UpdatedComponent->GetComponentQuat();
+
+	FMovementRecord MoveRecord;
+	MoveRecord.SetDeltaSeconds(DeltaTime);
+
+	FHitResult Hit(1.f);
+	PARKOUR_COUNT(Sweeps);
+	UMovementUtils::TrySafeMoveUpdatedComponent(Params.MovingComps, Delta, Rotation, true, Hit, ETeleportType::None, MoveRecord);
+
+	bool bBlocked = false;
+	if (Hit.IsValidBlockingHit() && Hit.Time < 1.f - KINDA_SMALL_NUMBER)
+	{
+		PARKOUR_COUNT(Fallbacks);
+		const FVector SlideDelta = FVector::VectorPlaneProject(Delta, Hit.Normal) * (1.f - Hit.Time);
+		FHitResult SlideHit(1.f);
+		PARKOUR_COUNT(Sweeps);
+		UMovementUtils::TrySafeMoveUpdatedComponent(Params.MovingComps, SlideDelta, Rotation, true, SlideHit, ETeleportType::None, MoveRecord);
+		bBlocked = Hit.Time < 0.03f && SlideHit.IsValidBlockingHit() && SlideHit.Time < 0.03f;
+	}
+
+	if (bBlocked)
+	{
+		// Recovery: the landing was fit-tested at detection, place the capsule there
+		PARKOUR_COUNT(Fallbacks);
+		UMovementUtils::TrySafeMoveUpdatedComponent(Params.MovingComps, Trial.ParkourTarget - UpdatedComponent->GetComponentLocation(), Rotation, false, Hit, ETeleportType::TeleportPhysics, MoveRecord);
+		EndTraversal();
+	}
+	else if (Alpha >= 1.f)
+	{
+		if (bToApex)
+		{
+			Trial.Phase = EParkourPhase::ToTarget;
+			Trial.PhaseElapsed = 0.f;
+		}
+		else
+		{
+			EndTraversal();
+		}
+	}
+
+	// Landing carries no velocity (EndParkour restores walking from rest)
+	const bool bEnded = Trial.Parkour == EParkourType::None;
+	const FVector Velocity = bEnded ? FVector::ZeroVector : (UpdatedComponent->GetComponentLocation() - Current) / FMath::Max(DeltaTime, KINDA_SMALL_NUMBER);
+
+	OutSync.SetTransforms_WorldSpace(UpdatedComponent->GetComponentLocation(), UpdatedComponent->GetComponentRotation(), Velocity, nullptr);
+	Mover->TickStamina(Trial, GetTrialInputs(Params.StartState), false, DeltaTime);
+}
@@ -0,0 +1,311 @@
+#include "TrialParkourObstacle.h"
+
+#include "TrialTaskLLM.h"
+
+#include "Components/StaticMeshComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace TrialParkourObstacle
+{
+	const FName Tag(TEXT("Parkourable"));
+	const FName NoVaultTag(TEXT("ParkourNoVault"));
+	const FName NoMantleTag(TEXT("ParkourNoMantle"));
+
+	bool Resolve(const FHitResult& Hit, FTrialParkourObstacleInfo& OutInfo)
+	{
+		OutInfo = FTrialParkourObstacleInfo();
+
+		if (const UTrialParkourObstacleComponent* Instanced = Cast<UTrialParkourObstacleComponent>(Hit.GetComponent()))
+		{
+			return Instanced->GetObstacleInfo(Hit.Item, OutInfo);
+		}
+
+		const AActor* Actor = Hit.GetActor();
+		if (!Actor || !Actor->ActorHasTag(Tag))
+		{
+			return false;
+		}
+
+		OutInfo.bAllowVault = !Actor->ActorHasTag(NoVaultTag);
+		OutInfo.bAllowMantle = !Actor->ActorHasTag(NoMantleTag);
+		return true;
+	}
+}
+
+// --------------------
+// COMPONENT
+// --------------------
+
+UTrialParkourObstacleComponent::UTrialParkourObstacleComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	NumCustomDataFloats = NumTraversalCustomData;
+	SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+}
+
+void UTrialParkourObstacleComponent::OnRegister()
+{
+	// Instances authored with fewer floats would read another instance's data
+	if (NumCustomDataFloats < NumTraversalCustomData)
+	{
+		SetNumCustomDataFloats(NumTraversalCustomData);
+	}
+
+	Super::OnRegister();
+}
+
+int32 UTrialParkourObstacleComponent::AddObstacle(const FTransform& Transform, bool bWorldSpace, float TopHeight, bool bAllowVault, bool bAllowMantle)
+{
+	const int32 Index = AddInstance(Transform, bWorldSpace);
+	if (Index != INDEX_NONE)
+	{
+		SetObstacleTraversal(Index, TopHeight, bAllowVault, bAllowMantle);
+	}
+	return Index;
+}
+
+void UTrialParkourObstacleComponent::SetObstacleTraversal(int32 InstanceIndex, float TopHeight, bool bAllowVault, bool bAllowMantle)
+{
+	FTransform Instance;
+	if (!GetInstanceTransform(InstanceIndex, Instance, true))
+	{
+		return;
+	}
+
+	// Stored in mesh space so rescaling an instance keeps its top on the mesh
+	const float ScaleZ = Instance.GetScale3D().Z;
+	const float LocalTop = (TopHeight > 0.f && !FMath::IsNearlyZero(ScaleZ)) ? TopHeight / ScaleZ : 0.f;
+	const int32 Flags = (bAllowVault ? 0 : FlagNoVault) | (bAllowMantle ? 0 : FlagNoMantle);
+
+	SetCustomDataValue(InstanceIndex, CustomDataTopHeight, LocalTop, false);
+	SetCustomDataValue(InstanceIndex, CustomDataFlags, (float)Flags, true);
+}
+
+bool UTrialParkourObstacleComponent::GetObstacleInfo(int32 InstanceIndex, FTrialParkourObstacleInfo& OutInfo) const
+{
+	FTransform Instance;
+	if (!GetInstanceTransform(InstanceIndex, Instance, true))
+	{
+		return false;
+	}
+
+	float LocalTop = 0.f;
+	int32 Flags = 0;
+	const int32 Base = InstanceIndex * NumCustomDataFloats;
+	if (NumCustomDataFloats >= NumTraversalCustomData && PerInstanceSMCustomData.IsValidIndex(Base + CustomDataFlags))
+	{
+		LocalTop = PerInstanceSMCustomData[Base + CustomDataTopHeight];
+		Flags = FMath::RoundToInt(PerInstanceSMCustomData[Base + CustomDataFlags]);
+	}
+
+	if (LocalTop <= 0.f)
+	{
+		const UStaticMesh* Mesh = GetStaticMesh();
+		LocalTop = Mesh ? Mesh->GetBounds().GetBox().Max.Z : 0.f;
+	}
+
+	OutInfo.bHasTop = LocalTop > 0.f;
+	OutInfo.TopZ = Instance.GetLocation().Z + LocalTop * Instance.GetScale3D().Z;
+	OutInfo.bAllowVault = (Flags & FlagNoVault) == 0;
+	OutInfo.bAllowMantle = (Flags & FlagNoMantle) == 0;
+	return true;
+}
+
+bool UTrialParkourObstacleComponent::IsPointOnObstacle(const FVector& Point, float Slack) const
+{
+	const UStaticMesh* Mesh = GetStaticMesh();
+	if (!Mesh) return false;
+
+	const FBox LocalBox = Mesh->GetBounds().GetBox();
+	const FBox Query(Point - FVector(Slack), Point + FVector(Slack));
+
+	for (const int32 Index : GetInstancesOverlappingBox(Query, true))
+	{
+		FTransform Instance;
+		if (GetInstanceTransform(Index, Instance, true) && LocalBox.TransformBy(Instance).ExpandBy(Slack).IsInside(Point))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+// --------------------
+// FIELD
+// --------------------
+
+ATrialParkourObstacleField::ATrialParkourObstacleField(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	Obstacles = CreateDefaultSubobject<UTrialParkourObstacleComponent>(TEXT("Obstacles"));
+	RootComponent = Obstacles;
+
+	Tags.Add(TrialParkourObstacle::Tag);
+}
+
+// --------------------
+// CONSOLE
+// --------------------
+
+namespace TrialParkourObstacleCompare
+{
+	static const TCHAR* DefaultActorClass = TEXT("/Game/Assets/World/BP_Parkourable.BP_Parkourable_C");
+
+	struct FSnapshot
+	{
+		int32 Objects = 0;
+		uint64 UsedPhysical = 0;
+		double Seconds = 0.0;
+
+		static FSnapshot Take()
+		{
+			FSnapshot S;
+			S.Objects = GUObjectArray.GetObjectArrayNumMinusAvailable();
+			S.UsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+			S.Seconds = FPlatformTime::Seconds();
+			return S;
+		}
+	};
+
+	static int64 ActorBytes(const AActor* Actor, int32& InOutPrimitives)
+	{
+		int64 Bytes = (int64)Actor->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+		TInlineComponentArray<UActorComponent*> Components(Actor);
+		for (const UActorComponent* Comp : Components)
+		{
+			Bytes += (int64)Comp->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+			InOutPrimitives += Comp->IsA<UPrimitiveComponent>() ? 1 : 0;
+		}
+		return Bytes;
+	}
+
+	static void Log(const TCHAR* Mode, int32 Count, const FSnapshot& Before, const FSnapshot& After, int32 Primitives, int64 Bytes)
+	{
+		UE_LOG(LogTemp, Display, TEXT("OBSTACLES,Mode=%s,Count=%d,SpawnMs=%.1f,UObjects=%d,Primitives=%d,ResourceKB=%.1f,PhysicalDeltaMB=%.1f"),
+			Mode, Count, (After.Seconds - Before.Seconds) * 1000.0, After.Objects - Before.Objects, Primitives,
+			Bytes / 1024.0, ((int64)After.UsedPhysical - (int64)Before.UsedPhysical) / (1024.0 * 1024.0));
+	}
+
+	// Same grid, same mesh: Count tagged actors vs one field with Count instances. Runs far above the map and cleans up.
+	static void Run(UWorld* World, UClass* ActorClass, int32 Count)
+	{
+		LLM_SCOPE_BYTAG(TrialTask);
+
+		const int32 Side = FMath::CeilToInt(FMath::Sqrt((float)Count));
+		auto GridTransform = [Side](int32 i)
+		{
+			return FTransform(FVector((i % Side) * 400.0, (i / Side) * 400.0, 100000.0));
+		};
+
+		FActorSpawnParameters Params;
+		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		// The instanced field uses the mesh of the legacy actor
+		UStaticMesh* Mesh = nullptr;
+		FTransform MeshRelative = FTransform::Identity;
+		if (AActor* Probe = World->SpawnActor<AActor>(ActorClass, GridTransform(0), Params))
+		{
+			if (const UStaticMeshComponent* MeshComp = Probe->FindComponentByClass<UStaticMeshComponent>())
+			{
+				Mesh = MeshComp->GetStaticMesh();
+				MeshRelative = MeshComp->GetRelativeTransform();
+			}
+			Probe->Destroy();
+		}
+		if (!Mesh)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("OBSTACLES: %s has no static mesh component"), *ActorClass->GetName());
+			return;
+		}
+
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+
+		// Actors
+		{
+			TArray<AActor*> Actors;
+			Actors.Reserve(Count);
+
+			const FSnapshot Before = FSnapshot::Take();
+			for (int32 i = 0; i < Count; ++i)
+			{
+				if (AActor* Actor = World->SpawnActor<AActor>(ActorClass, GridTransform(i), Params))
+				{
+					Actors.Add(Actor);
+				}
+			}
+			const FSnapshot After = FSnapshot::Take();
+
+			int32 Primitives = 0;
+			int64 Bytes = 0;
+			for (const AActor* Actor : Actors)
+			{
+				Bytes += ActorBytes(Actor, Primitives);
+			}
+			Log(TEXT("Actors"), Actors.Num(), Before, After, Primitives, Bytes);
+
+			for (AActor* Actor : Actors)
+			{
+				Actor->Destroy();
+			}
+		}
+
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+
+		// Instances
+		{
+			const FSnapshot Before = FSnapshot::Take();
+			ATrialParkourObstacleField* Field = World->SpawnActor<ATrialParkourObstacleField>(ATrialParkourObstacleField::StaticClass(), FTransform::Identity, Params);
+			if (Field)
+			{
+				UTrialParkourObstacleComponent* Obstacles = Field->GetObstacles();
+				Obstacles->SetStaticMesh(Mesh);
+
+				TArray<FTransform> Transforms;
+				Transforms.Reserve(Count);
+				for (int32 i = 0; i < Count; ++i)
+				{
+					Transforms.Add(MeshRelative * GridTransform(i));
+				}
+				// Zeroed custom data = mesh top, vault and mantle allowed
+				Obstacles->AddInstances(Transforms, false, true);
+			}
+			const FSnapshot After = FSnapshot::Take();
+
+			if (Field)
+			{
+				int32 Primitives = 0;
+				const int64 Bytes = ActorBytes(Field, Primitives);
+				Log(TEXT("Instanced"), Field->GetObstacles()->GetInstanceCount(), Before, After, Primitives, Bytes);
+				Field->Destroy();
+			}
+		}
+
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CmdTrialParkourObstacleCompare(
+	TEXT("Trial.Parkour.ObstacleCompare"),
+	TEXT("Trial.Parkour.ObstacleCompare [Count=10000] [ActorClass]. Spawns Count tagged obstacle actors, then one instanced field of Count; logs OBSTACLES lines (objects, primitives, resource size, memory, spawn time)."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World) return;
+
+		const int32 Count = FMath::Max(1, Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 10000);
+		UClass* ActorClass = FSoftClassPath(Args.Num() > 1 ? Args[1] : FString(TrialParkourObstacleCompare::DefaultActorClass)).TryLoadClass<AActor>();
+		if (!ActorClass)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("OBSTACLES: obstacle actor class not found"));
+			return;
+		}
+
+		TrialParkourObstacleCompare::Run(World, ActorClass, Count);
+	}));
@@ -0,0 +1,320 @@
+#include "TrialPredictiveStreaming.h"
+
+#include "CustomCharacter.h"
+#include "CustomMovementComponent.h"
+#include "ParkourStats.h"
+#include "TrialTaskLLM.h"
+
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "WorldPartition/WorldPartitionSubsystem.h"
+
+static TAutoConsoleVariable<int32> CVarTrialStreamingPredictive(
+	TEXT("Trial.Streaming.Predictive"),
+	1,
+	TEXT("Adds a streaming source ahead of fast player pawns (0 = player controller sources only; late-streaming probes keep running)."));
+
+static TAutoConsoleVariable<float> CVarTrialStreamingLookahead(
+	TEXT("Trial.Streaming.Lookahead"),
+	1.5f,
+	TEXT("Seconds of predicted movement the extra streaming source covers."));
+
+static TAutoConsoleVariable<float> CVarTrialStreamingMaxLead(
+	TEXT("Trial.Streaming.MaxLead"),
+	6000.0f,
+	TEXT("Cap on how far ahead of the pawn the source reaches."));
+
+static TAutoConsoleVariable<float> CVarTrialStreamingMinSpeed(
+	TEXT("Trial.Streaming.MinSpeed"),
+	500.0f,
+	TEXT("Below this speed a pawn has no extra streaming source."));
+
+static TAutoConsoleVariable<float> CVarTrialStreamingShapeScale(
+	TEXT("Trial.Streaming.ShapeScale"),
+	0.5f,
+	TEXT("Radius of each shape along the predicted path, as a fraction of the grid loading range."));
+
+static TAutoConsoleVariable<float> CVarTrialStreamingProbeRadius(
+	TEXT("Trial.Streaming.ProbeRadius"),
+	400.0f,
+	TEXT("Ground around a player pawn that must be activated; anything less counts as late streaming."));
+
+namespace TrialPredictiveStreaming
+{
+	constexpr int32 MaxShapes = 6;
+	constexpr int32 SlideFloorQueryBudget = 4;
+	constexpr float ProbeInterval = 0.1f;
+}
+
+// --------------------
+// STATS
+// --------------------
+
+uint64 FTrialStreamingStats::Probes = 0;
+uint64 FTrialStreamingStats::LateProbes = 0;
+uint32 FTrialStreamingStats::LateEvents = 0;
+double FTrialStreamingStats::LateSeconds = 0.0;
+float FTrialStreamingStats::MaxLateSpeed = 0.f;
+
+void FTrialStreamingStats::Report()
+{
+	UE_LOG(LogTemp, Display, TEXT("STREAMING,Predictive=%d,Probes=%llu,LateProbes=%llu,LateEvents=%u,LateSeconds=%.2f,MaxLateSpeed=%.0f"),
+		CVarTrialStreamingPredictive.GetValueOnGameThread(), Probes, LateProbes, LateEvents, LateSeconds, MaxLateSpeed);
+}
+
+void FTrialStreamingStats::Reset()
+{
+	Probes = 0;
+	LateProbes = 0;
+	LateEvents = 0;
+	LateSeconds = 0.0;
+	MaxLateSpeed = 0.f;
+}
+
+static FAutoConsoleCommand CmdTrialStreamingReport(
+	TEXT("Trial.Streaming.Report"),
+	TEXT("Logs a STREAMING line: probes of the ground around player pawns, how many found it not yet activated, late events and time, top speed when late."),
+	FConsoleCommandDelegate::CreateStatic(&FTrialStreamingStats::Report));
+
+static FAutoConsoleCommand CmdTrialStreamingReset(
+	TEXT("Trial.Streaming.Reset"),
+	TEXT("Clears the late-streaming counters."),
+	FConsoleCommandDelegate::CreateStatic(&FTrialStreamingStats::Reset));
+
+// --------------------
+// COMPONENT
+// --------------------
+
+UTrialPredictiveStreamingComponent::UTrialPredictiveStreamingComponent()
+{
+	// After movement, so the source follows this frame's velocity. Off until the owner is a streaming player pawn.
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostPhysics;
+
+	Source.TargetState = EStreamingSourceTargetState::Activated;
+	Source.bBlockOnSlowLoading = false;
+	Source.DebugColor = FColor::Cyan;
+}
+
+void UTrialPredictiveStreamingComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	Source.Name = FName(*FString::Printf(TEXT("%s_Predictive"), *GetOwner()->GetName()));
+
+	// Pawns possessed before BeginPlay; later controller changes come through the owner
+	RefreshStreamingRole();
+}
+
+void UTrialPredictiveStreamingComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	StopStreaming();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UTrialPredictiveStreamingComponent::RefreshStreamingRole()
+{
+	if (!HasBegunPlay())
+	{
+		return;
+	}
+
+	const ACustomCharacter* Character = Cast<ACustomCharacter>(GetOwner());
+	UWorldPartitionSubsystem* WorldPartition = GetWorld()->GetSubsystem<UWorldPartitionSubsystem>();
+
+	// Not a World Partition world: nothing to stream or probe
+	if (!Character || !WorldPartition || !ShouldStreamFor(*Character))
+	{
+		StopStreaming();
+		return;
+	}
+
+	if (!bRegistered)
+	{
+		WorldPartition->RegisterStreamingSourceProvider(this);
+		bRegistered = true;
+	}
+	SetComponentTickEnabled(true);
+}
+
+void UTrialPredictiveStreamingComponent::StopStreaming()
+{
+	SetComponentTickEnabled(false);
+
+	if (bRegistered)
+	{
+		if (UWorldPartitionSubsystem* WorldPartition = GetWorld()->GetSubsystem<UWorldPartitionSubsystem>())
+		{
+			WorldPartition->UnregisterStreamingSourceProvider(this);
+		}
+		bRegistered = false;
+	}
+	bSourceActive = false;
+	bWasLate = false;
+	ProbeTimeLeft = 0.f;
+	SlidePrediction.Reset();
+}
+
+bool UTrialPredictiveStreamingComponent::ShouldStreamFor(const ACustomCharacter& Character) const
+{
+	// Streaming follows player sources: the owning client, or the server that streams for its players
+	return Character.IsPlayerControlled() && (Character.IsLocallyControlled() || Character.HasAuthority());
+}
+
+void UTrialPredictiveStreamingComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	// Role changes normally arrive through RefreshStreamingRole; this only catches one that did not
+	const ACustomCharacter* Character = Cast<ACustomCharacter>(GetOwner());
+	if (!Character || !ShouldStreamFor(*Character))
+	{
+		StopStreaming();
+		return;
+	}
+
+	LLM_SCOPE_BYTAG(TrialTask_Movement);
+
+	UpdateSource(*Character, DeltaTime);
+	ProbeLateStreaming(*Character, DeltaTime);
+}
+
+void UTrialPredictiveStreamingComponent::UpdateSource(const ACustomCharacter& Character, float DeltaTime)
+{
+	using namespace TrialPredictiveStreaming;
+
+	const UCustomMovementComponent* Move = Cast<UCustomMovementComponent>(Character.GetCharacterMovement());
+	const FVector Location = Character.GetActorLocation();
+	const FVector Velocity = Move ? Move->Velocity : Character.GetVelocity();
+	const float Speed = Velocity.Size();
+
+	bSourceActive = CVarTrialStreamingPredictive.GetValueOnGameThread() != 0 && Speed >= CVarTrialStreamingMinSpeed.GetValueOnGameThread();
+	if (!bSourceActive)
+	{
+		SlidePrediction.Reset();
+		return;
+	}
+
+	const float Lookahead = FMath::Max(0.f, CVarTrialStreamingLookahead.GetValueOnGameThread());
+	const float Lead = FMath::Min(Speed * Lookahead, CVarTrialStreamingMaxLead.GetValueOnGameThread());
+	const int32 NumShapes = FMath::Clamp(FMath::CeilToInt(Lead / 1000.f), 1, MaxShapes);
+	const float Spacing = Lead / NumShapes;
+
+	// Points every Spacing along the path: the slide prediction while it lasts, then straight on
+	TArray<FVector, TInlineAllocator<MaxShapes>> Points;
+	FVector Tail = Location;
+	FVector TailDir = Velocity / Speed;
+	float Travelled = 0.f;
+
+	const bool bSliding = Move && Move->IsSliding();
+	if (bSliding)
+	{
+		if (!SlidePrediction)
+		{
+			// Mostly the floor cache
+			LLM_SCOPE_BYTAG(TrialTask_Caches);
+			SlidePrediction = MakeUnique<FSlideTrajectoryPredictor>();
+		}
+		SlidePrediction->HorizonSeconds = Lookahead;
+		Move->UpdateSlidePrediction(*SlidePrediction, DeltaTime, SlideFloorQueryBudget);
+
+		const FSlideTrajectoryPredictor& Path = *SlidePrediction;
+		for (int32 i = 1; i < Path.Num() && Points.Num() < NumShapes; ++i)
+		{
+			const FVector Step = Path[i].Location - Path[i - 1].Location;
+			const float StepLength = Step.Size();
+			if (StepLength <= KINDA_SMALL_NUMBER) continue;
+
+			TailDir = Step / StepLength;
+			while (Points.Num() < NumShapes && Travelled + StepLength >= Spacing * (Points.Num() + 1))
+			{
+				Points.Add(Path[i - 1].Location + TailDir * (Spacing * (Points.Num() + 1) - Travelled));
+			}
+			Travelled += StepLength;
+			Tail = Path[i].Location;
+		}
+	}
+	else
+	{
+		SlidePrediction.Reset();
+	}
+
+	while (Points.Num() < NumShapes)
+	{
+		Points.Add(Tail + TailDir * (Spacing * (Points.Num() + 1) - Travelled));
+	}
+
+	// Shapes are relative to the source; an unrotated source keeps them in world axes
+	Source.Location = Location;
+	Source.Rotation = FRotator::ZeroRotator;
+	Source.Velocity = Velocity;
+	Source.Priority = (bSliding || (Move && Speed >= Move->GetSprintSpeed())) ? EStreamingSourcePriority::High : EStreamingSourcePriority::Normal;
+	Source.Shapes.Reset(NumShapes);
+	for (const FVector& Point : Points)
+	{
+		FStreamingSourceShape& Shape = Source.Shapes.AddDefaulted_GetRef();
+		Shape.bUseGridLoadingRange = true;
+		Shape.LoadingRangeScale = CVarTrialStreamingShapeScale.GetValueOnGameThread();
+		Shape.Location = Point - Location;
+	}
+}
+
+void UTrialPredictiveStreamingComponent::ProbeLateStreaming(const ACustomCharacter& Character, float DeltaTime)
+{
+	using namespace TrialPredictiveStreaming;
+
+	if (bWasLate)
+	{
+		FTrialStreamingStats::LateSeconds += DeltaTime;
+	}
+
+	ProbeTimeLeft -= DeltaTime;
+	if (ProbeTimeLeft > 0.f)
+	{
+		return;
+	}
+	ProbeTimeLeft = ProbeInterval;
+
+	const UWorldPartitionSubsystem* WorldPartition = GetWorld()->GetSubsystem<UWorldPartitionSubsystem>();
+	if (!WorldPartition)
+	{
+		return;
+	}
+
+	FWorldPartitionStreamingQuerySource Query(Character.GetActorLocation());
+	Query.Radius = CVarTrialStreamingProbeRadius.GetValueOnGameThread();
+	Query.bUseGridLoadingRange = false;
+	Query.bSpatialQuery = true;
+	Query.bDataLayersOnly = false;
+
+	const bool bLate = !WorldPartition->IsStreamingCompleted(EWorldPartitionRuntimeCellState::Activated, { Query }, false);
+
+	++FTrialStreamingStats::Probes;
+	if (bLate)
+	{
+		++FTrialStreamingStats::LateProbes;
+		FTrialStreamingStats::MaxLateSpeed = FMath::Max(FTrialStreamingStats::MaxLateSpeed, (float)Character.GetVelocity().Size());
+		CSV_CUSTOM_STAT(Parkour, StreamingLateProbes, 1, ECsvCustomStatOp::Accumulate);
+
+		if (!bWasLate)
+		{
+			++FTrialStreamingStats::LateEvents;
+			UE_LOG(LogTemp, Verbose, TEXT("STREAMING: %s reached unloaded ground at %s (%.0f uu/s)"),
+				*Character.GetName(), *Character.GetActorLocation().ToCompactString(), Character.GetVelocity().Size());
+		}
+	}
+	bWasLate = bLate;
+}
+
+bool UTrialPredictiveStreamingComponent::GetStreamingSources(TArray<FWorldPartitionStreamingSource>& OutStreamingSources) const
+{
+	if (!bSourceActive)
+	{
+		return false;
+	}
+
+	OutStreamingSources.Add(Source);
+	return true;
+}
@@ -0,0 +1,218 @@
+#include "TrialReplayController.h"
+
+#include "CustomCharacter.h"
+
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Paths.h"
+
+ATrialReplayController::ATrialReplayController()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = true;
+	PrimaryActorTick.TickGroup = TG_PrePhysics;
+
+	bReplicates = false;
+	bWantsPlayerState = false;
+}
+
+FString ATrialReplayController::ResolvePath(const FString& Name)
+{
+	if (FPaths::IsRelative(Name) && !Name.Contains(TEXT("/")) && !Name.Contains(TEXT("\\")))
+	{
+		return FPaths::ProjectSavedDir() / TEXT("InputReplays") / FPaths::SetExtension(Name, TEXT("tir"));
+	}
+	return Name;
+}
+
+ATrialReplayController* ATrialReplayController::StartReplay(ACustomCharacter* Pawn, const FString& Path, bool bInQuitWhenDone)
+{
+	UWorld* World = Pawn ? Pawn->GetWorld() : nullptr;
+	if (!World) return nullptr;
+
+	FTrialInputRecording Recording;
+	if (!Recording.LoadFromFile(Path) || Recording.Frames.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("REPLAY: cannot load %s"), *Path);
+		return nullptr;
+	}
+
+	ATrialReplayController* Replay = World->SpawnActor<ATrialReplayController>();
+	if (!Replay) return nullptr;
+
+	Replay->Recording = MoveTemp(Recording);
+	Replay->bQuitWhenDone = bInQuitWhenDone;
+	Replay->PreviousController = Pawn->GetController();
+	Replay->ReplayPawn = Pawn;
+
+	if (Replay->PreviousController)
+	{
+		Replay->PreviousController->UnPossess();
+	}
+	Replay->Possess(Pawn);
+	Pawn->ApplyReplayState(Replay->Recording.Initial);
+
+	// Frame 0's delta applies to the next engine frame, which is when playback starts
+	Replay->bSavedUseFixedTimeStep = FApp::UseFixedTimeStep();
+	Replay->SavedFixedDeltaTime = FApp::GetFixedDeltaTime();
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(Replay->Recording.Frames[0].DeltaSeconds);
+
+	Replay->StartSeconds = FPlatformTime::Seconds();
+
+	UE_LOG(LogTemp, Display, TEXT("REPLAY: playing %s (%d frames)"), *Path, Replay->Recording.Frames.Num());
+	return Replay;
+}
+
+void ATrialReplayController::StartFromCommandLine(ACustomCharacter* Pawn)
+{
+	static bool bStarted = false;
+
+	FString File;
+	if (bStarted || !Pawn || !Pawn->IsPlayerControlled() || !FParse::Value(FCommandLine::Get(), TEXT("TrialReplay="), File))
+	{
+		return;
+	}
+	bStarted = true;
+
+	const bool bQuit = FParse::Param(FCommandLine::Get(), TEXT("TrialReplayQuit"));
+	const FString Path = ResolvePath(File);
+
+	// Wait one frame so the player controller finished its own BeginPlay/possession
+	TWeakObjectPtr<ACustomCharacter> WeakPawn(Pawn);
+	Pawn->GetWorld()->GetTimerManager().SetTimerForNextTick([WeakPawn, Path, bQuit]()
+	{
+		if (ACustomCharacter* P = WeakPawn.Get())
+		{
+			StartReplay(P, Path, bQuit);
+		}
+	});
+}
+
+void ATrialReplayController::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	if (!ReplayPawn)
+	{
+		Destroy();
+		return;
+	}
+
+	if (FrameIndex >= Recording.Frames.Num())
+	{
+		Finish();
+		return;
+	}
+
+	const FTrialInputFrame& Frame = Recording.Frames[FrameIndex];
+
+	if (!FMath::IsNearlyEqual(DeltaSeconds, Frame.DeltaSeconds, 1e-6f))
+	{
+		++DeltaMismatches;
+	}
+
+	SetControlRotation(FRotator(Frame.ControlRotation));
+
+	for (uint8 i = 0; i < (uint8)ETrialInputAction::Count; ++i)
+	{
+		const ETrialInputAction Action = (ETrialInputAction)i;
+		if (Frame.WasPressed(Action))
+		{
+			ReplayPawn->InjectAction(Action, true);
+		}
+		if (Frame.WasReleased(Action))
+		{
+			ReplayPawn->InjectAction(Action, false);
+		}
+	}
+
+	if (!Frame.Move.IsZero())
+	{
+		ReplayPawn->InjectMoveInput(FVector2D(Frame.Move));
+	}
+
+	++FrameIndex;
+	if (FrameIndex < Recording.Frames.Num())
+	{
+		FApp::SetFixedDeltaTime(Recording.Frames[FrameIndex].DeltaSeconds);
+	}
+}
+
+void ATrialReplayController::Finish()
+{
+	FApp::SetUseFixedTimeStep(bSavedUseFixedTimeStep);
+	FApp::SetFixedDeltaTime(SavedFixedDeltaTime);
+
+	const FVector Final = ReplayPawn->GetActorLocation();
+	const double WallSeconds = FPlatformTime::Seconds() - StartSeconds;
+
+	// Final state is printed so runs of the same replay can be compared across builds
+	UE_LOG(LogTemp, Display, TEXT("REPLAY: done frames=%d wall=%.2fs deltaMismatches=%d final=(%.3f, %.3f, %.3f)"),
+		FrameIndex, WallSeconds, DeltaMismatches, Final.X, Final.Y, Final.Z);
+
+	ACustomCharacter* Pawn = ReplayPawn;
+	UnPossess();
+	if (PreviousController)
+	{
+		PreviousController->Possess(Pawn);
+	}
+
+	if (bQuitWhenDone)
+	{
+		FPlatformMisc::RequestExit(false, TEXT("TrialReplay"));
+	}
+
+	ReplayPawn = nullptr;
+	Destroy();
+}
+
+// --------------------
+// Console
+// --------------------
+
+namespace TrialReplayConsole
+{
+	static ACustomCharacter* FindLocalCharacter(UWorld* World)
+	{
+		APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+		return PC ? Cast<ACustomCharacter>(PC->GetPawn()) : nullptr;
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CmdTrialInputRecord(
+	TEXT("Trial.Input.Record"),
+	TEXT("Starts recording the local character's input."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (ACustomCharacter* Pawn = TrialReplayConsole::FindLocalCharacter(World))
+		{
+			Pawn->StartInputRecording();
+		}
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdTrialInputStopRecord(
+	TEXT("Trial.Input.StopRecord"),
+	TEXT("Trial.Input.StopRecord <file>. Stops recording and writes the replay."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (ACustomCharacter* Pawn = TrialReplayConsole::FindLocalCharacter(World))
+		{
+			Pawn->StopInputRecording(ATrialReplayController::ResolvePath(Args.Num() > 0 ? Args[0] : TEXT("LastRecording")));
+		}
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdTrialInputReplay(
+	TEXT("Trial.Input.Replay"),
+	TEXT("Trial.Input.Replay <file>. Replays a recording on the local character."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (ACustomCharacter* Pawn = TrialReplayConsole::FindLocalCharacter(World))
+		{
+			ATrialReplayController::StartReplay(Pawn, ATrialReplayController::ResolvePath(Args.Num() > 0 ? Args[0] : TEXT("LastRecording")), false);
+		}
+	}));
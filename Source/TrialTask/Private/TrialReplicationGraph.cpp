@@ -0,0 +1,196 @@
+#include "TrialReplicationGraph.h"
+
+#include "CustomCharacter.h"
+#include "ParkourStats.h"
+
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "GameFramework/Info.h"
+#include "GameFramework/PlayerState.h"
+#include "HAL/IConsoleManager.h"
+#include "ReplicationGraphTypes.h"
+
+DECLARE_CYCLE_STAT(TEXT("ServerReplicateActors"), STAT_TrialServerReplicateActors, STATGROUP_Parkour);
+
+static TAutoConsoleVariable<float> CVarTrialRepBenchReportInterval(
+	TEXT("Trial.RepBench.ReportInterval"),
+	0.f,
+	TEXT("If > 0, logs the replication benchmark table every N seconds (used by RunRepBenchmark.sh)."));
+
+UTrialReplicationGraph* UTrialReplicationGraph::Get(const UWorld* World)
+{
+	const UNetDriver* Driver = World ? World->GetNetDriver() : nullptr;
+	return Driver ? Cast<UTrialReplicationGraph>(Driver->GetReplicationDriver()) : nullptr;
+}
+
+void UTrialReplicationGraph::InitGlobalActorClassSettings()
+{
+	Super::InitGlobalActorClassSettings();
+
+	const float FrameRate = NetDriver ? (float)NetDriver->GetNetServerMaxTickRate() : 30.f;
+
+	auto SetClassInfo = [this, FrameRate](UClass* Class, float CullDistance, int32 PeriodFrames)
+	{
+		FClassReplicationInfo Info;
+		Info.SetCullDistanceSquared(CullDistance * CullDistance);
+		Info.ReplicationPeriodFrame = FMath::Max(1, PeriodFrames);
+		GlobalActorReplicationInfoMap.SetClassInfo(Class, Info);
+	};
+
+	SetClassInfo(ACustomCharacter::StaticClass(), CharacterCullDistance, ActivePeriodFrames);
+	SetClassInfo(APlayerState::StaticClass(), 0.f, FMath::Max(1, FMath::RoundToInt(FrameRate / 2.f)));
+}
+
+void UTrialReplicationGraph::InitGlobalGraphNodes()
+{
+	GridNode = CreateNewNode<UReplicationGraphNode_GridSpatialization2D>();
+	GridNode->CellSize = GridCellSize;
+	GridNode->SpatialBias = SpatialBias;
+	AddGlobalGraphNode(GridNode);
+
+	AlwaysRelevantNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+	AddGlobalGraphNode(AlwaysRelevantNode);
+}
+
+void UTrialReplicationGraph::InitConnectionGraphNodes(UNetReplicationGraphConnection* ConnectionManager)
+{
+	Super::InitConnectionGraphNodes(ConnectionManager);
+
+	// Connection's own controller, pawn and view target
+	UReplicationGraphNode_AlwaysRelevant_ForConnection* OwnerNode = CreateNewNode<UReplicationGraphNode_AlwaysRelevant_ForConnection>();
+	AddConnectionGraphNode(OwnerNode, ConnectionManager);
+}
+
+UTrialReplicationGraph::ERouting UTrialReplicationGraph::GetRouting(const AActor* Actor) const
+{
+	if (!Actor || Actor->bOnlyRelevantToOwner)
+	{
+		return ERouting::None;
+	}
+	if (Actor->bAlwaysRelevant || Actor->IsA<AInfo>())
+	{
+		return ERouting::AlwaysRelevant;
+	}
+	if (Actor->IsA<APawn>())
+	{
+		return ERouting::Grid;
+	}
+	return Actor->IsRootComponentMovable() ? ERouting::Grid : ERouting::GridStatic;
+}
+
+void UTrialReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+	switch (GetRouting(ActorInfo.Actor))
+	{
+	case ERouting::Grid:
+		GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+		break;
+	case ERouting::GridStatic:
+		GridNode->AddActor_Static(ActorInfo, GlobalInfo);
+		break;
+	case ERouting::AlwaysRelevant:
+		AlwaysRelevantNode->NotifyAddNetworkActor(ActorInfo);
+		break;
+	case ERouting::None:
+		break;
+	}
+}
+
+void UTrialReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+	switch (GetRouting(ActorInfo.Actor))
+	{
+	case ERouting::Grid:
+		GridNode->RemoveActor_Dynamic(ActorInfo);
+		break;
+	case ERouting::GridStatic:
+		GridNode->RemoveActor_Static(ActorInfo);
+		break;
+	case ERouting::AlwaysRelevant:
+		AlwaysRelevantNode->NotifyRemoveNetworkActor(ActorInfo);
+		break;
+	case ERouting::None:
+		break;
+	}
+}
+
+void UTrialReplicationGraph::SetTraversalActive(AActor* Actor, bool bActive)
+{
+	if (!Actor) return;
+
+	FGlobalActorReplicationInfo& Info = GlobalActorReplicationInfoMap.Get(Actor);
+	Info.Settings.ReplicationPeriodFrame = FMath::Max(1, bActive ? ActivePeriodFrames : IdlePeriodFrames);
+}
+
+int32 UTrialReplicationGraph::ServerReplicateActors(float DeltaSeconds)
+{
+	PARKOUR_SCOPE(STAT_TrialServerReplicateActors);
+
+	const double Start = FPlatformTime::Seconds();
+	const int32 Replicated = Super::ServerReplicateActors(DeltaSeconds);
+	const double Ms = (FPlatformTime::Seconds() - Start) * 1000.0;
+
+	const int32 NumConnections = NetDriver ? NetDriver->ClientConnections.Num() : 0;
+	FTrialRepBenchStats::Add(NumConnections, Ms, Replicated);
+
+	CSV_CUSTOM_STAT(Parkour, RepConnections, NumConnections, ECsvCustomStatOp::Set);
+
+	static double LastReport = Start;
+	const float Interval = CVarTrialRepBenchReportInterval.GetValueOnGameThread();
+	if (Interval > 0.f && Start - LastReport >= Interval)
+	{
+		LastReport = Start;
+		FTrialRepBenchStats::Report();
+	}
+
+	return Replicated;
+}
+
+// --------------------
+// Benchmark stats
+// --------------------
+
+TMap<int32, FTrialRepBenchStats::FBucket>& FTrialRepBenchStats::Buckets()
+{
+	static TMap<int32, FBucket> Map;
+	return Map;
+}
+
+void FTrialRepBenchStats::Add(int32 NumConnections, double Ms, int32 NumReplicated)
+{
+	FBucket& Bucket = Buckets().FindOrAdd(NumConnections);
+	Bucket.TotalMs += Ms;
+	Bucket.MaxMs = FMath::Max(Bucket.MaxMs, Ms);
+	Bucket.ActorsReplicated += NumReplicated;
+	++Bucket.Frames;
+}
+
+void FTrialRepBenchStats::Report()
+{
+	TMap<int32, FBucket>& Map = Buckets();
+	Map.KeySort(TLess<int32>());
+
+	for (const TPair<int32, FBucket>& Pair : Map)
+	{
+		const FBucket& B = Pair.Value;
+		if (B.Frames == 0) continue;
+
+		UE_LOG(LogTemp, Display, TEXT("REPBENCH,Players=%d,Frames=%lld,AvgMs=%.4f,MaxMs=%.4f,ActorsPerFrame=%.1f"),
+			Pair.Key, B.Frames, B.TotalMs / B.Frames, B.MaxMs, (double)B.ActorsReplicated / B.Frames);
+	}
+}
+
+void FTrialRepBenchStats::Reset()
+{
+	Buckets().Reset();
+}
+
+static FAutoConsoleCommand CmdTrialRepBenchReport(
+	TEXT("Trial.RepBench.Report"),
+	TEXT("Prints server replication ms per frame grouped by connected player count."),
+	FConsoleCommandDelegate::CreateStatic(&FTrialRepBenchStats::Report));
+
+static FAutoConsoleCommand CmdTrialRepBenchReset(
+	TEXT("Trial.RepBench.Reset"),
+	TEXT("Clears the replication benchmark table."),
+	FConsoleCommandDelegate::CreateStatic(&FTrialRepBenchStats::Reset));
@@ -0,0 +1,54 @@
+#include "TrialSlideSurfaces.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+
+// Shared by every cache, so a predictor fed by another movement component also sees a change
+static uint32 GTrialSlideSurfaceGeneration = 0;
+
+void FTrialSlideSurfaceCache::Build(const UTrialSlideSurfaceTable* Table)
+{
+	Generation = ++GTrialSlideSurfaceGeneration;
+
+	Surfaces.Reset();
+	IndexByMaterial.Reset();
+	Surfaces.AddDefaulted(1);
+
+	if (!Table)
+	{
+		return;
+	}
+
+	for (const FTrialSlideSurfaceProfile& Profile : Table->Profiles)
+	{
+		if (!Profile.PhysicalMaterial || IndexByMaterial.Contains(Profile.PhysicalMaterial.Get()))
+		{
+			continue;
+		}
+		if (Surfaces.Num() > MAX_uint8)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Slide surface table %s: more than %d profiles, the rest use the default surface"), *Table->GetName(), (int32)MAX_uint8);
+			break;
+		}
+
+		FTrialSlideSurface& Surface = Surfaces.AddDefaulted_GetRef();
+		Surface.Friction = Profile.FrictionScale;
+		Surface.FlatDecel = Profile.FlatDecelScale;
+		Surface.DownhillAccel = Profile.DownhillAccelScale;
+
+		IndexByMaterial.Add(Profile.PhysicalMaterial.Get(), (uint8)(Surfaces.Num() - 1));
+	}
+}
+
+uint8 FTrialSlideSurfaceCache::Resolve(const UPrimitiveComponent* Floor) const
+{
+	if (IndexByMaterial.IsEmpty() || !Floor)
+	{
+		return DefaultIndex;
+	}
+
+	const UPhysicalMaterial* Material = Floor->BodyInstance.GetSimplePhysicalMaterial();
+
+	const uint8* Index = Material ? IndexByMaterial.Find(Material) : nullptr;
+	return Index ? *Index : DefaultIndex;
+}
@@ -0,0 +1,181 @@
+#include "TrialSoakTestController.h"
+
+#include "ParkourAllocationScope.h"
+#include "ParkourStats.h"
+#include "TrialBotController.h"
+
+#include "CoreGlobals.h"
+#include "Engine/World.h"
+#include "Misc/CommandLine.h"
+
+void UTrialSoakTestController::OnInit()
+{
+	Super::OnInit();
+
+	FParse::Value(FCommandLine::Get(), TEXT("SoakBots="), NumBots);
+	FParse::Value(FCommandLine::Get(), TEXT("SoakDuration="), DurationSeconds);
+	FParse::Value(FCommandLine::Get(), TEXT("SoakBehavior="), BotBehavior);
+	FParse::Value(FCommandLine::Get(), TEXT("SoakPawn="), PawnClass);
+
+	NumBots = FMath::Max(1, NumBots);
+	DurationSeconds = FMath::Max(1.f, DurationSeconds);
+
+	Phase = ESoakPhase::WaitingForMap;
+	PhaseTime = 0.f;
+
+	UE_LOG(LogTemp, Display, TEXT("SOAK: init (map=%s bots=%d duration=%.0fs pawn=%s)"), *MapName, NumBots, DurationSeconds, PawnClass.IsEmpty() ? TEXT("default") : *PawnClass);
+}
+
+void UTrialSoakTestController::OnTick(float TimeDelta)
+{
+	Super::OnTick(TimeDelta);
+
+	PhaseTime += TimeDelta;
+
+	switch (Phase)
+	{
+	case ESoakPhase::WaitingForMap:
+	{
+		UWorld* World = GetWorld();
+		if (World && World->HasBegunPlay() && World->GetMapName().Contains(MapName))
+		{
+			if (!SpawnBots())
+			{
+				UE_LOG(LogTemp, Error, TEXT("SOAK: could not spawn bots"));
+				Phase = ESoakPhase::Done;
+				EndTest(2);
+				return;
+			}
+
+			Phase = ESoakPhase::Warmup;
+			PhaseTime = 0.f;
+		}
+		else if (PhaseTime > MapLoadTimeoutSeconds)
+		{
+			UE_LOG(LogTemp, Error, TEXT("SOAK: %s never loaded"), *MapName);
+			Phase = ESoakPhase::Done;
+			EndTest(2);
+		}
+		break;
+	}
+
+	case ESoakPhase::Warmup:
+		if (PhaseTime >= WarmupSeconds)
+		{
+			BeginMeasuring();
+		}
+		break;
+
+	case ESoakPhase::Measuring:
+	{
+		// Game-thread time of the last completed frame (same figure as stat unit's Game)
+		GameThreadMs.Add((float)FPlatformTime::ToMilliseconds(GGameThreadTime));
+
+		if (PhaseTime >= DurationSeconds)
+		{
+			FinishAndReport();
+		}
+		break;
+	}
+
+	case ESoakPhase::Done:
+		break;
+	}
+}
+
+bool UTrialSoakTestController::SpawnBots()
+{
+	UClass* Class = ATrialBotController::FindBotPawnClass(PawnClass);
+	if (!PawnClass.IsEmpty() && !Class)
+	{
+		return false;
+	}
+
+	TArray<APawn*> Spawned;
+	ATrialBotController::SpawnBots(GetWorld(), NumBots, BotBehavior, &Spawned, Class);
+
+	Bots.Reset(Spawned.Num());
+	for (APawn* Pawn : Spawned)
+	{
+		Bots.Add(Pawn);
+	}
+	BotClassName = Spawned.Num() > 0 ? Spawned[0]->GetClass()->GetName() : FString();
+
+	return Bots.Num() > 0;
+}
+
+void UTrialSoakTestController::BeginMeasuring()
+{
+	Phase = ESoakPhase::Measuring;
+	PhaseTime = 0.f;
+
+	GameThreadMs.Reset();
+	GameThreadMs.Reserve(FMath::CeilToInt(DurationSeconds * 120.f));
+
+	QueriesAtStart = FParkourQueryCounters::TotalQueries();
+#if PARKOUR_ALLOC_TRACKING
+	AllocViolationsAtStart = FParkourAllocSite::TotalViolations();
+#endif
+
+#if CSV_PROFILER
+	if (FCsvProfiler* Csv = FCsvProfiler::Get())
+	{
+		Csv->BeginCapture();
+	}
+#endif
+
+	UE_LOG(LogTemp, Display, TEXT("SOAK: measuring for %.0fs"), DurationSeconds);
+}
+
+void UTrialSoakTestController::FinishAndReport()
+{
+	Phase = ESoakPhase::Done;
+
+#if CSV_PROFILER
+	if (FCsvProfiler* Csv = FCsvProfiler::Get())
+	{
+		Csv->EndCapture();
+	}
+#endif
+
+	const int32 Frames = FMath::Max(1, GameThreadMs.Num());
+	const int32 AliveBots = FMath::Max(1, Bots.Num());
+
+	float Sum = 0.f;
+	for (float Ms : GameThreadMs)
+	{
+		Sum += Ms;
+	}
+	const float AvgMs = Sum / Frames;
+
+	GameThreadMs.Sort();
+	const float P95Ms = GameThreadMs.Num() > 0 ? GameThreadMs[FMath::Min(GameThreadMs.Num() - 1, (int32)(GameThreadMs.Num() * 0.95f))] : 0.f;
+
+	const uint64 Queries = FParkourQueryCounters::TotalQueries() - QueriesAtStart;
+	const float QueriesPerBotPerFrame = (float)Queries / (float)(Frames * AliveBots);
+
+	int64 AllocViolations = 0;
+#if PARKOUR_ALLOC_TRACKING
+	AllocViolations = (int64)(FParkourAllocSite::TotalViolations() - AllocViolationsAtStart);
+#endif
+
+	UE_LOG(LogTemp, Display, TEXT("SOAK: pawn=%s frames=%d bots=%d avgGT=%.3fms (max %.3f) p95GT=%.3fms (max %.3f) queries/bot/frame=%.3f (max %.3f) allocViolations=%lld (max %d)"),
+		*BotClassName, Frames, AliveBots, AvgMs, MaxAvgGameThreadMs, P95Ms, MaxP95GameThreadMs, QueriesPerBotPerFrame, MaxQueriesPerBotPerFrame, AllocViolations, MaxAllocViolations);
+
+	int32 Failures = 0;
+	auto Gate = [&Failures](bool bOk, const TCHAR* What)
+	{
+		if (!bOk)
+		{
+			UE_LOG(LogTemp, Error, TEXT("SOAK: baseline exceeded: %s"), What);
+			++Failures;
+		}
+	};
+
+	Gate(AvgMs <= MaxAvgGameThreadMs, TEXT("average game-thread ms"));
+	Gate(P95Ms <= MaxP95GameThreadMs, TEXT("p95 game-thread ms"));
+	Gate(QueriesPerBotPerFrame <= MaxQueriesPerBotPerFrame, TEXT("traversal queries per bot per frame"));
+	Gate(AllocViolations <= MaxAllocViolations, TEXT("hot-path allocation violations"));
+
+	EndTest(Failures > 0 ? 1 : 0);
+}
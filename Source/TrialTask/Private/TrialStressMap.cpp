@@ -0,0 +1,302 @@
+#include "TrialStressMap.h"
+
+#include "TrialParkourObstacle.h"
+#include "TrialTaskLLM.h"
+
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerStart.h"
+#include "HAL/IConsoleManager.h"
+
+namespace TrialStressMap
+{
+	const FName SpawnTag(TEXT("StressMap"));
+
+	// 100 uu basic shapes: cube centred on its origin, plane at Z = 0
+	static const TCHAR* CubePath = TEXT("/Engine/BasicShapes/Cube.Cube");
+	static const TCHAR* PlanePath = TEXT("/Engine/BasicShapes/Plane.Plane");
+	constexpr float ShapeSize = 100.f;
+
+	// Obstacles and ramps use at most this share of a cell; the rest is lane
+	constexpr float CellFill = 0.6f;
+	constexpr float RampThickness = 20.f;
+
+	// Far below the usual maps, so a runtime stress map does not overlap TestingArea
+	static const FVector RuntimeOrigin(0.0, 0.0, -50000.0);
+
+	static float RandRange(FRandomStream& Stream, const FVector2D& Range)
+	{
+		return Stream.FRandRange(FMath::Min(Range.X, Range.Y), FMath::Max(Range.X, Range.Y));
+	}
+}
+
+ATrialStressMapGenerator::ATrialStressMapGenerator(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	// Unscaled root: the floor is scaled to the map, instances stay in map space
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+
+	Floor = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Floor"));
+	Floor->SetupAttachment(RootComponent);
+	Floor->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+
+	Slopes = CreateDefaultSubobject<UHierarchicalInstancedStaticMeshComponent>(TEXT("Slopes"));
+	Slopes->SetupAttachment(RootComponent);
+	Slopes->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+
+	Clutter = CreateDefaultSubobject<UHierarchicalInstancedStaticMeshComponent>(TEXT("Clutter"));
+	Clutter->SetupAttachment(RootComponent);
+	Clutter->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+}
+
+void ATrialStressMapGenerator::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (bGenerateOnBeginPlay && GeneratedActors.Num() == 0)
+	{
+		Generate();
+	}
+}
+
+int32 ATrialStressMapGenerator::GetSide() const
+{
+	// Ramp cells come on top of the obstacle cells
+	const float ObstacleCells = ObstacleCount / FMath::Max(0.1f, 1.f - SlopeFraction);
+	return FMath::Max(1, FMath::CeilToInt(FMath::Sqrt(ObstacleCells)));
+}
+
+void ATrialStressMapGenerator::Clear()
+{
+	for (AActor* Actor : GeneratedActors)
+	{
+		if (IsValid(Actor))
+		{
+			Actor->Destroy();
+		}
+	}
+	GeneratedActors.Reset();
+	SpawnTransforms.Reset();
+
+	Slopes->ClearInstances();
+	Clutter->ClearInstances();
+}
+
+void ATrialStressMapGenerator::Generate()
+{
+	using namespace TrialStressMap;
+
+	UWorld* World = GetWorld();
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, CubePath);
+	UStaticMesh* Plane = LoadObject<UStaticMesh>(nullptr, PlanePath);
+	if (!World || !Cube || !Plane) return;
+
+	LLM_SCOPE_BYTAG(TrialTask);
+
+	const double StartSeconds = FPlatformTime::Seconds();
+
+	Clear();
+
+	const int32 Side = GetSide();
+	const float Extent = Side * CellSize;
+	const float MaxFootprint = CellSize * CellFill;
+	const FTransform Origin(GetActorRotation(), GetActorLocation());
+
+	Floor->SetStaticMesh(Plane);
+	Floor->SetRelativeLocation(FVector(Extent * 0.5f, Extent * 0.5f, 0.f));
+	Floor->SetRelativeScale3D(FVector(Extent / ShapeSize, Extent / ShapeSize, 1.f));
+	Slopes->SetStaticMesh(Cube);
+	Clutter->SetStaticMesh(Cube);
+
+	FActorSpawnParameters Params;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	Params.Owner = this;
+
+	UClass* ActorClass = ObstacleActorClass.IsNull() ? nullptr : ObstacleActorClass.LoadSynchronous();
+
+	// Instances are built in bulk; obstacles keep zeroed custom data (cube top, everything allowed) unless restricted
+	TArray<FTransform> ObstacleTransforms;
+	TArray<uint8> ObstacleFlags;
+	TArray<FTransform> SlopeTransforms;
+	TArray<FTransform> ClutterTransforms;
+
+	// Cells run +X +Y from the actor origin, so a smaller map is the corner of a larger one
+	const FVector Corner = FVector::ZeroVector;
+
+	int32 NumObstacles = 0;
+	for (int32 Y = 0; Y < Side; ++Y)
+	{
+		for (int32 X = 0; X < Side; ++X)
+		{
+			FRandomStream Stream(HashCombine(GetTypeHash(Seed), HashCombine(GetTypeHash(X), GetTypeHash(Y))));
+			const FVector CellCentre = Corner + FVector((X + 0.5f) * CellSize, (Y + 0.5f) * CellSize, 0.f);
+			const float Yaw = Stream.FRandRange(0.f, 360.f);
+
+			if (Stream.FRand() < SlopeFraction)
+			{
+				// Ramp across the cell: the low edge of its top face on the floor
+				const float Angle = FMath::DegreesToRadians(RandRange(Stream, SlopeAngleRange));
+				const float Length = CellSize * CellFill / FMath::Max(0.2f, FMath::Cos(Angle));
+				const float Width = Stream.FRandRange(0.5f, 1.f) * MaxFootprint;
+				const float CentreZ = 0.5f * Length * FMath::Sin(Angle) - 0.5f * RampThickness * FMath::Cos(Angle);
+
+				SlopeTransforms.Emplace(FRotator(FMath::RadiansToDegrees(Angle), Yaw, 0.f), CellCentre + FVector(0.f, 0.f, CentreZ),
+					FVector(Length, Width, RampThickness) / ShapeSize);
+			}
+			else if (NumObstacles < ObstacleCount)
+			{
+				const float Height = RandRange(Stream, ObstacleHeightRange);
+				const float Width = FMath::Min(RandRange(Stream, ObstacleFootprintRange), MaxFootprint);
+				const float Depth = FMath::Min(RandRange(Stream, ObstacleFootprintRange), MaxFootprint);
+
+				// Jitter inside what the footprint leaves of the cell's filled part
+				const float Slack = FMath::Max(0.f, MaxFootprint - FMath::Max(Width, Depth)) * 0.5f;
+				const FVector Jitter(Stream.FRandRange(-Slack, Slack), Stream.FRandRange(-Slack, Slack), 0.f);
+
+				ObstacleTransforms.Emplace(FRotator(0.f, Yaw, 0.f), CellCentre + Jitter + FVector(0.f, 0.f, Height * 0.5f),
+					FVector(Depth, Width, Height) / ShapeSize);
+
+				uint8 Flags = 0;
+				if (Stream.FRand() < RestrictedFraction)
+				{
+					Flags = Stream.FRand() < 0.5f ? UTrialParkourObstacleComponent::FlagNoVault : UTrialParkourObstacleComponent::FlagNoMantle;
+				}
+				ObstacleFlags.Add(Flags);
+				++NumObstacles;
+			}
+
+			// Clutter: whole part of the mean always, the fraction by chance
+			const int32 NumClutter = FMath::FloorToInt(ClutterPerCell) + (Stream.FRand() < FMath::Frac(ClutterPerCell) ? 1 : 0);
+			for (int32 i = 0; i < NumClutter; ++i)
+			{
+				const float Size = RandRange(Stream, ClutterSizeRange);
+				const FVector Offset(Stream.FRandRange(-0.5f, 0.5f) * MaxFootprint, Stream.FRandRange(-0.5f, 0.5f) * MaxFootprint, Size * 0.5f);
+				ClutterTransforms.Emplace(FRotator(0.f, Stream.FRandRange(0.f, 360.f), 0.f), CellCentre + Offset, FVector(Size / ShapeSize));
+			}
+		}
+	}
+
+	Slopes->AddInstances(SlopeTransforms, false, false);
+	Clutter->AddInstances(ClutterTransforms, false, false);
+
+	if (ActorClass)
+	{
+		for (int32 i = 0; i < ObstacleTransforms.Num(); ++i)
+		{
+			// Scaled so its bounds match the drawn box, standing on the floor
+			AActor* Obstacle = World->SpawnActor<AActor>(ActorClass, FTransform(ObstacleTransforms[i].GetRotation()) * Origin, Params);
+			if (!Obstacle) continue;
+
+			const FBox Local = Obstacle->CalculateComponentsBoundingBoxInLocalSpace(true);
+			const FVector Size = ObstacleTransforms[i].GetScale3D() * ShapeSize;
+			const FVector Scale = Size / Local.GetSize().ComponentMax(FVector(1.f));
+			const FVector Bottom = FVector(ObstacleTransforms[i].GetLocation().X, ObstacleTransforms[i].GetLocation().Y, 0.f);
+			Obstacle->SetActorScale3D(Scale);
+			Obstacle->SetActorLocation(Origin.TransformPosition(Bottom - FVector(0.f, 0.f, Local.Min.Z * Scale.Z)));
+
+			// Same restrictions as the instanced field, so both modes build the same level
+			if (ObstacleFlags[i] & UTrialParkourObstacleComponent::FlagNoVault) Obstacle->Tags.AddUnique(TrialParkourObstacle::NoVaultTag);
+			if (ObstacleFlags[i] & UTrialParkourObstacleComponent::FlagNoMantle) Obstacle->Tags.AddUnique(TrialParkourObstacle::NoMantleTag);
+			GeneratedActors.Add(Obstacle);
+		}
+	}
+	else if (ATrialParkourObstacleField* Field = World->SpawnActor<ATrialParkourObstacleField>(ATrialParkourObstacleField::StaticClass(), Origin, Params))
+	{
+		UTrialParkourObstacleComponent* Obstacles = Field->GetObstacles();
+		Obstacles->SetStaticMesh(Cube);
+		const TArray<int32> Indices = Obstacles->AddInstances(ObstacleTransforms, true, false);
+		for (int32 i = 0; i < Indices.Num(); ++i)
+		{
+			if (ObstacleFlags[i] != 0)
+			{
+				Obstacles->SetObstacleTraversal(Indices[i], 0.f,
+					(ObstacleFlags[i] & UTrialParkourObstacleComponent::FlagNoVault) == 0,
+					(ObstacleFlags[i] & UTrialParkourObstacleComponent::FlagNoMantle) == 0);
+			}
+		}
+		GeneratedActors.Add(Field);
+	}
+
+	// Spawn points on lane crossings, spread evenly over the map
+	const int32 SpawnSide = FMath::Max(1, FMath::CeilToInt(FMath::Sqrt((float)BotSpawnPoints)));
+	for (int32 i = 0; i < BotSpawnPoints; ++i)
+	{
+		const int32 CellX = FMath::Clamp(FMath::RoundToInt(((i % SpawnSide) + 0.5f) * Side / SpawnSide), 0, Side);
+		const int32 CellY = FMath::Clamp(FMath::RoundToInt(((i / SpawnSide) + 0.5f) * Side / SpawnSide), 0, Side);
+		const FVector Local = Corner + FVector(CellX * CellSize, CellY * CellSize, 100.f);
+
+		const FTransform Spawn = FTransform(FRotator(0.f, 45.f + 90.f * (i % 4), 0.f), Local) * Origin;
+		SpawnTransforms.Add(Spawn);
+
+		if (APlayerStart* Start = World->SpawnActor<APlayerStart>(APlayerStart::StaticClass(), Spawn, Params))
+		{
+			Start->PlayerStartTag = SpawnTag;
+			GeneratedActors.Add(Start);
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("STRESSMAP,Seed=%d,Side=%d,CellSize=%.0f,Extent=%.0f,Obstacles=%d,Mode=%s,Slopes=%d,Clutter=%d,SpawnPoints=%d,BuildMs=%.1f"),
+		Seed, Side, CellSize, Extent, NumObstacles, ActorClass ? TEXT("Actors") : TEXT("Instanced"),
+		SlopeTransforms.Num(), ClutterTransforms.Num(), SpawnTransforms.Num(), (FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+}
+
+// --------------------
+// CONSOLE
+// --------------------
+
+static FAutoConsoleCommandWithWorldAndArgs CmdTrialStressMap(
+	TEXT("Trial.StressMap"),
+	TEXT("Trial.StressMap [Obstacles=1000] [Seed=1] [ObstacleActorClass]. Builds (or rebuilds) a stress map below the level and moves the local pawn onto it.\n")
+	TEXT("Standard fixtures: 1000, 10000, 100000 with seed 1. Bots: Trial.SpawnBots then uses the map's spawn points. Trial.StressMap 0 removes it."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World || World->GetNetMode() == NM_Client) return;
+
+		const int32 Count = Args.Num() > 0 ? FMath::Max(0, FCString::Atoi(*Args[0])) : 1000;
+
+		ATrialStressMapGenerator* Generator = nullptr;
+		for (TActorIterator<ATrialStressMapGenerator> It(World); It; ++It)
+		{
+			Generator = *It;
+			break;
+		}
+
+		if (Count == 0)
+		{
+			if (Generator)
+			{
+				Generator->Clear();
+				Generator->Destroy();
+			}
+			return;
+		}
+
+		if (!Generator)
+		{
+			FActorSpawnParameters Params;
+			Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+			Generator = World->SpawnActor<ATrialStressMapGenerator>(ATrialStressMapGenerator::StaticClass(), FTransform(TrialStressMap::RuntimeOrigin), Params);
+			if (!Generator) return;
+		}
+
+		Generator->ObstacleCount = Count;
+		Generator->Seed = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 1;
+		Generator->ObstacleActorClass = Args.Num() > 2 ? TSoftClassPtr<AActor>(FSoftObjectPath(Args[2])) : TSoftClassPtr<AActor>();
+		Generator->Generate();
+
+		APlayerController* PC = World->GetFirstPlayerController();
+		APawn* Pawn = PC ? PC->GetPawn() : nullptr;
+		if (Pawn && Generator->GetSpawnTransforms().Num() > 0)
+		{
+			const FTransform& Spawn = Generator->GetSpawnTransforms()[0];
+			Pawn->TeleportTo(Spawn.GetLocation(), Spawn.Rotator());
+		}
+	}));
@@ -0,0 +1,100 @@
+#include "TrialTaskLLM.h"
+
+#include "CustomCharacter.h"
+#include "CustomMovementComponent.h"
+#include "StaminaWidget.h"
+
+#include "Animation/AnimInstance.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+
+// --------------------
+// TrialTask.MemReport
+// Lines are prefixed with TRIALMEM and comma separated so nightly runs can grep/diff them.
+// --------------------
+
+namespace TrialTaskMemoryReport
+{
+	static int64 ObjectBytes(const UObject* Object)
+	{
+		return Object ? (int64)Object->GetResourceSizeBytes(EResourceSizeMode::Exclusive) : 0;
+	}
+
+	static int64 TagBytes(const TCHAR* TagName)
+	{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+		if (FLowLevelMemTracker::IsEnabled())
+		{
+			return FLowLevelMemTracker::Get().GetTagAmountForTracker(ELLMTracker::Default, FName(TagName), ELLMTagSet::None);
+		}
+#endif
+		return -1;
+	}
+
+	static void Run(const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World)
+		{
+			return;
+		}
+
+		const bool bVerbose = Args.Contains(TEXT("-pawns"));
+
+		int32 NumPawns = 0;
+		int64 TotalActor = 0;
+		int64 TotalMovement = 0;
+		int64 TotalAnim = 0;
+		int64 TotalHUD = 0;
+
+		for (TActorIterator<ACustomCharacter> It(World); It; ++It)
+		{
+			const ACustomCharacter* Pawn = *It;
+
+			int64 Actor = ObjectBytes(Pawn);
+			TInlineComponentArray<UActorComponent*> Components(Pawn);
+			for (const UActorComponent* Comp : Components)
+			{
+				if (!Comp->IsA<UCustomMovementComponent>())
+				{
+					Actor += ObjectBytes(Comp);
+				}
+			}
+
+			const int64 Movement = ObjectBytes(Pawn->GetCharacterMovement());
+			const int64 Anim = ObjectBytes(Pawn->GetMesh() ? Pawn->GetMesh()->GetAnimInstance() : nullptr);
+			const int64 HUD = ObjectBytes(Pawn->StaminaWidget);
+
+			if (bVerbose)
+			{
+				UE_LOG(LogTemp, Display, TEXT("TRIALMEM,Pawn,%s,Actor=%lld,Movement=%lld,Anim=%lld,HUD=%lld,Total=%lld"),
+					*Pawn->GetName(), Actor, Movement, Anim, HUD, Actor + Movement + Anim + HUD);
+			}
+
+			++NumPawns;
+			TotalActor += Actor;
+			TotalMovement += Movement;
+			TotalAnim += Anim;
+			TotalHUD += HUD;
+		}
+
+		const int64 Total = TotalActor + TotalMovement + TotalAnim + TotalHUD;
+		const int64 PerPawn = NumPawns > 0 ? Total / NumPawns : 0;
+
+		UE_LOG(LogTemp, Display, TEXT("TRIALMEM,Objects,Pawns=%d,Actor=%lld,Movement=%lld,Anim=%lld,HUD=%lld,Total=%lld,PerPawn=%lld"),
+			NumPawns, TotalActor, TotalMovement, TotalAnim, TotalHUD, Total, PerPawn);
+
+		for (const TCHAR* TagName : TrialTaskLLM::AllTagNames)
+		{
+			const int64 Bytes = TagBytes(TagName);
+			UE_LOG(LogTemp, Display, TEXT("TRIALMEM,LLM,%s,%lld,PerPawn=%lld"),
+				TagName, Bytes, (Bytes >= 0 && NumPawns > 0) ? Bytes / NumPawns : Bytes);
+		}
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CmdTrialTaskMemReport(
+	TEXT("TrialTask.MemReport"),
+	TEXT("Prints per-subsystem memory of the TrialTask module (LLM tags, needs -llm) and object sizes per pawn. Add -pawns for one line per pawn."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&TrialTaskMemoryReport::Run));
@@ -0,0 +1,350 @@
+#include "TrialTuningSweep.h"
+
+#include "CustomCharacter.h"
+#include "CustomMovementComponent.h"
+#include "TrialSlideSurfaces.h"
+
+#include "Components/CapsuleComponent.h"
+
+namespace TrialTuningSweep
+{
+	static const FTrialSlideFixture SlideFixtures[] =
+	{
+		// Name				Slope	Ramp	Target	Wall
+		{ TEXT("Flat"),				0.f,	0.f,	350.f,	0.f },
+		{ TEXT("Gentle10"),			10.f,	1200.f,	1000.f,	0.f },
+		{ TEXT("Medium20"),			20.f,	1500.f,	1800.f,	0.f },
+		{ TEXT("Steep35RunOut"),	35.f,	800.f,	1200.f,	2600.f },
+		{ TEXT("Uphill8"),			-8.f,	2000.f,	250.f,	0.f },
+	};
+
+	static const FTrialObstacleFixture ObstacleFixtures[] =
+	{
+		// Name				Height	Depth	Ceiling	HasTop
+		{ TEXT("Wall130"),			130.f,	40.f,	0.f,	false },
+		{ TEXT("Box150Deep"),		150.f,	200.f,	0.f,	false },
+		{ TEXT("Ledge200"),			200.f,	150.f,	0.f,	true },
+		{ TEXT("Ledge210Overhang"),	210.f,	150.f,	395.f,	false },
+		{ TEXT("Wall260"),			260.f,	100.f,	0.f,	false },
+	};
+
+	// UCustomMovementComponent properties StepSlideVelocity reads, plus the start speeds of the sweep
+	static const TCHAR* const SlideTuningNames[] =
+	{
+		TEXT("SlideSlopeAngleMinDeg"), TEXT("SlideMinSpeedToKeep"), TEXT("SlideSteerAccel"), TEXT("SlideDownhillAccel"),
+		TEXT("SlideUphillDecel"), TEXT("SlideFlatDecel"), TEXT("SlideMaxSpeedDownhill"), TEXT("SlideMaxSpeedFlat"),
+		TEXT("SlideMinStartSpeed"), TEXT("SprintSpeed"),
+	};
+
+	// ACustomCharacter properties of FTrialTraversalTuning (the capsule comes from the component)
+#define TRIAL_TRAVERSAL_TUNING(X) \
+	X(ParkourFrontCheckDistance) X(ParkourFrontCheckRadius) X(ParkourTopTraceHeight) \
+	X(VaultMaxObstacleHeight) X(MantleMaxObstacleHeight) \
+	X(ParkourLandForwardOffset) X(ParkourLandUpOffset) X(ParkourLandingForwardExtra) X(ParkourLandingCapsuleInflate) \
+	X(VaultToApexDuration) X(VaultToTargetDuration) X(MantleToApexDuration) X(MantleToTargetDuration) \
+	X(ApexForwardExtra) X(ApexUpExtra) X(MoveStepFallbackUp) X(MoveStepFallbackForward)
+
+#define TRIAL_TUNING_NAME(Member) TEXT(#Member),
+	static const TCHAR* const TraversalTuningNames[] = { TRIAL_TRAVERSAL_TUNING(TRIAL_TUNING_NAME) };
+#undef TRIAL_TUNING_NAME
+
+	static bool IsNamed(TConstArrayView<const TCHAR* const> Names, FName Property)
+	{
+		for (const TCHAR* Name : Names)
+		{
+			if (Property == FName(Name)) return true;
+		}
+		return false;
+	}
+
+	// Grazing contact is not a block (the engine's sweeps keep a similar skin)
+	constexpr float ContactSkin = 0.5f;
+
+	static float ReadTuning(const ACustomCharacter& Character, const TCHAR* Name, const TMap<FName, float>& Overrides)
+	{
+		if (const float* Override = Overrides.Find(FName(Name)))
+		{
+			return *Override;
+		}
+		const FFloatProperty* Property = FindFProperty<FFloatProperty>(Character.GetClass(), Name);
+		return Property ? Property->GetPropertyValue_InContainer(&Character) : 0.f;
+	}
+
+	// Box across the lane in profile (X forward, Z up, ground at 0); the capsule starts centred on X = 0
+	struct FObstacleProfile
+	{
+		float Face = 0.f;
+		float Back = 0.f;
+		float Height = 0.f;
+		float Ceiling = 0.f;
+		float HalfHeight = 0.f;
+
+		// Capsule of Radius / HalfHeight centred at X, Z overlaps the box or the overhang above it
+		bool Overlaps(float X, float Z, float Radius) const
+		{
+			const float Core = FMath::Max(0.f, HalfHeight - Radius);
+			const float Dx = FMath::Max3(0.f, Face - X, X - Back);
+			const float Reach = FMath::Square(FMath::Max(0.f, Radius - ContactSkin));
+
+			const float DzBox = FMath::Max3(0.f, (Z - Core) - Height, -(Z + Core));
+			if (Dx * Dx + DzBox * DzBox < Reach) return true;
+
+			if (Ceiling > 0.f)
+			{
+				const float DzCeiling = FMath::Max(0.f, Ceiling - (Z + Core));
+				if (Dx * Dx + DzCeiling * DzCeiling < Reach) return true;
+			}
+			return false;
+		}
+	};
+}
+
+FTrialTraversalTuning FTrialTraversalTuning::FromCharacter(const ACustomCharacter& Character, const TMap<FName, float>& Overrides)
+{
+	using namespace TrialTuningSweep;
+
+	FTrialTraversalTuning Tuning;
+
+	if (const UCapsuleComponent* Capsule = Character.GetCapsuleComponent())
+	{
+		Tuning.CapsuleRadius = Capsule->GetUnscaledCapsuleRadius();
+		Tuning.CapsuleHalfHeight = Capsule->GetUnscaledCapsuleHalfHeight();
+	}
+
+#define TRIAL_READ_TUNING(Member) Tuning.Member = ReadTuning(Character, TEXT(#Member), Overrides);
+	TRIAL_TRAVERSAL_TUNING(TRIAL_READ_TUNING)
+#undef TRIAL_READ_TUNING
+#undef TRIAL_TRAVERSAL_TUNING
+
+	return Tuning;
+}
+
+bool TrialTuningSweep::IsSlideTuning(FName Property)
+{
+	return IsNamed(SlideTuningNames, Property);
+}
+
+bool TrialTuningSweep::IsTraversalTuning(FName Property)
+{
+	return IsNamed(TraversalTuningNames, Property);
+}
+
+TConstArrayView<FTrialSlideFixture> TrialTuningSweep::GetSlideFixtures()
+{
+	return MakeArrayView(SlideFixtures);
+}
+
+TConstArrayView<FTrialObstacleFixture> TrialTuningSweep::GetObstacleFixtures()
+{
+	return MakeArrayView(ObstacleFixtures);
+}
+
+// --------------------
+// SLIDE
+// --------------------
+
+FTrialSlideRun TrialTuningSweep::SimulateSlide(const UCustomMovementComponent& Move, const FTrialSlideFixture& Fixture, float StartSpeed, const FVector& SteerInput, float TickRate, float HorizonSeconds)
+{
+	FTrialSlideRun Run;
+
+	// CanStartSlide's speed rule (ground, stamina and the post-sprint grace are the player's business)
+	Run.bStarted = StartSpeed >= Move.SlideMinStartSpeed;
+	if (!Run.bStarted)
+	{
+		return Run;
+	}
+
+	const float Dt = 1.f / FMath::Max(1.f, TickRate);
+	const float SlopeRad = FMath::DegreesToRadians(Fixture.SlopeDeg);
+	const FVector RampNormal(FMath::Sin(SlopeRad), 0.f, FMath::Cos(SlopeRad));
+	const float WalkableZ = Move.GetWalkableFloorZ();
+	const FTrialSlideSurface Surface;
+
+	FVector2D Location = FVector2D::ZeroVector;
+	FVector Velocity(StartSpeed, 0.f, 0.f);
+
+	Run.End = ESlideTrajectoryEnd::Horizon;
+	float Time = 0.f;
+	for (; Time < HorizonSeconds; Time += Dt)
+	{
+		// The ramp extends behind the start, so an uphill slide that rolls back stays on it
+		const FVector FloorNormal = Location.X < Fixture.RampLength ? RampNormal : FVector::UpVector;
+
+		++Run.Queries;	// FindFloor
+		if (FloorNormal.Z < WalkableZ)
+		{
+			Run.End = ESlideTrajectoryEnd::LostFloor;
+			break;
+		}
+
+		if (!Move.StepSlideVelocity(Velocity, FloorNormal, Surface, SteerInput, Dt))
+		{
+			Run.End = ESlideTrajectoryEnd::Stopped;
+			break;
+		}
+
+		++Run.Queries;	// SafeMoveUpdatedComponent
+		Location += FVector2D(Velocity.X, Velocity.Y) * Dt;
+
+		if (Fixture.WallDistance > 0.f && Location.X >= Fixture.WallDistance)
+		{
+			Location.X = Fixture.WallDistance;
+			Run.End = ESlideTrajectoryEnd::Blocked;
+			break;
+		}
+	}
+
+	Run.TimeToStop = Time;
+	Run.Distance = Location.Size();
+	Run.bSuccess = Run.End == ESlideTrajectoryEnd::Stopped && Location.X >= Fixture.TargetDistance;
+	return Run;
+}
+
+// --------------------
+// TRAVERSAL
+// --------------------
+
+FTrialTraversalRun TrialTuningSweep::SimulateTraversal(const FTrialTraversalTuning& Tuning, const FTrialObstacleFixture& Fixture, float ApproachGap, float TickRate)
+{
+	FTrialTraversalRun Run;
+
+	const float Radius = Tuning.CapsuleRadius;
+	const float HalfHeight = Tuning.CapsuleHalfHeight;
+	const float Inflated = Radius + Tuning.ParkourLandingCapsuleInflate;
+
+	FObstacleProfile Box;
+	Box.Face = Radius + ApproachGap;
+	Box.Back = Box.Face + Fixture.Depth;
+	Box.Height = Fixture.Height;
+	Box.Ceiling = Fixture.CeilingHeight;
+	Box.HalfHeight = HalfHeight;
+
+	auto Fail = [&Run](const TCHAR* Reason)
+	{
+		Run.Outcome = ETrialTraversalOutcome::Failed;
+		Run.FailReason = Reason;
+		return Run;
+	};
+
+	// FindParkourObstacle: sphere sweep forward from above the capsule centre
+	++Run.Queries;
+	const float SweepZ = HalfHeight + ParkourQueryOffsets::FrontSweepUp;
+	const float SweepRadius = Tuning.ParkourFrontCheckRadius;
+	if (Tuning.ParkourFrontCheckDistance + SweepRadius < Box.Face || SweepZ - SweepRadius > Box.Height)
+	{
+		return Fail(TEXT("NoObstacle"));
+	}
+
+	if (!Fixture.bHasTop)
+	{
+		++Run.Queries;
+		const float ImpactZ = FMath::Min(SweepZ, Box.Height);
+		if (ImpactZ + Tuning.ParkourTopTraceHeight <= Box.Height)
+		{
+			return Fail(TEXT("NoTop"));
+		}
+	}
+
+	// DecideParkourType: heights are measured from the capsule centre
+	const float ObstacleHeight = Box.Height - HalfHeight;
+	Run.Type = ObstacleHeight <= Tuning.VaultMaxObstacleHeight ? EParkourType::Vault
+		: (ObstacleHeight <= Tuning.MantleMaxObstacleHeight ? EParkourType::Mantle : EParkourType::None);
+	if (Run.Type == EParkourType::None)
+	{
+		return Fail(TEXT("OutOfRange"));
+	}
+
+	// ComputeSafeParkourLanding: ground trace ahead of the top point, then a fit test and one forward fallback
+	++Run.Queries;
+	float TargetX = Box.Face + Radius + Tuning.ParkourLandForwardOffset + Tuning.ParkourLandingForwardExtra;
+	const float GroundZ = TargetX < Box.Back ? Box.Height : 0.f;
+	const float TargetZ = GroundZ + HalfHeight + Tuning.ParkourLandUpOffset;
+
+	++Run.Queries;
+	if (Box.Overlaps(TargetX, TargetZ, Inflated))
+	{
+		++Run.Fallbacks;
+		++Run.Queries;
+		TargetX += Radius * ParkourQueryOffsets::LandingFallbackRadiusScale;
+		if (Box.Overlaps(TargetX, TargetZ, Inflated))
+		{
+			return Fail(TEXT("LandingBlocked"));
+		}
+	}
+
+	// ComputeParkourApex_*: vaults never fit-test, mantles retry higher
+	const float ApexX = Box.Face + Radius + Tuning.ApexForwardExtra;
+	float ApexZ = Box.Height + HalfHeight + Tuning.ApexUpExtra;
+	if (Run.Type == EParkourType::Mantle)
+	{
+		++Run.Queries;
+		if (Box.Overlaps(ApexX, ApexZ, Inflated))
+		{
+			ApexZ += ParkourQueryOffsets::RetryUp;
+			++Run.Fallbacks;
+			++Run.Queries;
+			if (Box.Overlaps(ApexX, ApexZ, Inflated))
+			{
+				return Fail(TEXT("ApexBlocked"));
+			}
+		}
+	}
+
+	// ParkourMoveStep per tick over both phases; a blocked step tries up, then forward
+	const float Dt = 1.f / FMath::Max(1.f, TickRate);
+	const bool bVault = Run.Type == EParkourType::Vault;
+	const FVector2D Points[3] = { FVector2D(0.f, HalfHeight), FVector2D(ApexX, ApexZ), FVector2D(TargetX, TargetZ) };
+	const float Durations[2] =
+	{
+		FMath::Max(0.01f, bVault ? Tuning.VaultToApexDuration : Tuning.MantleToApexDuration),
+		FMath::Max(0.01f, bVault ? Tuning.VaultToTargetDuration : Tuning.MantleToTargetDuration)
+	};
+
+	for (int32 Phase = 0; Phase < 2; ++Phase)
+	{
+		float Elapsed = 0.f;
+		float Alpha = 0.f;
+		while (Alpha < 1.f)
+		{
+			Elapsed += Dt;
+			Run.Time += Dt;
+			Alpha = FMath::Clamp(Elapsed / Durations[Phase], 0.f, 1.f);
+			const FVector2D Desired = FMath::Lerp(Points[Phase], Points[Phase + 1], Alpha);
+
+			++Run.Queries;
+			if (!Box.Overlaps(Desired.X, Desired.Y, Radius))
+			{
+				continue;
+			}
+
+			// Blocked: the slide along the hit, then the up and forward fallbacks (one sweep each)
+			++Run.Queries;
+			++Run.Fallbacks;
+			++Run.Queries;
+			if (!Box.Overlaps(Desired.X, Desired.Y + Tuning.MoveStepFallbackUp, Radius))
+			{
+				continue;
+			}
+
+			++Run.Fallbacks;
+			++Run.Queries;
+			if (!Box.Overlaps(Desired.X + Tuning.MoveStepFallbackForward, Desired.Y, Radius))
+			{
+				continue;
+			}
+
+			++Run.Fallbacks;
+			if (!bVault)
+			{
+				// Recovery teleport onto the (already fit-tested) target
+				++Run.Queries;
+				Run.Outcome = ETrialTraversalOutcome::Recovered;
+				return Run;
+			}
+			return Fail(TEXT("MoveBlocked"));
+		}
+	}
+
+	Run.Outcome = ETrialTraversalOutcome::Success;
+	return Run;
+}
@@ -0,0 +1,371 @@
+#include "TrialTuningSweepCommandlet.h"
+
+#include "CustomCharacter.h"
+#include "CustomMovementComponent.h"
+#include "TrialTuningSweep.h"
+
+#include "Async/ParallelFor.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace TrialTuningSweepCommandlet
+{
+	static const TCHAR* DefaultGrid = TEXT("SlideDownhillAccel=600:1400:5,SlideSteerAccel=1800:3400:5,VaultToApexDuration=0.12:0.3:4,MantleToApexDuration=0.2:0.4:3");
+
+	// Slide variants per fixture: entry speed x steer. Steer 0 is the no-input baseline, the only one that can
+	// coast to a stop (steering accelerates every tick); the rest hold the stick at an angle off the lane.
+	static const float SteerAngles[] = { 0.f, 45.f, 90.f };
+	constexpr int32 NumSteers = 1 + UE_ARRAY_COUNT(SteerAngles);
+
+	static FVector SteerInput(int32 Steer)
+	{
+		if (Steer == 0) return FVector::ZeroVector;
+		const float SteerRad = FMath::DegreesToRadians(SteerAngles[Steer - 1]);
+		return FVector(FMath::Cos(SteerRad), FMath::Sin(SteerRad), 0.f);
+	}
+
+	// Traversal variants per fixture: gap between capsule and obstacle face at the press
+	static const float ApproachGaps[] = { 5.f, 30.f, 60.f, 90.f };
+	constexpr int32 NumGaps = UE_ARRAY_COUNT(ApproachGaps);
+
+	constexpr float SlideHorizonSeconds = 10.f;
+
+	struct FAxis
+	{
+		FName Name;
+		TArray<float> Values;
+	};
+
+	// "Name=Min:Max:Steps"
+	static bool ParseAxis(const FString& Spec, FAxis& OutAxis)
+	{
+		FString Name, Range;
+		if (!Spec.Split(TEXT("="), &Name, &Range)) return false;
+
+		TArray<FString> Parts;
+		Range.ParseIntoArray(Parts, TEXT(":"));
+		if (Parts.Num() != 3) return false;
+
+		const float Min = FCString::Atof(*Parts[0]);
+		const float Max = FCString::Atof(*Parts[1]);
+		const int32 Steps = FMath::Max(1, FCString::Atoi(*Parts[2]));
+
+		OutAxis.Name = FName(*Name.TrimStartAndEnd());
+		for (int32 i = 0; i < Steps; ++i)
+		{
+			OutAxis.Values.Add(Steps == 1 ? Min : FMath::Lerp(Min, Max, (float)i / (Steps - 1)));
+		}
+		return true;
+	}
+
+	// Cartesian product of the axes; one empty cell (the class defaults) without axes
+	static TArray<TMap<FName, float>> ExpandGrid(const TArray<FAxis>& Axes)
+	{
+		TArray<TMap<FName, float>> Cells;
+		Cells.AddDefaulted();
+		for (const FAxis& Axis : Axes)
+		{
+			TArray<TMap<FName, float>> Next;
+			Next.Reserve(Cells.Num() * Axis.Values.Num());
+			for (const TMap<FName, float>& Cell : Cells)
+			{
+				for (float Value : Axis.Values)
+				{
+					TMap<FName, float>& Expanded = Next.Add_GetRef(Cell);
+					Expanded.Add(Axis.Name, Value);
+				}
+			}
+			Cells = MoveTemp(Next);
+		}
+		return Cells;
+	}
+
+	static FString CellColumns(const TArray<FAxis>& Axes, const TMap<FName, float>& Cell, const TCHAR* Separator, bool bNames)
+	{
+		FString Out;
+		for (const FAxis& Axis : Axes)
+		{
+			Out += bNames ? FString::Printf(TEXT("%s=%g%s"), *Axis.Name.ToString(), Cell.FindRef(Axis.Name), Separator)
+				: FString::Printf(TEXT("%g%s"), Cell.FindRef(Axis.Name), Separator);
+		}
+		return Out;
+	}
+
+	static FString HeaderColumns(const TArray<FAxis>& Axes)
+	{
+		FString Out;
+		for (const FAxis& Axis : Axes)
+		{
+			Out += Axis.Name.ToString() + TEXT(",");
+		}
+		return Out;
+	}
+
+	struct FSlideRow
+	{
+		int32 Runs = 0;
+		int32 Started = 0;
+		int32 Successes = 0;
+		int32 Stopped = 0;
+		int32 Blocked = 0;
+		int32 Horizon = 0;
+		int32 LostFloor = 0;
+		double SumDistance = 0.0;
+		float MaxDistance = 0.f;
+		double SumTimeToStop = 0.0;
+		double SumQueries = 0.0;
+
+		void Add(const FTrialSlideRun& Run)
+		{
+			++Runs;
+			if (!Run.bStarted) return;
+
+			++Started;
+			Successes += Run.bSuccess ? 1 : 0;
+			Blocked += Run.End == ESlideTrajectoryEnd::Blocked ? 1 : 0;
+			LostFloor += Run.End == ESlideTrajectoryEnd::LostFloor ? 1 : 0;
+			Horizon += Run.End == ESlideTrajectoryEnd::Horizon ? 1 : 0;
+			SumDistance += Run.Distance;
+			MaxDistance = FMath::Max(MaxDistance, Run.Distance);
+			SumQueries += Run.Queries;
+			if (Run.End == ESlideTrajectoryEnd::Stopped)
+			{
+				++Stopped;
+				SumTimeToStop += Run.TimeToStop;
+			}
+		}
+
+		double SuccessRate() const { return Runs ? (double)Successes / Runs : 0.0; }
+		double AvgDistance() const { return Started ? SumDistance / Started : 0.0; }
+		double AvgTimeToStop() const { return Stopped ? SumTimeToStop / Stopped : 0.0; }
+		double AvgQueries() const { return Started ? SumQueries / Started : 0.0; }
+	};
+
+	struct FTraversalRow
+	{
+		int32 Runs = 0;
+		int32 Successes = 0;
+		int32 Recovered = 0;
+		int32 Vaults = 0;
+		int32 Mantles = 0;
+		double SumTime = 0.0;
+		double SumQueries = 0.0;
+		double SumFallbacks = 0.0;
+
+		void Add(const FTrialTraversalRun& Run)
+		{
+			++Runs;
+			Successes += Run.Outcome == ETrialTraversalOutcome::Success ? 1 : 0;
+			Recovered += Run.Outcome == ETrialTraversalOutcome::Recovered ? 1 : 0;
+			Vaults += Run.Outcome != ETrialTraversalOutcome::Failed && Run.Type == EParkourType::Vault ? 1 : 0;
+			Mantles += Run.Outcome != ETrialTraversalOutcome::Failed && Run.Type == EParkourType::Mantle ? 1 : 0;
+			if (Run.Outcome != ETrialTraversalOutcome::Failed)
+			{
+				SumTime += Run.Time;
+			}
+			SumQueries += Run.Queries;
+			SumFallbacks += Run.Fallbacks;
+		}
+
+		double SuccessRate() const { return Runs ? (double)Successes / Runs : 0.0; }
+		double RecoveredRate() const { return Runs ? (double)Recovered / Runs : 0.0; }
+		double AvgTime() const { return (Successes + Recovered) ? SumTime / (Successes + Recovered) : 0.0; }
+		// Every press pays for its queries, including the ones that find nothing to climb
+		double QueriesPerTraversal() const { return Runs ? SumQueries / Runs : 0.0; }
+		double FallbacksPerTraversal() const { return Runs ? SumFallbacks / Runs : 0.0; }
+	};
+}
+
+UTrialTuningSweepCommandlet::UTrialTuningSweepCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UTrialTuningSweepCommandlet::Main(const FString& Params)
+{
+	using namespace TrialTuningSweepCommandlet;
+
+	FString CharacterPath;
+	FString GridSpec = DefaultGrid;
+	FString OutDir = FPaths::ProjectSavedDir() / TEXT("TuningSweep");
+	float TickRate = 60.f;
+	FParse::Value(*Params, TEXT("Character="), CharacterPath);
+	FParse::Value(*Params, TEXT("Grid="), GridSpec, false);
+	FParse::Value(*Params, TEXT("Out="), OutDir);
+	FParse::Value(*Params, TEXT("Hz="), TickRate);
+
+	const UClass* CharacterClass = CharacterPath.IsEmpty() ? ACustomCharacter::StaticClass() : LoadClass<ACustomCharacter>(nullptr, *CharacterPath);
+	const ACustomCharacter* Character = CharacterClass ? CharacterClass->GetDefaultObject<ACustomCharacter>() : nullptr;
+	UCustomMovementComponent* MoveTemplate = Character ? Cast<UCustomMovementComponent>(Character->GetCharacterMovement()) : nullptr;
+	if (!MoveTemplate)
+	{
+		UE_LOG(LogTemp, Error, TEXT("SWEEP: %s is not a character with UCustomMovementComponent"), *CharacterPath);
+		return 1;
+	}
+
+	// Each axis belongs to the table whose model reads the property; anything else would only add identical rows
+	TArray<FAxis> SlideAxes;
+	TArray<FAxis> TraversalAxes;
+	TArray<FString> Specs;
+	GridSpec.ParseIntoArray(Specs, TEXT(","));
+	for (const FString& Spec : Specs)
+	{
+		FAxis Axis;
+		if (!ParseAxis(Spec, Axis))
+		{
+			UE_LOG(LogTemp, Error, TEXT("SWEEP: bad grid axis '%s' (expected Name=Min:Max:Steps)"), *Spec);
+			return 1;
+		}
+
+		if (TrialTuningSweep::IsSlideTuning(Axis.Name) && FindFProperty<FFloatProperty>(MoveTemplate->GetClass(), Axis.Name))
+		{
+			SlideAxes.Add(MoveTemp(Axis));
+		}
+		else if (TrialTuningSweep::IsTraversalTuning(Axis.Name) && FindFProperty<FFloatProperty>(CharacterClass, Axis.Name))
+		{
+			TraversalAxes.Add(MoveTemp(Axis));
+		}
+		else if (FindFProperty<FFloatProperty>(MoveTemplate->GetClass(), Axis.Name) || FindFProperty<FFloatProperty>(CharacterClass, Axis.Name))
+		{
+			UE_LOG(LogTemp, Error, TEXT("SWEEP: %s is not read by the slide or traversal model, sweeping it changes nothing"), *Axis.Name.ToString());
+			return 1;
+		}
+		else
+		{
+			UE_LOG(LogTemp, Error, TEXT("SWEEP: %s is not a float property of %s or its movement component"), *Axis.Name.ToString(), *CharacterClass->GetName());
+			return 1;
+		}
+	}
+
+	const TArray<TMap<FName, float>> SlideCells = ExpandGrid(SlideAxes);
+	const TArray<TMap<FName, float>> TraversalCells = ExpandGrid(TraversalAxes);
+	const TConstArrayView<FTrialSlideFixture> SlideFixtures = TrialTuningSweep::GetSlideFixtures();
+	const TConstArrayView<FTrialObstacleFixture> ObstacleFixtures = TrialTuningSweep::GetObstacleFixtures();
+
+	// Game thread: one configured movement component per slide cell. Workers only call its const StepSlideVelocity.
+	TArray<TStrongObjectPtr<UCustomMovementComponent>> Moves;
+	for (const TMap<FName, float>& Cell : SlideCells)
+	{
+		UCustomMovementComponent* Move = NewObject<UCustomMovementComponent>(GetTransientPackage(), MoveTemplate->GetClass(), NAME_None, RF_Transient, MoveTemplate);
+		for (const TPair<FName, float>& Value : Cell)
+		{
+			FindFProperty<FFloatProperty>(Move->GetClass(), Value.Key)->SetPropertyValue_InContainer(Move, Value.Value);
+		}
+		Moves.Emplace(Move);
+	}
+
+	TArray<FTrialTraversalTuning> Tunings;
+	for (const TMap<FName, float>& Cell : TraversalCells)
+	{
+		Tunings.Add(FTrialTraversalTuning::FromCharacter(*Character, Cell));
+	}
+
+	constexpr int32 NumSpeeds = 2;	// SlideMinStartSpeed, SprintSpeed
+	const int32 SlideVariants = NumSpeeds * NumSteers;
+	const int32 SlidePerCell = SlideFixtures.Num() * SlideVariants;
+	const int32 TraversalVariants = NumGaps;
+	const int32 TraversalPerCell = ObstacleFixtures.Num() * TraversalVariants;
+
+	TArray<FTrialSlideRun> SlideRuns;
+	TArray<FTrialTraversalRun> TraversalRuns;
+	SlideRuns.SetNum(SlideCells.Num() * SlidePerCell);
+	TraversalRuns.SetNum(TraversalCells.Num() * TraversalPerCell);
+
+	const double StartSeconds = FPlatformTime::Seconds();
+
+	ParallelFor(SlideRuns.Num(), [&](int32 Index)
+	{
+		const int32 Cell = Index / SlidePerCell;
+		const int32 Fixture = (Index % SlidePerCell) / SlideVariants;
+		const int32 Variant = Index % SlideVariants;
+
+		const UCustomMovementComponent& Move = *Moves[Cell];
+		const float StartSpeed = (Variant / NumSteers) == 0 ? Move.SlideMinStartSpeed : Move.SprintSpeed;
+
+		SlideRuns[Index] = TrialTuningSweep::SimulateSlide(Move, SlideFixtures[Fixture], StartSpeed, SteerInput(Variant % NumSteers), TickRate, SlideHorizonSeconds);
+	});
+
+	ParallelFor(TraversalRuns.Num(), [&](int32 Index)
+	{
+		const int32 Cell = Index / TraversalPerCell;
+		const int32 Fixture = (Index % TraversalPerCell) / TraversalVariants;
+		const float Gap = ApproachGaps[Index % TraversalVariants];
+
+		TraversalRuns[Index] = TrialTuningSweep::SimulateTraversal(Tunings[Cell], ObstacleFixtures[Fixture], Gap, TickRate);
+	});
+
+	const double SimSeconds = FPlatformTime::Seconds() - StartSeconds;
+
+	// Slide table: per cell and fixture, one row for the no-input baseline and one for the steered runs, which
+	// never stop (SuccessRate and AvgTimeToStop only mean something for the baseline); one log line per cell
+	TArray<FString> SlideCsv;
+	SlideCsv.Add(HeaderColumns(SlideAxes) + TEXT("Fixture,Steer,Runs,SuccessRate,AvgDistance,MaxDistance,AvgTimeToStop,AvgQueries,Stopped,Blocked,LostFloor,Horizon"));
+	for (int32 Cell = 0; Cell < SlideCells.Num(); ++Cell)
+	{
+		FSlideRow CellRows[2];
+		for (int32 Fixture = 0; Fixture < SlideFixtures.Num(); ++Fixture)
+		{
+			FSlideRow Rows[2];
+			for (int32 Variant = 0; Variant < SlideVariants; ++Variant)
+			{
+				const FTrialSlideRun& Run = SlideRuns[Cell * SlidePerCell + Fixture * SlideVariants + Variant];
+				const int32 Steered = (Variant % NumSteers) != 0 ? 1 : 0;
+				Rows[Steered].Add(Run);
+				CellRows[Steered].Add(Run);
+			}
+
+			for (int32 Steered = 0; Steered < 2; ++Steered)
+			{
+				const FSlideRow& Row = Rows[Steered];
+				SlideCsv.Add(CellColumns(SlideAxes, SlideCells[Cell], TEXT(","), false) + FString::Printf(TEXT("%s,%s,%d,%.3f,%.1f,%.1f,%.3f,%.1f,%d,%d,%d,%d"),
+					SlideFixtures[Fixture].Name, Steered ? TEXT("Steered") : TEXT("None"), Row.Runs, Row.SuccessRate(), Row.AvgDistance(), Row.MaxDistance,
+					Row.AvgTimeToStop(), Row.AvgQueries(), Row.Stopped, Row.Blocked, Row.LostFloor, Row.Horizon));
+			}
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("SLIDESWEEP,%sSuccessRate=%.3f,AvgDistance=%.1f,AvgTimeToStop=%.3f,AvgQueries=%.1f,SteeredAvgDistance=%.1f,SteeredAvgQueries=%.1f"),
+			*CellColumns(SlideAxes, SlideCells[Cell], TEXT(","), true), CellRows[0].SuccessRate(), CellRows[0].AvgDistance(), CellRows[0].AvgTimeToStop(), CellRows[0].AvgQueries(),
+			CellRows[1].AvgDistance(), CellRows[1].AvgQueries());
+	}
+
+	TArray<FString> TraversalCsv;
+	TraversalCsv.Add(HeaderColumns(TraversalAxes) + TEXT("Obstacle,Runs,SuccessRate,RecoveredRate,AvgTime,QueriesPerTraversal,FallbacksPerTraversal,Vaults,Mantles"));
+	for (int32 Cell = 0; Cell < TraversalCells.Num(); ++Cell)
+	{
+		FTraversalRow CellRow;
+		for (int32 Fixture = 0; Fixture < ObstacleFixtures.Num(); ++Fixture)
+		{
+			FTraversalRow Row;
+			for (int32 Variant = 0; Variant < TraversalVariants; ++Variant)
+			{
+				const FTrialTraversalRun& Run = TraversalRuns[Cell * TraversalPerCell + Fixture * TraversalVariants + Variant];
+				Row.Add(Run);
+				CellRow.Add(Run);
+			}
+
+			TraversalCsv.Add(CellColumns(TraversalAxes, TraversalCells[Cell], TEXT(","), false) + FString::Printf(TEXT("%s,%d,%.3f,%.3f,%.3f,%.2f,%.2f,%d,%d"),
+				ObstacleFixtures[Fixture].Name, Row.Runs, Row.SuccessRate(), Row.RecoveredRate(), Row.AvgTime(), Row.QueriesPerTraversal(), Row.FallbacksPerTraversal(), Row.Vaults, Row.Mantles));
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("TRAVERSALSWEEP,%sSuccessRate=%.3f,RecoveredRate=%.3f,AvgTime=%.3f,QueriesPerTraversal=%.2f"),
+			*CellColumns(TraversalAxes, TraversalCells[Cell], TEXT(","), true), CellRow.SuccessRate(), CellRow.RecoveredRate(), CellRow.AvgTime(), CellRow.QueriesPerTraversal());
+	}
+
+	const FString SlidePath = OutDir / TEXT("SlideSweep.csv");
+	const FString TraversalPath = OutDir / TEXT("TraversalSweep.csv");
+	const bool bSaved = FFileHelper::SaveStringArrayToFile(SlideCsv, *SlidePath) && FFileHelper::SaveStringArrayToFile(TraversalCsv, *TraversalPath);
+
+	UE_LOG(LogTemp, Display, TEXT("SWEEP,SlideRuns=%d,TraversalRuns=%d,SimSeconds=%.3f,Slide=%s,Traversal=%s"),
+		SlideRuns.Num(), TraversalRuns.Num(), SimSeconds, *SlidePath, *TraversalPath);
+
+	if (!bSaved)
+	{
+		UE_LOG(LogTemp, Error, TEXT("SWEEP: cannot write the tables to %s"), *OutDir);
+		return 1;
+	}
+	return 0;
+}
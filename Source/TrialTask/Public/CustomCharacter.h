@@ -3,6 +3,12 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "InputActionValue.h"
+#include "ParkourFlightRecorder.h"
+#include "ParkourPoseHistory.h"
+#include "TrialInputRecording.h"
+#include "TrialInputTarget.h"
+#include "TraversalNetState.h"
+#include "TraversalStateMachine.h"
 #include "CustomCharacter.generated.h"
 
 class UCameraComponent;
@@ -11,25 +17,24 @@ class UInputMappingContext;
 class UInputAction;
 class UAnimMontage;
 class UStaminaWidget;
+class UTrialPredictiveStreamingComponent;
+struct FTrialParkourObstacleInfo;
 
-UENUM(BlueprintType)
-enum class EParkourType : uint8
+// Fixed offsets of the parkour queries. The Mover backend and the tuning sweep model the same queries, so they read these too.
+namespace ParkourQueryOffsets
 {
-	None,
-	Vault,
-	Mantle
-};
+	// FindParkourObstacle sweeps forward from this far above the capsule centre
+	constexpr float FrontSweepUp = 50.f;
 
-UENUM()
-enum class EParkourPhase : uint8
-{
-	None,
-	ToApex,
-	ToTarget
-};
+	// ComputeSafeParkourLanding's forward fallback, as a fraction of the capsule radius
+	constexpr float LandingFallbackRadiusScale = 0.75f;
+
+	// How much higher the blocked mantle apex and the stuck-traversal recovery retry
+	constexpr float RetryUp = 20.f;
+}
 
 UCLASS()
-class TRIALTASK_API ACustomCharacter : public ACharacter
+class TRIALTASK_API ACustomCharacter : public ACharacter, public ITrialInputTarget
 {
 	GENERATED_BODY()
 
@@ -136,6 +141,17 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour|Safety")
 	float ParkourFailSafeExtraTime = 0.25f;
 
+	// --------------------
+	// Server validation of client traversal starts
+	// --------------------
+	// How far back the server rewinds to the client's timestamp
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour|Network")
+	float ParkourMaxRewindSeconds = 0.3f;
+
+	// Slack on every distance / height check (quantization, interpolation error)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour|Network")
+	float ParkourValidationTolerance = 25.f;
+
 	// --------------------
 	// Anim support
 	// --------------------
@@ -143,18 +159,57 @@ public:
 	bool bJumpRequested = false;
 
 	UFUNCTION(BlueprintCallable, Category = "Parkour")
-	bool IsParkouring() const { return bIsParkouring; }
+	bool IsParkouring() const { return GetTraversalModeState().IsTraversing(); }
 
 	UFUNCTION(BlueprintCallable, Category = "Parkour")
-	bool IsVaulting() const { return bIsVaulting; }
+	bool IsVaulting() const { return GetTraversalModeState().IsVaulting(); }
 
 	UFUNCTION(BlueprintCallable, Category = "Parkour")
-	bool IsMantling() const { return bIsMantling; }
+	bool IsMantling() const { return GetTraversalModeState().IsMantling(); }
+
+	// Movement / traversal mode, owned by the movement component (default state without one)
+	FPackedTraversalState GetTraversalModeState() const;
+
+	// --------------------
+	// Input injection (same handlers as Enhanced Input)
+	// --------------------
+	// X = right axis, Y = forward axis
+	virtual void InjectMoveInput(const FVector2D& Axes) override;
+	virtual void InjectLookInput(const FVector2D& Axes) override;
+	virtual void InjectAction(ETrialInputAction Action, bool bPressed) override;
+
+	virtual bool IsSprintActive() const override;
+	virtual bool IsSlideActive() const override;
+	virtual bool IsTraversalActive() const override { return IsParkouring(); }
+
+	// --------------------
+	// Input record / replay
+	// --------------------
+	bool StartInputRecording();
+	bool StopInputRecording(const FString& Path);
+	bool IsRecordingInput() const { return InputRecorder.IsValid(); }
+
+	FTrialReplayInitialState CaptureReplayState() const;
+	void ApplyReplayState(const FTrialReplayInitialState& State);
+
+	// --------------------
+	// Pooling (UTrialCharacterPool)
+	// --------------------
+	// Back to the freshly spawned state: traversal, slide, sprint, stamina, crouch, montages, recorders
+	void ResetForPool();
+
+	// Local player setup (mapping context, HUD). Idempotent; runs on BeginPlay and on every local possession.
+	void SetupLocalPlayerFeatures();
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 	virtual void SetupPlayerInputComponent(UInputComponent* PlayerInputComponent) override;
 	virtual void Tick(float DeltaSeconds) override;
+	virtual void PostNetReceiveLocationAndRotation() override;
+	virtual void PawnClientRestart() override;
+	virtual void NotifyControllerChanged() override;
 
 	// Movement input
 	void MoveForward(const FInputActionValue& Value);
@@ -167,16 +222,21 @@ protected:
 	void CrouchPressed(const FInputActionValue& Value);
 	void CrouchReleased(const FInputActionValue& Value);
 
+	// Jump input (wrapped so record/replay sees the edges)
+	void JumpPressed(const FInputActionValue& Value);
+	void JumpReleased(const FInputActionValue& Value);
+
 	// Parkour input
 	void ParkourPressed(const FInputActionValue& Value);
 
 	// Detection
-	bool FindParkourObstacle(FHitResult& OutFrontHit, FHitResult& OutTopHit, float& OutObstacleHeight, FVector& OutTopPoint) const;
-	EParkourType DecideParkourType(float ObstacleHeight) const;
+	bool FindParkourObstacle(FHitResult& OutFrontHit, FHitResult& OutTopHit, float& OutObstacleHeight, FVector& OutTopPoint, FTrialParkourObstacleInfo& OutInfo) const;
+	EParkourType DecideParkourType(float ObstacleHeight, const FTrialParkourObstacleInfo& Info) const;
 	bool ComputeSafeParkourLanding(const FHitResult& FrontHit, const FVector& TopPoint, FVector& OutSafeLocation) const;
 
 	// Run
 	bool StartParkour(EParkourType Type, const FVector& TargetLocation, const FVector& TopPoint);
+	bool BeginParkourMove(EParkourType Type, const FVector& Apex, const FVector& TargetLocation, const FVector& TopPoint);
 	void EndParkour(bool bInterrupted, bool bForce = false);
 
 	UFUNCTION()
@@ -185,36 +245,33 @@ protected:
 	UFUNCTION()
 	void OnParkourMontageBlendOut(UAnimMontage* Montage, bool bInterrupted);
 
-private:
-	UPROPERTY(VisibleAnywhere)
-	TObjectPtr<UCameraComponent> FirstPersonCamera;
+	// Owning client -> server: a traversal the client already started. ClientTime is the client's estimate of server world time.
+	// StartId numbers the client's starts so a reject can be matched to the traversal it is about.
+	UFUNCTION(Server, Reliable)
+	void ServerStartParkour(EParkourType Type, AActor* Obstacle, FVector_NetQuantize TopPoint, FVector_NetQuantize Apex, FVector_NetQuantize Target, double ClientTime, uint16 StartId);
 
-	UPROPERTY(Transient)
-	TObjectPtr<UCustomMovementComponent> CustomMoveComp;
+	// Server -> owning client: start StartId did not happen on the server (failed validation, busy, or could not begin)
+	UFUNCTION(Client, Reliable)
+	void ClientRejectParkour(uint16 StartId);
 
-	// states
-	UPROPERTY(Transient)
-	bool bIsParkouring = false;
-
-	UPROPERTY(Transient)
-	bool bIsVaulting = false;
+	// Rewinds to ClientTime and confirms the traversal with bounds math and one capsule fit test at the target
+	bool ValidateParkourStart(EParkourType Type, const AActor* Obstacle, const FVector& TopPoint, const FVector& Apex, const FVector& Target, double ClientTime, const TCHAR*& OutReason) const;
 
-	UPROPERTY(Transient)
-	bool bIsMantling = false;
+private:
+	UPROPERTY(VisibleAnywhere)
+	TObjectPtr<UCameraComponent> FirstPersonCamera;
 
-	UPROPERTY(Transient)
-	bool bInputLocked = false;
+	// Streams cells ahead of fast slides and sprints (World Partition maps only)
+	UPROPERTY(VisibleAnywhere)
+	TObjectPtr<UTrialPredictiveStreamingComponent> PredictiveStreaming;
 
 	UPROPERTY(Transient)
-	EParkourType CurrentParkour = EParkourType::None;
+	TObjectPtr<UCustomMovementComponent> CustomMoveComp;
 
 	UPROPERTY(Transient)
 	TObjectPtr<UAnimMontage> CurrentParkourMontage = nullptr;
 
-	// geometric move
-	UPROPERTY(Transient)
-	EParkourPhase ParkourPhase = EParkourPhase::None;
-
+	// geometric move (type and phase are in the traversal mode)
 	UPROPERTY(Transient)
 	FVector ParkourStart = FVector::ZeroVector;
 
@@ -224,6 +281,10 @@ private:
 	UPROPERTY(Transient)
 	FVector ParkourTarget = FVector::ZeroVector;
 
+	// obstacle top the traversal was computed from (replicated points are relative to it)
+	UPROPERTY(Transient)
+	FVector ParkourObstacleTop = FVector::ZeroVector;
+
 	UPROPERTY(Transient)
 	float PhaseElapsed = 0.f;
 
@@ -236,6 +297,9 @@ private:
 	// apex transition
 	bool bVaultApexNoFit = true;
 
+	// Owning client: id of the last traversal start sent to the server
+	uint16 ParkourStartId = 0;
+
 	// Fallbacks tuning ( MANTLE )
 	UPROPERTY(EditAnywhere, Category = "Parkour|Move")
 	float MoveStepBlockAbortTime = 0.03f; 
@@ -247,14 +311,64 @@ private:
 	float MoveStepFallbackForward = 18.f;
 
 
-	// Failsafe
+	// Failsafe: a world timer, so it still fires when actor tick (which drives the phase move) is off
 	FTimerHandle ParkourFailsafeTimer;
 
+	void OnParkourFailsafe();
+
+	// Query params built once in BeginPlay (constructing them per query allocates)
+	FCollisionQueryParams FrontQueryParams;
+	FCollisionQueryParams LandQueryParams;
+	FCollisionQueryParams ApexQueryParams;
+	FCollisionQueryParams FitQueryParams;
+
+	void InitQueryParams();
+
+	// Server: recent capsule poses of remotely controlled pawns, for rewinding traversal starts
+	FParkourPoseHistory PoseHistory;
+
+	// Flight recorder (structured failure context, dumped only on failure/failsafe)
+	mutable FParkourFlightRecorder FlightRecorder;
+
+	void DumpFlightRecorder(EParkourTraceDumpReason Reason) const;
+
+	// Active only while recording
+	TUniquePtr<FTrialInputRecorder> InputRecorder;
+
+	// Bit per ETrialInputAction currently held, kept whether recording or not (a recording can start mid-hold)
+	uint8 HeldActionMask = 0;
+
+	// Every action edge goes through here: held mask, then the recorder if one is active
+	void NoteAction(ETrialInputAction Action, bool bPressed);
+
+	// Server: last activity reported to the replication graph (idle pawns replicate less often)
+	bool bReplicationActive = true;
+
+	void UpdateReplicationActivity();
+
+	// Server -> simulated proxies: quantized mode bits, stamina and traversal points
+	UPROPERTY(ReplicatedUsing = OnRep_TraversalState)
+	FTraversalNetState TraversalState;
+
+	bool bCountedInNetStats = false;
+
+	void UpdateTraversalNetState();
+
+	UFUNCTION()
+	void OnRep_TraversalState();
+
+	// Simulated proxies: traversal replayed from TraversalState along the replicated points (no scene queries).
+	// Replicated movement is ignored meanwhile so it doesn't fight the interpolation.
+	bool bProxyTraversal = false;
+
+	void TickSimulatedTraversal(float DeltaSeconds);
+
 	void SetInputLocked(bool bLocked);
 
 	// Step movement
 	bool ParkourMoveStep(float DeltaSeconds, const FVector& From, const FVector& To, float Duration);
 	void AdvanceParkourPhase();
+	float GetParkourPhaseDuration(EParkourType Type, EParkourPhase Phase) const;
 
 	bool ComputeParkourApex_Vault(const FVector& TopPoint, FVector& OutApex) const;
 	bool ComputeParkourApex_Mantle(const FVector& TopPoint, FVector& OutApex) const;
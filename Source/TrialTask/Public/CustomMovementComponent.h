@@ -2,6 +2,9 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "SlideTrajectoryPredictor.h"
+#include "TraversalStateMachine.h"
+#include "TrialSlideSurfaces.h"
 #include "CustomMovementComponent.generated.h"
 
 UENUM()
@@ -61,6 +64,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Movement|Stamina")
 	float GetStamina() const { return Stamina; }
 
+	UFUNCTION(BlueprintCallable, Category = "Movement|Stamina")
+	void SetStamina(float InStamina) { Stamina = FMath::Clamp(InStamina, 0.f, StaminaMax); }
+
 	UFUNCTION(BlueprintCallable, Category = "Movement|Stamina")
 	float GetStaminaNormalized() const { return (StaminaMax > 0.f) ? (Stamina / StaminaMax) : 0.f; }
 
@@ -68,7 +74,7 @@ public:
 	// Sprint
 	// --------------------
 	UFUNCTION(BlueprintCallable, Category = "Movement|Sprint")
-	bool IsSprinting() const { return bIsSprinting; }
+	bool IsSprinting() const { return PackedState.IsSprinting(); }
 
 	UFUNCTION(BlueprintCallable, Category = "Movement|Sprint")
 	void SetSprintRequested(bool bRequested);
@@ -116,8 +122,11 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|Slide")
 	float PostSprintSlideGraceTime = 0.25f;
 
+	// Fraction of SlideMinStartSpeed that still starts a slide inside the grace window (shared with the deterministic and Mover sims)
+	static constexpr float PostSprintSlideGraceSpeedScale = 0.85f;
+
 	UFUNCTION(BlueprintCallable, Category = "Movement|Slide")
-	bool IsSliding() const { return bIsSliding; }
+	bool IsSliding() const { return PackedState.IsSliding(); }
 
 	UFUNCTION(BlueprintCallable, Category = "Movement|Slide")
 	bool CanStartSlide() const;
@@ -128,11 +137,43 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Movement|Slide")
 	void StopSlide();
 
+	// Per-physical-material multipliers of the slide tuning; unlisted materials slide with the tuning as is
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement|Slide")
+	TObjectPtr<UTrialSlideSurfaceTable> SlideSurfaces;
+
+	// Rebuilds the resolved surface table after SlideSurfaces changed at runtime
+	void RebuildSlideSurfaces();
+
+	const FTrialSlideSurfaceCache& GetSlideSurfaceCache() const { return SlideSurfaceCache; }
+
+	// One PhysSlide velocity step on a floor with FloorNormal. False once the slide is too slow to keep.
+	bool StepSlideVelocity(FVector& InOutVelocity, const FVector& FloorNormal, const FTrialSlideSurface& Surface, const FVector& SteerInput, float DeltaTime) const;
+
+	// Advances Predictor along the current slide (resets it while not sliding). Returns true once the trajectory has ended.
+	bool UpdateSlidePrediction(FSlideTrajectoryPredictor& Predictor, float DeltaSeconds, int32 FloorQueryBudget) const;
+
 	// --------------------
 	// Crouch helper (states only)
 	// --------------------
 	UFUNCTION(BlueprintCallable, Category = "Movement|Crouch")
-	void SetCrouchRequested(bool bRequested) { bCrouchRequested = bRequested; }
+	void SetCrouchRequested(bool bRequested) { PackedState.SetCrouchRequested(bRequested); }
+
+	// --------------------
+	// Traversal state (sprint / slide / vault / mantle, one byte)
+	// --------------------
+	const FPackedTraversalState& GetTraversalState() const { return PackedState; }
+
+	// Runs Event through the transition table; leaving sprint or slide applies their side effects. False if refused.
+	bool ApplyTraversalEvent(ETraversalEvent Event);
+
+	void SetTraversalInputLocked(bool bLocked) { PackedState.SetInputLocked(bLocked); }
+
+	// Simulated proxies: mirror the server's mode for animation (no movement side effects)
+	void SetReplicatedTraversalMode(ETraversalMode Mode) { PackedState.SetReplicatedMode(Mode); }
+
+	// Back to the freshly spawned state (pooled characters): ends any slide, clears sprint / crouch requests,
+	// refills stamina and stops all motion
+	void ResetTraversalState();
 
 protected:
 	virtual void BeginPlay() override;
@@ -145,24 +186,27 @@ private:
 	UPROPERTY(Transient)
 	float Stamina = 100.0f;
 
-	UPROPERTY(Transient)
-	bool bIsSprinting = false;
+	// Mode, crouch request and input lock; only changed through ApplyTraversalEvent
+	FPackedTraversalState PackedState;
 
 	UPROPERTY(Transient)
 	bool bSprintRequested = false;
 
-	UPROPERTY(Transient)
-	bool bIsSliding = false;
-
-	UPROPERTY(Transient)
-	bool bCrouchRequested = false;
-
 	UPROPERTY(Transient)
 	float TimeSinceSprintEnded = 999.0f;
 
 	float DefaultGroundFriction = 8.0f;
 	float DefaultBrakingDecel = 2048.0f;
 
+	FTrialSlideSurfaceCache SlideSurfaceCache;
+
+	// Surface of the floor PhysSlide last stood on; only re-resolved when the floor component changes
+	TObjectKey<UPrimitiveComponent> SlideFloorComponent;
+	uint8 SlideSurfaceIndex = FTrialSlideSurfaceCache::DefaultIndex;
+
+	// Trial.Slide.PredictDebug only
+	TUniquePtr<FSlideTrajectoryPredictor> DebugSlidePrediction;
+
 	void UpdateStamina(float DeltaTime);
 	void UpdateMaxSpeed();
 
@@ -170,4 +214,8 @@ private:
 	void ExitSlide();
 
 	void PhysSlide(float DeltaTime, int32 Iterations);
+
+	void DrawSlidePrediction(float DeltaTime);
+
+	bool IsSimulatedProxy() const;
 };
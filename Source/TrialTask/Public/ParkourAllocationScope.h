@@ -0,0 +1,77 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#ifndef PARKOUR_ALLOC_TRACKING
+#define PARKOUR_ALLOC_TRACKING !UE_BUILD_SHIPPING
+#endif
+
+#if PARKOUR_ALLOC_TRACKING
+
+namespace ParkourAlloc
+{
+	// Puts a counting proxy in front of GMalloc when the process runs with -ParkourAllocCheck.
+	// Module startup only: swapping the allocator under a running game is not safe.
+	TRIALTASK_API void InstallCountingMallocIfRequested();
+
+	TRIALTASK_API bool IsCountingMallocInstalled();
+}
+
+// Per call-site totals for one hot path
+struct TRIALTASK_API FParkourAllocSite
+{
+	const TCHAR* Name;
+	uint64 Calls = 0;
+	uint64 Allocations = 0;
+	uint64 Violations = 0;
+
+	explicit FParkourAllocSite(const TCHAR* InName);
+
+	static void ForEachSite(TFunctionRef<void(const FParkourAllocSite&)> Func);
+	static uint64 TotalViolations();
+	static void ResetAll();
+
+private:
+	FParkourAllocSite* Next = nullptr;
+};
+
+/**
+ * Counts heap allocations made by the current thread while alive.
+ * Counts only in processes started with -ParkourAllocCheck, and only while Parkour.AllocCheck is non-zero.
+ * Calls past the warm-up window that allocate are reported as violations.
+ */
+class TRIALTASK_API FParkourAllocationScope
+{
+public:
+	explicit FParkourAllocationScope(FParkourAllocSite& InSite);
+	~FParkourAllocationScope();
+
+	uint64 GetAllocations() const;
+
+private:
+	FParkourAllocSite& Site;
+	uint64 StartCount = 0;
+	bool bActive = false;
+};
+
+// Suspends counting on this thread (failure paths that are allowed to allocate, e.g. dumps)
+class TRIALTASK_API FParkourAllocationPause
+{
+public:
+	FParkourAllocationPause();
+	~FParkourAllocationPause();
+};
+
+#define PARKOUR_NO_ALLOC_SCOPE(SiteName) \
+	static FParkourAllocSite PREPROCESSOR_JOIN(ParkourAllocSite_, SiteName)(TEXT(#SiteName)); \
+	FParkourAllocationScope PREPROCESSOR_JOIN(ParkourAllocScope_, SiteName)(PREPROCESSOR_JOIN(ParkourAllocSite_, SiteName))
+
+#define PARKOUR_ALLOW_ALLOC_SCOPE() \
+	FParkourAllocationPause PREPROCESSOR_JOIN(ParkourAllocPause_, __LINE__)
+
+#else
+
+#define PARKOUR_NO_ALLOC_SCOPE(SiteName)
+#define PARKOUR_ALLOW_ALLOC_SCOPE()
+
+#endif
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StaticArray.h"
+
+#include <atomic>
+
+enum class EParkourTraceEvent : uint8
+{
+	Pressed,
+	NoObstacle,
+	OutOfRange,
+	LandingCandidate,
+	LandingBlocked,
+	ApexBlocked,
+	Started,
+	PhaseAdvanced,
+	MoveStepFallback,
+	MoveStepBlocked,
+	Recovery,
+	Ended,
+	Failsafe,
+	ServerRejected,
+
+	Count
+};
+
+// Why a trace file was written
+enum class EParkourTraceDumpReason : uint8
+{
+	LandingBlocked,
+	ApexBlocked,
+	MoveStepBlocked,
+	Failsafe,
+	Manual,
+	ServerRejected
+};
+
+// One structured traversal event. Plain data, written as-is to the trace file.
+struct FParkourTraceRecord
+{
+	uint64 Cycles = 0;
+	uint32 Frame = 0;
+	EParkourTraceEvent Event = EParkourTraceEvent::Pressed;
+	uint8 Detail = 0;	// parkour type, fallback index, candidate index...
+	uint8 Pad[2] = {};
+	FVector3f Location = FVector3f::ZeroVector;	// actor location when recorded
+	FVector3f Point = FVector3f::ZeroVector;	// candidate / target point
+	FVector3f Normal = FVector3f::ZeroVector;	// hit normal (or input direction)
+	float Value = 0.f;	// height, alpha, duration...
+};
+
+// File layout: header followed by Count records, oldest first
+struct FParkourTraceFileHeader
+{
+	static constexpr uint32 ExpectedMagic = 0x524B5050; // "PPKR"
+	static constexpr uint32 CurrentVersion = 1;
+
+	uint32 Magic = ExpectedMagic;
+	uint32 Version = CurrentVersion;
+	uint32 RecordSize = sizeof(FParkourTraceRecord);
+	uint32 Count = 0;
+	double SecondsPerCycle = 0.0;
+	uint8 Reason = 0;
+	uint8 Pad[7] = {};
+};
+
+/**
+ * Fixed-size, allocation-free ring buffer of traversal events.
+ * Single writer (game thread); the write cursor is atomic so a snapshot can be taken
+ * from any thread without locking (the newest record may be torn if it races the writer).
+ * Nothing touches the disk until DumpToFile.
+ */
+class TRIALTASK_API FParkourFlightRecorder
+{
+public:
+	static constexpr uint32 Capacity = 256;
+	static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+	void Record(EParkourTraceEvent Event, uint8 Detail, const FVector& Location, const FVector& Point = FVector::ZeroVector, const FVector& Normal = FVector::ZeroVector, float Value = 0.f);
+
+	// Copies the buffered records to OutRecords (oldest first). Returns the number copied.
+	uint32 Snapshot(TArray<FParkourTraceRecord>& OutRecords) const;
+
+	// Writes Saved/ParkourTraces/<OwnerName>_<timestamp>.pkr. Returns the file path, empty on failure.
+	FString DumpToFile(EParkourTraceDumpReason Reason, const FString& OwnerName) const;
+
+	void Reset() { WriteIndex.store(0, std::memory_order_relaxed); }
+
+	static bool LoadFromFile(const FString& Path, FParkourTraceFileHeader& OutHeader, TArray<FParkourTraceRecord>& OutRecords);
+
+	static const TCHAR* EventToString(EParkourTraceEvent Event);
+	static const TCHAR* ReasonToString(EParkourTraceDumpReason Reason);
+
+private:
+	TStaticArray<FParkourTraceRecord, Capacity> Records;
+	std::atomic<uint32> WriteIndex{ 0 };
+};
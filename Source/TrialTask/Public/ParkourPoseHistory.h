@@ -0,0 +1,41 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StaticArray.h"
+
+// One server-side sample of a pawn's capsule
+struct FParkourPoseSample
+{
+	double Time = 0.0;	// server world time
+	FVector Location = FVector::ZeroVector;
+	FRotator Rotation = FRotator::ZeroRotator;
+};
+
+/**
+ * Fixed-size ring of recent capsule transforms, recorded by the server every tick for remotely
+ * controlled pawns. Used to rewind to a client's timestamp when validating a traversal start,
+ * instead of re-running detection against the present world. Allocation-free, game thread only.
+ */
+class TRIALTASK_API FParkourPoseHistory
+{
+public:
+	static constexpr uint32 Capacity = 64;
+	static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+	void Record(double Time, const FVector& Location, const FRotator& Rotation);
+
+	// Pose at Time, interpolated between the two surrounding samples (clamped to the recorded window).
+	// Returns false if nothing was recorded yet.
+	bool Sample(double Time, FParkourPoseSample& OutSample) const;
+
+	double GetOldestTime() const;
+
+	void Reset() { Count = 0; WriteIndex = 0; }
+
+private:
+	TStaticArray<FParkourPoseSample, Capacity> Samples;
+	uint32 WriteIndex = 0;
+	uint32 Count = 0;
+
+	const FParkourPoseSample& At(uint32 Age) const { return Samples[(WriteIndex - 1 - Age) & (Capacity - 1)]; }
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+DECLARE_STATS_GROUP(TEXT("Parkour"), STATGROUP_Parkour, STATCAT_Advanced);
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(TRIALTASK_API, Parkour);
+
+// Running totals of the scene queries and fallbacks issued by traversal code.
+// Game thread only. Per-frame values go to the CSV profiler, totals are kept for tooling.
+struct TRIALTASK_API FParkourQueryCounters
+{
+	static uint64 Sweeps;
+	static uint64 LineTraces;
+	static uint64 FindFloors;
+	static uint64 Fallbacks;
+
+	static uint64 TotalQueries() { return Sweeps + LineTraces + FindFloors; }
+};
+
+// Client CPU spent ticking simulated proxies (character + movement), for the per-remote-pawn cost.
+// Game thread only. Parkour.ProxyCost prints the average per remote pawn per frame.
+struct TRIALTASK_API FParkourProxyCost
+{
+	static double Seconds;
+	static uint64 PawnTicks;
+
+	static void Report();
+	static void Reset();
+};
+
+// Adds the enclosing scope's time to FParkourProxyCost when active
+class FParkourProxyCostScope
+{
+public:
+	explicit FParkourProxyCostScope(bool bInActive)
+		: bActive(bInActive)
+		, StartCycles(bInActive ? FPlatformTime::Cycles64() : 0)
+	{
+	}
+
+	~FParkourProxyCostScope()
+	{
+		if (bActive)
+		{
+			FParkourProxyCost::Seconds += FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+		}
+	}
+
+private:
+	bool bActive;
+	uint64 StartCycles;
+};
+
+// Cycle stat + Insights CPU scope + CSV timing for one hot-path function.
+// The stat must be declared with DECLARE_CYCLE_STAT(..., STATGROUP_Parkour) in the calling file.
+#define PARKOUR_SCOPE(StatName) \
+	SCOPE_CYCLE_COUNTER(StatName); \
+	TRACE_CPUPROFILER_EVENT_SCOPE(StatName); \
+	CSV_SCOPED_TIMING_STAT(Parkour, StatName)
+
+// Bumps one of FParkourQueryCounters and the matching per-frame CSV counter
+#define PARKOUR_COUNT(Counter) \
+	do \
+	{ \
+		++FParkourQueryCounters::Counter; \
+		CSV_CUSTOM_STAT(Parkour, Counter, 1, ECsvCustomStatOp::Accumulate); \
+	} while (0)
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ParkourTraceCommandlet.generated.h"
+
+/**
+ * Decodes parkour flight recorder dumps (*.pkr) into a readable table.
+ * Usage: UnrealEditor-Cmd TrialTask.uproject -run=ParkourTrace -File=<path> [-Csv=<out.csv>]
+ * Without -File, every dump in Saved/ParkourTraces is decoded.
+ */
+UCLASS()
+class TRIALTASK_API UParkourTraceCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UParkourTraceCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	bool DecodeFile(const FString& Path, const FString& CsvPath) const;
+};
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CollisionQueryParams.h"
+#include "Containers/StaticArray.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class AActor;
+class UCustomMovementComponent;
+
+enum class ESlideTrajectoryEnd : uint8
+{
+	None,		// still extending (budget ran out this call)
+	Stopped,	// speed fell below SlideMinSpeedToKeep
+	LostFloor,	// no walkable floor under the next step
+	Blocked,	// floor rose more than a step: wall or ledge
+	Horizon		// sample capacity / time horizon reached
+};
+
+struct FSlideTrajectorySample
+{
+	float Time = 0.f;	// seconds since the prediction (re)started
+	FVector Location = FVector::ZeroVector;	// capsule centre
+	FVector Velocity = FVector::ZeroVector;
+	FVector FloorNormal = FVector::UpVector;
+	uint8 SurfaceIndex = 0;	// into the movement component's slide surface cache
+};
+
+/**
+ * Where a slide will go, by running UCustomMovementComponent::StepSlideVelocity (the PhysSlide rules)
+ * forward over floor samples. Floor samples come from a small direct-mapped cache keyed by
+ * position, so restarts over the same ground cost no new queries.
+ * Update() keeps the part of the last prediction the character is still on and only extends the tail,
+ * spending at most FloorQueryBudget floor traces per call. Allocation-free after the first Update, game thread only.
+ */
+class TRIALTASK_API FSlideTrajectoryPredictor
+{
+public:
+	static constexpr int32 Capacity = 128;
+	static constexpr int32 FloorCacheSize = 256;
+	static_assert((FloorCacheSize & (FloorCacheSize - 1)) == 0, "FloorCacheSize must be a power of two");
+
+	// Integration step and how far ahead to look
+	float StepSeconds = 1.f / 30.f;
+	float HorizonSeconds = 3.f;
+
+	// The live state may drift this far from the predicted one before the prediction restarts
+	float LocationTolerance = 15.f;
+	float SpeedTolerance = 40.f;
+
+	// The steer direction may turn this far before the prediction restarts (its magnitude is ignored, like PhysSlide does)
+	float SteerAngleToleranceDeg = 5.f;
+
+	// Floor cache cell size
+	float FloorCellSize = 25.f;
+
+	// Advances by DeltaSeconds of real time and extends within budget. Returns true once the trajectory has ended.
+	bool Update(const UCustomMovementComponent& Move, const FVector& Location, const FVector& Velocity, const FVector& SteerInput, float DeltaSeconds, int32 FloorQueryBudget);
+
+	// Drops the trajectory and the floor cache (a new slide, or the pawn went somewhere else)
+	void Reset();
+
+	// Drops cached floor samples only, e.g. when the surfaces their SurfaceIndex points into were rebuilt
+	void InvalidateFloorCache();
+
+	int32 Num() const { return Count; }
+	const FSlideTrajectorySample& operator[](int32 Index) const { return Samples[(Head + Index) & (Capacity - 1)]; }
+	const FSlideTrajectorySample* GetLast() const { return Count > 0 ? &(*this)[Count - 1] : nullptr; }
+
+	ESlideTrajectoryEnd GetEndReason() const { return EndReason; }
+	bool IsComplete() const { return EndReason != ESlideTrajectoryEnd::None; }
+
+	// Work done by the last Update (for budgets / stats)
+	int32 GetLastFloorQueries() const { return LastFloorQueries; }
+	int32 GetLastReusedSamples() const { return LastReused; }
+
+private:
+	struct FFloorCacheEntry
+	{
+		FIntVector Cell = FIntVector(MAX_int32);
+		float ImpactZ = 0.f;
+		FVector Normal = FVector::UpVector;
+		bool bWalkable = false;
+		bool bBlocked = false;	// trace started inside geometry
+		uint8 SurfaceIndex = 0;
+	};
+
+	TStaticArray<FSlideTrajectorySample, Capacity> Samples;
+	int32 Head = 0;
+	int32 Count = 0;
+
+	TStaticArray<FFloorCacheEntry, FloorCacheSize> FloorCache;
+
+	// Floor trace params, built when the owner changes (constructing them per trace allocates)
+	FCollisionQueryParams FloorQueryParams;
+	FCollisionResponseParams FloorResponseParams;
+	TWeakObjectPtr<const AActor> FloorQueryOwner;
+
+	FVector LastSteer = FVector::ZeroVector;
+	float Elapsed = 0.f;	// real time since the prediction (re)started
+	float HalfHeight = 0.f;
+	uint32 SurfaceGeneration = 0;	// FTrialSlideSurfaceCache generation the floor cache was filled under
+	ESlideTrajectoryEnd EndReason = ESlideTrajectoryEnd::None;
+	int32 LastFloorQueries = 0;
+	int32 LastReused = 0;
+
+	// Drops the trajectory but keeps the floor cache, so restarting over the same ground is free
+	void Restart();
+
+	bool Consume(const FVector& Location, const FVector& Velocity, float DeltaSeconds);
+	bool IsSameSteer(const FVector& SteerInput) const;
+	void Extend(const UCustomMovementComponent& Move, int32& InOutBudget);
+
+	// Cached floor under Location; false if the cache missed and the budget is spent
+	bool FindFloor(const UCustomMovementComponent& Move, const FVector& Location, int32& InOutBudget, FFloorCacheEntry& OutFloor);
+
+	void Push(const FSlideTrajectorySample& Sample);
+};
@@ -0,0 +1,192 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TraversalStateMachine.h"
+#include "TraversalNetState.generated.h"
+
+// FTraversalNetState::Flags: the packed traversal mode (FPackedTraversalState) plus the crouch bit
+namespace TraversalNetFlags
+{
+	constexpr uint8 ModeMask = TraversalStateTable::ModeMask;
+	constexpr uint8 Crouched = 1 << 3;
+
+	constexpr uint32 NumBits = 4;
+}
+
+/**
+ * Quantized form of FTraversalNetState. This is what goes on the wire (classic NetSerialize)
+ * and is also the Iris quantized state, so both paths agree on precision.
+ * Positions are whole centimetres; traversal points are stored relative to the obstacle top.
+ * Only Flags and Stamina are meaningful while not traversing (the rest is kept zeroed).
+ */
+struct FTraversalNetStatePacked
+{
+	int32 Origin[3] = {};
+	int16 Offsets[3][3] = {};	// Start, Apex, Target minus Origin
+	uint8 Flags = 0;
+	uint8 Stamina = 0;	// 0..255 of StaminaMax
+	uint8 PhaseAlpha = 0;	// 0..255 of the current phase
+	uint8 Pad[3] = {};	// explicit and zeroed: operator== compares the whole struct
+
+	bool IsTraversing() const { return TraversalStateTable::IsTraversal(Flags & TraversalNetFlags::ModeMask); }
+
+	bool operator==(const FTraversalNetStatePacked& Other) const { return FMemory::Memcmp(this, &Other, sizeof(*this)) == 0; }
+	bool operator!=(const FTraversalNetStatePacked& Other) const { return !(*this == Other); }
+};
+static_assert(sizeof(FTraversalNetStatePacked) == 36, "FTraversalNetStatePacked must have no implicit padding (memcmp equality)");
+
+/**
+ * Replicated movement / parkour state of a character (server -> simulated proxies).
+ * Replaces sending ParkourStart/Apex/Target as full FVectors, Stamina as a float and
+ * one bool per mode. Equality is on the quantized form so sub-centimetre noise never dirties it.
+ */
+USTRUCT()
+struct TRIALTASK_API FTraversalNetState
+{
+	GENERATED_BODY()
+
+	// Obstacle top point; the traversal points are sent relative to it
+	UPROPERTY()
+	FVector ObstacleOrigin = FVector::ZeroVector;
+
+	UPROPERTY()
+	FVector ParkourStart = FVector::ZeroVector;
+
+	UPROPERTY()
+	FVector ParkourApex = FVector::ZeroVector;
+
+	UPROPERTY()
+	FVector ParkourTarget = FVector::ZeroVector;
+
+	UPROPERTY()
+	float StaminaNormalized = 1.f;
+
+	UPROPERTY()
+	float PhaseAlpha = 0.f;
+
+	UPROPERTY()
+	uint8 Flags = 0;
+
+	bool HasFlag(uint8 Flag) const { return (Flags & Flag) != 0; }
+	ETraversalMode GetMode() const { return (ETraversalMode)(Flags & TraversalNetFlags::ModeMask); }
+	void SetMode(ETraversalMode Mode) { Flags = (Flags & ~TraversalNetFlags::ModeMask) | ((uint8)Mode & TraversalNetFlags::ModeMask); }
+
+	FTraversalNetStatePacked Pack() const;
+	void Unpack(const FTraversalNetStatePacked& Packed);
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FTraversalNetState& Other) const { return Pack() == Other.Pack(); }
+};
+
+template<>
+struct TStructOpsTypeTraits<FTraversalNetState> : public TStructOpsTypeTraitsBase2<FTraversalNetState>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true,
+	};
+};
+
+// Bit layout shared by NetSerialize and the Iris serializer. Writer/Reader only need WriteBits/ReadBits.
+namespace TraversalNetStateWire
+{
+	// Zigzag + 5-bit length prefix: small offsets cost a few bits, large world origins stay exact
+	template<typename WriterType>
+	uint32 WriteInt(WriterType& Writer, int32 Value)
+	{
+		const uint32 ZigZag = (uint32(Value) << 1) ^ uint32(Value >> 31);
+		const uint32 NumBits = ZigZag ? FMath::Min(31u, 32u - FMath::CountLeadingZeros(ZigZag)) : 0u;
+		Writer.WriteBits(NumBits, 5);
+		if (NumBits)
+		{
+			Writer.WriteBits(ZigZag & ((1u << NumBits) - 1u), NumBits);
+		}
+		return 5 + NumBits;
+	}
+
+	template<typename ReaderType>
+	int32 ReadInt(ReaderType& Reader)
+	{
+		const uint32 NumBits = Reader.ReadBits(5);
+		const uint32 ZigZag = NumBits ? Reader.ReadBits(NumBits) : 0u;
+		return int32(ZigZag >> 1) ^ -int32(ZigZag & 1u);
+	}
+
+	template<typename WriterType>
+	uint32 WriteTraversal(WriterType& Writer, const FTraversalNetStatePacked& Packed)
+	{
+		uint32 Bits = 8;
+		Writer.WriteBits(Packed.PhaseAlpha, 8);
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			Bits += WriteInt(Writer, Packed.Origin[Axis]);
+		}
+		for (int32 Point = 0; Point < 3; ++Point)
+		{
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				Bits += WriteInt(Writer, Packed.Offsets[Point][Axis]);
+			}
+		}
+		return Bits;
+	}
+
+	template<typename ReaderType>
+	void ReadTraversal(ReaderType& Reader, FTraversalNetStatePacked& Packed)
+	{
+		Packed.PhaseAlpha = (uint8)Reader.ReadBits(8);
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			Packed.Origin[Axis] = ReadInt(Reader);
+		}
+		for (int32 Point = 0; Point < 3; ++Point)
+		{
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				Packed.Offsets[Point][Axis] = (int16)ReadInt(Reader);
+			}
+		}
+	}
+
+	// Full state: flags + stamina, traversal points only while vaulting / mantling
+	template<typename WriterType>
+	uint32 Write(WriterType& Writer, const FTraversalNetStatePacked& Packed)
+	{
+		Writer.WriteBits(Packed.Flags, TraversalNetFlags::NumBits);
+		Writer.WriteBits(Packed.Stamina, 8);
+		uint32 Bits = TraversalNetFlags::NumBits + 8;
+		if (Packed.IsTraversing())
+		{
+			Bits += WriteTraversal(Writer, Packed);
+		}
+		return Bits;
+	}
+
+	template<typename ReaderType>
+	void Read(ReaderType& Reader, FTraversalNetStatePacked& Packed)
+	{
+		Packed = FTraversalNetStatePacked();
+		Packed.Flags = (uint8)Reader.ReadBits(TraversalNetFlags::NumBits);
+		Packed.Stamina = (uint8)Reader.ReadBits(8);
+		if (Packed.IsTraversing())
+		{
+			ReadTraversal(Reader, Packed);
+		}
+	}
+}
+
+// Bytes per replicated pawn per second and receiving connection, for loopback measurements (Trial.NetState.Report)
+struct TRIALTASK_API FTraversalNetStats
+{
+	static uint64 Bits;
+	static uint64 Writes;
+	static uint64 DeltaWrites;
+	static int32 NumPawns;	// authority-side characters carrying the state
+	static double WindowStart;
+
+	static void NoteWrite(uint32 NumBits, bool bDelta);
+	static void Report();
+	static void Reset();
+};
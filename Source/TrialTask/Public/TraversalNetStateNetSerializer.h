@@ -0,0 +1,24 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Iris/Serialization/NetSerializer.h"
+#include "TraversalNetStateNetSerializer.generated.h"
+
+// Reflected, so UHT generates it in every build; IrisCore headers are reachable without Iris (SetupIrisSupport)
+USTRUCT()
+struct FTraversalNetStateNetSerializerConfig : public FNetSerializerConfig
+{
+	GENERATED_BODY()
+};
+
+#if UE_WITH_IRIS
+
+namespace UE::Net
+{
+
+// Iris serializer for FTraversalNetState: quantizes to FTraversalNetStatePacked and delta encodes against the last acked state
+UE_NET_DECLARE_SERIALIZER(FTraversalNetStateNetSerializer, TRIALTASK_API);
+
+}
+
+#endif // UE_WITH_IRIS
@@ -0,0 +1,221 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TraversalStateMachine.generated.h"
+
+UENUM(BlueprintType)
+enum class EParkourType : uint8
+{
+	None,
+	Vault,
+	Mantle
+};
+
+UENUM()
+enum class EParkourPhase : uint8
+{
+	None,
+	ToApex,
+	ToTarget
+};
+
+// Mutually exclusive movement modes of ACustomCharacter. Fits in 3 bits.
+enum class ETraversalMode : uint8
+{
+	Walk,
+	Sprint,
+	Slide,
+	VaultToApex,
+	VaultToTarget,
+	MantleToApex,
+	MantleToTarget,
+
+	Num
+};
+
+enum class ETraversalEvent : uint8
+{
+	SprintStart,
+	SprintStop,
+	SlideStart,
+	SlideStop,
+	VaultStart,
+	MantleStart,
+	ApexReached,
+	TraversalEnd,
+	Reset,
+
+	Num
+};
+
+namespace TraversalStateTable
+{
+	constexpr int32 NumModes = (int32)ETraversalMode::Num;
+	constexpr int32 NumEvents = (int32)ETraversalEvent::Num;
+	constexpr uint8 Invalid = 0xFF;
+
+	constexpr uint8 W = (uint8)ETraversalMode::Walk;
+	constexpr uint8 Sp = (uint8)ETraversalMode::Sprint;
+	constexpr uint8 Sl = (uint8)ETraversalMode::Slide;
+	constexpr uint8 VA = (uint8)ETraversalMode::VaultToApex;
+	constexpr uint8 VT = (uint8)ETraversalMode::VaultToTarget;
+	constexpr uint8 MA = (uint8)ETraversalMode::MantleToApex;
+	constexpr uint8 MT = (uint8)ETraversalMode::MantleToTarget;
+	constexpr uint8 XX = Invalid;
+
+	// Next[From][Event]: resulting mode, or Invalid
+	constexpr uint8 Next[NumModes][NumEvents] =
+	{
+		//            SprintStart SprintStop SlideStart SlideStop VaultStart MantleStart ApexReached TraversalEnd Reset
+		/* Walk   */ { Sp,         XX,        Sl,        XX,       VA,        MA,         XX,         XX,          W },
+		/* Sprint */ { XX,         W,         Sl,        XX,       VA,        MA,         XX,         XX,          W },
+		/* Slide  */ { XX,         XX,        XX,        W,        VA,        MA,         XX,         XX,          W },
+		/* VaultA */ { XX,         XX,        XX,        XX,       XX,        XX,         VT,         W,           W },
+		/* VaultT */ { XX,         XX,        XX,        XX,       XX,        XX,         XX,         W,           W },
+		/* MantA  */ { XX,         XX,        XX,        XX,       XX,        XX,         MT,         W,           W },
+		/* MantT  */ { XX,         XX,        XX,        XX,       XX,        XX,         XX,         W,           W },
+	};
+
+	// Events a locked input refuses
+	constexpr uint16 StartEvents = (1 << (int32)ETraversalEvent::SprintStart) | (1 << (int32)ETraversalEvent::SlideStart)
+		| (1 << (int32)ETraversalEvent::VaultStart) | (1 << (int32)ETraversalEvent::MantleStart);
+
+	constexpr bool IsTraversal(uint8 Mode) { return Mode >= VA && Mode <= MT; }
+
+	// Structural rules of the table, checked at compile time
+	constexpr bool IsValid()
+	{
+		for (int32 From = 0; From < NumModes; ++From)
+		{
+			for (int32 Event = 0; Event < NumEvents; ++Event)
+			{
+				const uint8 To = Next[From][Event];
+				if (To != Invalid && To >= NumModes) return false;
+
+				// Into a second phase only from its own first phase
+				if ((To == VT && From != VA) || (To == MT && From != MA)) return false;
+
+				// Traversals only end, advance or reset; nothing else starts from inside one
+				if (IsTraversal((uint8)From) && To != Invalid && Event != (int32)ETraversalEvent::ApexReached
+					&& Event != (int32)ETraversalEvent::TraversalEnd && Event != (int32)ETraversalEvent::Reset) return false;
+			}
+
+			// Every mode has a way back to Walk
+			if (Next[From][(int32)ETraversalEvent::Reset] != W) return false;
+			if (IsTraversal((uint8)From) && Next[From][(int32)ETraversalEvent::TraversalEnd] != W) return false;
+		}
+		return true;
+	}
+	static_assert(IsValid(), "Traversal transition table breaks its invariants");
+
+	// Layout of FPackedTraversalState::Bits
+	constexpr uint8 ModeMask = 0x7;
+	constexpr uint8 CrouchRequestedBit = 1 << 3;
+	constexpr uint8 InputLockedBit = 1 << 4;
+	constexpr int32 NumLookupEntries = 1 << 5;
+
+	// Allowed-event mask for every value of the low five bits (mode, crouch, lock)
+	struct FAllowedEvents
+	{
+		uint16 Mask[NumLookupEntries] = {};
+
+		constexpr FAllowedEvents()
+		{
+			for (int32 Entry = 0; Entry < NumLookupEntries; ++Entry)
+			{
+				const int32 Mode = Entry & ModeMask;
+				if (Mode >= NumModes) continue;
+
+				for (int32 Event = 0; Event < NumEvents; ++Event)
+				{
+					const bool bRefusedByLock = (Entry & InputLockedBit) && (StartEvents & (1 << Event));
+					if (Next[Mode][Event] != Invalid && !bRefusedByLock)
+					{
+						Mask[Entry] |= (uint16)(1 << Event);
+					}
+				}
+			}
+		}
+	};
+
+	inline constexpr FAllowedEvents AllowedEvents{};
+}
+
+/**
+ * Movement / traversal state of ACustomCharacter in one byte:
+ *   bits 0-2  ETraversalMode
+ *   bit 3     crouch requested
+ *   bit 4     input locked (refuses every *Start event)
+ * All mode changes go through TryApply, which only takes transitions in TraversalStateTable::Next.
+ * Can() / CanStartParkour() are one lookup in a table precomputed over the low five bits.
+ */
+struct FPackedTraversalState
+{
+	static constexpr uint8 ModeMask = TraversalStateTable::ModeMask;
+	static constexpr uint8 CrouchRequestedBit = TraversalStateTable::CrouchRequestedBit;
+	static constexpr uint8 InputLockedBit = TraversalStateTable::InputLockedBit;
+
+	uint8 Bits = 0;
+
+	constexpr ETraversalMode GetMode() const { return (ETraversalMode)(Bits & ModeMask); }
+
+	bool Can(ETraversalEvent Event) const { return (GetAllowedEvents() & (1 << (int32)Event)) != 0; }
+
+	// Vault or mantle could start now (the obstacle decides which)
+	bool CanStartParkour() const { return (GetAllowedEvents() & ((1 << (int32)ETraversalEvent::VaultStart) | (1 << (int32)ETraversalEvent::MantleStart))) != 0; }
+
+	// Move / sprint / crouch input is taken while not locked and not traversing
+	bool AcceptsMoveInput() const { return !IsInputLocked() && !IsTraversing(); }
+
+	// Takes the transition if the table allows it; false (and unchanged) otherwise
+	bool TryApply(ETraversalEvent Event)
+	{
+		if (!Can(Event)) return false;
+		Bits = (Bits & ~ModeMask) | TraversalStateTable::Next[(int32)GetMode()][(int32)Event];
+		return true;
+	}
+
+	// Simulated proxies take the server's mode as is
+	void SetReplicatedMode(ETraversalMode Mode)
+	{
+		if ((uint8)Mode < (uint8)ETraversalMode::Num)
+		{
+			Bits = (Bits & ~ModeMask) | (uint8)Mode;
+		}
+	}
+
+	bool IsSprinting() const { return GetMode() == ETraversalMode::Sprint; }
+	bool IsSliding() const { return GetMode() == ETraversalMode::Slide; }
+	bool IsTraversing() const { return TraversalStateTable::IsTraversal((uint8)GetMode()); }
+	bool IsVaulting() const { return GetMode() == ETraversalMode::VaultToApex || GetMode() == ETraversalMode::VaultToTarget; }
+	bool IsMantling() const { return GetMode() == ETraversalMode::MantleToApex || GetMode() == ETraversalMode::MantleToTarget; }
+
+	EParkourType GetParkourType() const { return IsVaulting() ? EParkourType::Vault : (IsMantling() ? EParkourType::Mantle : EParkourType::None); }
+	EParkourPhase GetParkourPhase() const
+	{
+		switch (GetMode())
+		{
+		case ETraversalMode::VaultToApex:
+		case ETraversalMode::MantleToApex:
+			return EParkourPhase::ToApex;
+		case ETraversalMode::VaultToTarget:
+		case ETraversalMode::MantleToTarget:
+			return EParkourPhase::ToTarget;
+		default:
+			return EParkourPhase::None;
+		}
+	}
+
+	static ETraversalEvent StartEventFor(EParkourType Type) { return Type == EParkourType::Vault ? ETraversalEvent::VaultStart : ETraversalEvent::MantleStart; }
+
+	bool IsCrouchRequested() const { return (Bits & CrouchRequestedBit) != 0; }
+	void SetCrouchRequested(bool bRequested) { Bits = bRequested ? (Bits | CrouchRequestedBit) : (Bits & ~CrouchRequestedBit); }
+
+	bool IsInputLocked() const { return (Bits & InputLockedBit) != 0; }
+	void SetInputLocked(bool bLocked) { Bits = bLocked ? (Bits | InputLockedBit) : (Bits & ~InputLockedBit); }
+
+private:
+	uint16 GetAllowedEvents() const { return TraversalStateTable::AllowedEvents.Mask[Bits & (TraversalStateTable::NumLookupEntries - 1)]; }
+};
+
+static_assert(sizeof(FPackedTraversalState) == 1, "Traversal state must stay one byte");
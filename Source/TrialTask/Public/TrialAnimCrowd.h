@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AnimationSharingTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TrialAnimCrowd.generated.h"
+
+class ACustomCharacter;
+
+/**
+ * Animation sharing state of a character, from UTrialAnimInstance::ComputeShareState
+ * (speed band, slide, crouch, air, traversal). Set as the processor of the sharing setup asset;
+ * the setup's state enum must be ETrialAnimShareState.
+ */
+UCLASS()
+class TRIALTASK_API UTrialAnimSharingStateProcessor : public UAnimationSharingStateProcessor
+{
+	GENERATED_BODY()
+
+public:
+	virtual void ProcessActorState_Implementation(int32& OutState, AActor* InActor, uint8 CurrentState, uint8 OnDemandState, bool& bShouldProcess) override;
+	virtual UEnum* GetAnimationStateEnum_Implementation() override;
+};
+
+/**
+ * Keeps skeletal animation of many ACustomCharacters under a frame budget:
+ *  - Animation budget allocator (meshes are USkeletalMeshComponentBudgeted): Trial.Anim.BudgetMs caps the
+ *    animation cost per frame by ticking / interpolating less significant meshes less often. The local
+ *    player is never skipped; pawns mid vault / mantle get full significance at any distance.
+ *  - Animation sharing (Trial.Anim.SharingSetup): remote pawns in the same ETrialAnimShareState follow one
+ *    shared pose instead of evaluating ABP_CustomCharacter each. Significance (distance to the local view)
+ *    comes from the significance manager this subsystem updates.
+ * Client / standalone only. Trial.Anim.Report logs an ANIMCROWD line.
+ */
+UCLASS()
+class TRIALTASK_API UTrialAnimCrowdSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Also re-run when the character's controller changes (a pooled pawn becoming or leaving the local one)
+	void RegisterCharacter(ACustomCharacter* Character);
+	void UnregisterCharacter(ACustomCharacter* Character);
+
+	// Re-reads Trial.Anim.BudgetMs / Trial.Anim.Budget
+	void ApplyBudget();
+
+	void Report() const;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+private:
+	TArray<TWeakObjectPtr<ACustomCharacter>> Characters;
+	// Registered as the local player: mesh pinned at full significance, not shared
+	TArray<TWeakObjectPtr<ACustomCharacter>> PinnedCharacters;
+
+	bool bSharingActive = false;
+	bool bSignificanceRegistered = false;
+
+	static float CalculateBudgetSignificance(class USkeletalMeshComponentBudgeted* Component);
+};
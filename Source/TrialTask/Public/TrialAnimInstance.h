@@ -8,6 +8,19 @@ class ACharacter;
 class UCustomMovementComponent;
 class ACustomCharacter;
 
+// Pose-sharing bucket of a character (UTrialAnimSharingStateProcessor). Order is the state enum of the sharing setup.
+UENUM(BlueprintType)
+enum class ETrialAnimShareState : uint8
+{
+	Idle,
+	Walk,
+	Sprint,
+	Slide,
+	Crouch,
+	Air,
+	Traversal,	// vault / mantle montages; never a good pose to share
+};
+
 UCLASS()
 class TRIALTASK_API UTrialAnimInstance : public UAnimInstance
 {
@@ -45,9 +58,20 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Anim|Parkour")
 	bool bIsMantling = false;
 
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Anim|State")
+	ETrialAnimShareState ShareState = ETrialAnimShareState::Idle;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Anim|Tuning")
 	float DirectionClampAbs = 180.0f;
 
+	// 0 = still, 1 = walk speed, 2 = sprint speed
+	static float NormalizeSpeed(const UCustomMovementComponent& Move);
+
+	static ETrialAnimShareState ClassifyShareState(float NormalizedSpeed, bool bInAir, bool bSliding, bool bCrouched, bool bTraversing);
+
+	// From the character and its movement directly: pawns sharing a pose do not update their own anim instance
+	static ETrialAnimShareState ComputeShareState(const ACharacter* Character);
+
 protected:
 	UPROPERTY(Transient)
 	TObjectPtr<ACharacter> CachedCharacter;
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Controller.h"
+#include "TrialBotController.generated.h"
+
+class ITrialInputTarget;
+
+// One bot behavior profile. Intervals of 0 disable the action.
+USTRUCT()
+struct FTrialBotBehavior
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Bot")
+	FName Name;
+
+	// Hold sprint whenever possible
+	UPROPERTY(EditAnywhere, Category = "Bot")
+	bool bSprint = true;
+
+	UPROPERTY(EditAnywhere, Category = "Bot")
+	float SlideInterval = 0.f;
+
+	UPROPERTY(EditAnywhere, Category = "Bot")
+	float SlideHoldTime = 0.8f;
+
+	UPROPERTY(EditAnywhere, Category = "Bot")
+	float ParkourInterval = 0.f;
+
+	UPROPERTY(EditAnywhere, Category = "Bot")
+	float JumpInterval = 0.f;
+
+	// Picks a new heading every TurnInterval seconds, up to +-MaxTurnDegrees
+	UPROPERTY(EditAnywhere, Category = "Bot")
+	float TurnInterval = 4.f;
+
+	UPROPERTY(EditAnywhere, Category = "Bot")
+	float MaxTurnDegrees = 90.f;
+
+	UPROPERTY(EditAnywhere, Category = "Bot")
+	float TurnRateDegPerSec = 180.f;
+};
+
+/**
+ * Lightweight load-generation controller. Drives any ITrialInputTarget pawn (CMC or Mover backend) through the
+ * same input handlers as a player (sprint, crouch/slide, parkour, jump, move, look).
+ * Profiles come from config; spawn with "Trial.SpawnBots <Count> [Behavior] [PawnClass]" (works on dedicated servers).
+ */
+UCLASS(Config = Game)
+class TRIALTASK_API ATrialBotController : public AController
+{
+	GENERATED_BODY()
+
+public:
+	ATrialBotController();
+
+	UPROPERTY(Config)
+	TArray<FTrialBotBehavior> Behaviors;
+
+	// Default bot pawn; must implement ITrialInputTarget
+	UPROPERTY(Config)
+	FSoftClassPath BotCharacterClass;
+
+	// Decisions run at this rate; move/look input is still fed every frame
+	UPROPERTY(Config)
+	float DecisionInterval = 0.1f;
+
+	UPROPERTY(EditAnywhere, Category = "Bot")
+	FName BehaviorName = TEXT("Runner");
+
+	void SetBehavior(FName InBehaviorName, int32 Seed);
+
+	// Spawns Count bot-driven pawns around the player starts. Behaviors cycle when BehaviorName is None.
+	// PawnClass overrides BotCharacterClass (e.g. to benchmark the Mover backend against CMC).
+	static int32 SpawnBots(UWorld* World, int32 Count, FName BehaviorName, TArray<APawn*>* OutPawns = nullptr, UClass* PawnClass = nullptr);
+
+	// Resolves a class name or path from the command line / console, nullptr if it is not a bot-drivable pawn
+	static UClass* FindBotPawnClass(const FString& ClassName);
+	static int32 DespawnBots(UWorld* World);
+
+protected:
+	virtual void Tick(float DeltaSeconds) override;
+	virtual void OnPossess(APawn* InPawn) override;
+	virtual void OnUnPossess() override;
+
+private:
+	UPROPERTY(Transient)
+	TObjectPtr<APawn> BotPawn;
+
+	// BotPawn's input interface (same object)
+	ITrialInputTarget* BotInput = nullptr;
+
+	FTrialBotBehavior Behavior;
+	FRandomStream Random;
+
+	float DecisionAccum = 0.f;
+	float SlideTimer = 0.f;
+	float SlideHoldLeft = 0.f;
+	float ParkourTimer = 0.f;
+	float JumpTimer = 0.f;
+	float TurnTimer = 0.f;
+	float StuckTime = 0.f;
+	float TargetYaw = 0.f;
+
+	bool bSprintHeld = false;
+
+	void Decide(float DeltaSeconds);
+	void ResetTimers();
+	float NextInterval(float Base);
+};
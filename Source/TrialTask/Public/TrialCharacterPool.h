@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TrialCharacterPool.generated.h"
+
+class ACustomCharacter;
+class AController;
+
+USTRUCT()
+struct FTrialCharacterPoolList
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<ACustomCharacter>> Characters;
+};
+
+/**
+ * Pre-warmed characters for respawn. A pooled character keeps its components, anim instance,
+ * stamina widget and input mapping; release resets traversal / slide / stamina state (ResetForPool)
+ * and parks it hidden, without collision, ticking or replication.
+ * Trial.Pool.Latency compares spawn-to-controllable time against a fresh SpawnActor.
+ */
+UCLASS()
+class TRIALTASK_API UTrialCharacterPool : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Spawns Count parked characters of Class ahead of time
+	UFUNCTION(BlueprintCallable, Category = "Pool")
+	int32 Prewarm(TSubclassOf<ACustomCharacter> Class, int32 Count);
+
+	// A parked character moved to Transform and possessed by Controller (if any). Spawns one when the pool is empty.
+	UFUNCTION(BlueprintCallable, Category = "Pool")
+	ACustomCharacter* Acquire(TSubclassOf<ACustomCharacter> Class, const FTransform& Transform, AController* Controller);
+
+	// Unpossesses, resets and parks the character. Use instead of Destroy.
+	UFUNCTION(BlueprintCallable, Category = "Pool")
+	void Release(ACustomCharacter* Character);
+
+	int32 GetNumFree(TSubclassOf<ACustomCharacter> Class) const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+private:
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<UClass>, FTrialCharacterPoolList> Free;
+
+	ACustomCharacter* SpawnParked(UClass* Class, const FTransform& Transform);
+	void Park(ACustomCharacter* Character);
+	void Unpark(ACustomCharacter* Character, const FTransform& Transform);
+};
@@ -0,0 +1,184 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StaticArray.h"
+
+class UCustomMovementComponent;
+
+/**
+ * 48.16 fixed-point scalar. All simulation math is integer so results are bit-identical on every
+ * machine and every resimulation; floats are only used when building params and for display.
+ */
+struct FTrialFixed
+{
+	static constexpr int32 FracBits = 16;
+	static constexpr int64 One = int64(1) << FracBits;
+
+	int64 Raw = 0;
+
+	static constexpr FTrialFixed FromRaw(int64 InRaw) { FTrialFixed F; F.Raw = InRaw; return F; }
+	static constexpr FTrialFixed FromInt(int64 Value) { return FromRaw(Value * One); }
+	static FTrialFixed FromFloat(float Value) { return FromRaw(FMath::RoundToInt64((double)Value * One)); }
+
+	float ToFloat() const { return (float)((double)Raw / One); }
+
+	FTrialFixed operator+(FTrialFixed O) const { return FromRaw(Raw + O.Raw); }
+	FTrialFixed operator-(FTrialFixed O) const { return FromRaw(Raw - O.Raw); }
+	FTrialFixed operator-() const { return FromRaw(-Raw); }
+	FTrialFixed operator*(FTrialFixed O) const { return FromRaw((Raw * O.Raw) >> FracBits); }
+	FTrialFixed operator/(FTrialFixed O) const { return FromRaw(O.Raw ? (Raw << FracBits) / O.Raw : 0); }
+
+	FTrialFixed& operator+=(FTrialFixed O) { Raw += O.Raw; return *this; }
+	FTrialFixed& operator-=(FTrialFixed O) { Raw -= O.Raw; return *this; }
+
+	bool operator<(FTrialFixed O) const { return Raw < O.Raw; }
+	bool operator<=(FTrialFixed O) const { return Raw <= O.Raw; }
+	bool operator>(FTrialFixed O) const { return Raw > O.Raw; }
+	bool operator>=(FTrialFixed O) const { return Raw >= O.Raw; }
+	bool operator==(FTrialFixed O) const { return Raw == O.Raw; }
+
+	static FTrialFixed Min(FTrialFixed A, FTrialFixed B) { return A < B ? A : B; }
+	static FTrialFixed Max(FTrialFixed A, FTrialFixed B) { return A > B ? A : B; }
+};
+
+// One tick of player input, already quantized (what would go over the wire)
+struct FTrialDetInput
+{
+	int8 MoveX = 0;	// right, -127..127
+	int8 MoveY = 0;	// forward, -127..127
+	uint8 Buttons = 0;
+
+	static constexpr uint8 Sprint = 1 << 0;
+	static constexpr uint8 Crouch = 1 << 1;
+
+	bool operator==(const FTrialDetInput& O) const { return MoveX == O.MoveX && MoveY == O.MoveY && Buttons == O.Buttons; }
+	bool operator!=(const FTrialDetInput& O) const { return !(*this == O); }
+};
+
+// Tuning converted once to fixed point; rates are pre-multiplied by the fixed tick
+struct FTrialDetParams
+{
+	int32 TickRate = 60;
+
+	FTrialFixed Dt;
+	FTrialFixed WalkSpeed;
+	FTrialFixed SprintSpeed;
+	FTrialFixed AccelPerTick;
+	FTrialFixed BrakePerTick;
+
+	FTrialFixed StaminaMax;
+	FTrialFixed RegenPerTick;
+	FTrialFixed SprintDrainPerTick;
+	FTrialFixed SlideDrainPerTick;
+	FTrialFixed MinStaminaToSprint;
+	FTrialFixed MinStaminaToSlide;
+
+	FTrialFixed SlideMinStartSpeed;
+	FTrialFixed SlideGraceStartSpeed;
+	FTrialFixed SlideMinSpeedToKeep;
+	FTrialFixed SlideFlatDecelPerTick;
+	FTrialFixed SlideSteerAccelPerTick;
+	FTrialFixed SlideMaxSpeedFlat;
+	int32 SlideGraceTicks = 0;
+
+	// Same tuning as the movement component (defaults of UCustomMovementComponent if Move is null)
+	static FTrialDetParams FromMovement(const UCustomMovementComponent* Move, int32 TickRate = 60);
+};
+
+/**
+ * Complete sim state. Plain data: a snapshot is a copy, restore is an assignment.
+ * Padding is explicit so the CRC is stable.
+ */
+struct FTrialDetState
+{
+	FTrialFixed PosX;
+	FTrialFixed PosY;
+	FTrialFixed VelX;
+	FTrialFixed VelY;
+	FTrialFixed Stamina;
+	int32 TicksSinceSprintEnded = 1 << 20;
+	uint32 Frame = 0;
+	uint8 Flags = 0;
+	uint8 Pad[7] = {};
+
+	static constexpr uint8 Sprinting = 1 << 0;
+	static constexpr uint8 Sliding = 1 << 1;
+	static constexpr uint8 CrouchHeld = 1 << 2;
+
+	uint32 Checksum() const;
+};
+
+/**
+ * Deterministic sprint / slide / stamina on flat ground. Mirrors the rules of
+ * UCustomMovementComponent (PhysSlide flat branch, UpdateStamina, UpdateMaxSpeed) at a fixed tick,
+ * without engine collision. Slopes and walls stay with the engine path.
+ */
+namespace TrialDeterministicSim
+{
+	TRIALTASK_API void Step(FTrialDetState& State, const FTrialDetInput& Input, const FTrialDetParams& Params);
+}
+
+/**
+ * Rollback buffer around the deterministic sim: keeps the last HistorySize snapshots and inputs,
+ * and when a late input differs from the one that was predicted, restores and resimulates
+ * (at most MaxResimFrames). Allocation-free.
+ */
+class TRIALTASK_API FTrialRollbackSim
+{
+public:
+	static constexpr uint32 HistorySize = 16;
+	static constexpr uint32 MaxResimFrames = 10;
+	static_assert(MaxResimFrames < HistorySize, "History must cover the resim window");
+
+	void Init(const FTrialDetState& Initial, const FTrialDetParams& InParams);
+
+	// Simulates the next frame with Input (confirmed or predicted)
+	void Advance(const FTrialDetInput& Input);
+
+	// The real input for an already simulated Frame arrived. Resimulates if it differs from the one used.
+	// Returns false if Frame is outside the resim window (desync; caller must resync from a full state).
+	bool Correct(uint32 Frame, const FTrialDetInput& Input);
+
+	const FTrialDetState& GetState() const { return Current; }
+	uint32 GetFrame() const { return Current.Frame; }
+
+	// Checksum of the state at the start of Frame (must still be in history)
+	uint32 GetChecksum(uint32 Frame) const;
+
+	double GetLastResimMs() const { return LastResimMs; }
+	uint32 GetLastResimFrames() const { return LastResimFrames; }
+
+private:
+	FTrialDetParams Params;
+	FTrialDetState Current;
+
+	// Slot Frame % HistorySize: state at the start of Frame and the input used for it
+	TStaticArray<FTrialDetState, HistorySize> Snapshots;
+	TStaticArray<FTrialDetInput, HistorySize> Inputs;
+
+	double LastResimMs = 0.0;
+	uint32 LastResimFrames = 0;
+};
+
+// Result of TrialDeterministicSim::RunDesyncCheck
+struct FTrialDesyncCheckResult
+{
+	int32 MaxDelay = 0;	// after clamping to the resim window
+	int32 DesyncFrame = INDEX_NONE;
+	uint32 Resims = 0;
+	double AvgResimMs = 0.0;
+	double MaxResimMs = 0.0;
+	double WorstResimMs = 0.0;	// MaxResimFrames resimulated from a mispredicted input
+
+	bool HasDesync() const { return DesyncFrame != INDEX_NONE; }
+};
+
+namespace TrialDeterministicSim
+{
+	/**
+	 * Two rollback instances against a reference run of the same seeded input script: A gets every input
+	 * on time, B gets each one up to MaxDelay frames late and predicts meanwhile. Confirmed states must match
+	 * the reference bit for bit. MaxDelay is clamped so every late input still lands inside the resim window.
+	 */
+	TRIALTASK_API FTrialDesyncCheckResult RunDesyncCheck(const FTrialDetParams& Params, int32 NumFrames, int32 MaxDelay, int32 Seed);
+}
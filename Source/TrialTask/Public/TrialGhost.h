@@ -0,0 +1,167 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TrialGhost.generated.h"
+
+class ACustomCharacter;
+class IMappedFileHandle;
+class IMappedFileRegion;
+class UInstancedStaticMeshComponent;
+
+/**
+ * Ghost run file (.tgh): a fixed header, then one delta-coded record per sample.
+ *   Location  1 cm steps, Velocity 2 cm/s steps, Yaw 1/65536 turn, State = traversal mode + crouch bits
+ * Each record is a flags byte naming the channels that changed, followed by their zigzag varint deltas
+ * (state as a raw byte). A standing ghost costs one byte per sample.
+ */
+namespace TrialGhostFormat
+{
+	constexpr uint32 Magic = 0x4F484754; // "TGHO"
+	constexpr uint32 Version = 1;
+	constexpr int32 HeaderBytes = 4 * sizeof(uint32);
+
+	struct FQuantSample
+	{
+		FIntVector Location = FIntVector::ZeroValue;
+		FIntVector Velocity = FIntVector::ZeroValue;
+		uint16 Yaw = 0;
+		uint8 State = 0;
+	};
+
+	TRIALTASK_API FQuantSample Quantize(const FVector& Location, const FVector& Velocity, float Yaw, uint8 State);
+
+	TRIALTASK_API void Encode(TArray<uint8>& Out, const FQuantSample& Prev, const FQuantSample& Sample);
+
+	// Reads the record at InOutOffset on top of InOutSample; false on truncated data
+	TRIALTASK_API bool Decode(const uint8* Data, int64 Size, int64& InOutOffset, FQuantSample& InOutSample);
+}
+
+// Samples one character at a fixed rate into the encoded stream
+class TRIALTASK_API FTrialGhostRecorder
+{
+public:
+	explicit FTrialGhostRecorder(uint32 InSampleRate);
+
+	void AddSample(const FVector& Location, const FVector& Velocity, float Yaw, uint8 State);
+
+	bool SaveToFile(const FString& Path) const;
+
+	uint32 GetSampleRate() const { return SampleRate; }
+	int32 GetNumSamples() const { return NumSamples; }
+	int32 GetNumBytes() const { return Data.Num(); }
+
+private:
+	TArray<uint8> Data;
+	TrialGhostFormat::FQuantSample Prev;
+	uint32 SampleRate = 30;
+	int32 NumSamples = 0;
+};
+
+// A ghost file mapped read-only; shared by every ghost playing it
+class TRIALTASK_API FTrialGhostTrack
+{
+public:
+	~FTrialGhostTrack();
+
+	// Maps the file (falls back to reading it when the platform can't map)
+	static TSharedPtr<FTrialGhostTrack> Open(const FString& Path);
+
+	const uint8* GetData() const { return Data; }
+	int64 GetSize() const { return Size; }
+	uint32 GetSampleRate() const { return SampleRate; }
+	uint32 GetNumSamples() const { return NumSamples; }
+	bool IsMapped() const { return Region != nullptr; }
+
+private:
+	TUniquePtr<IMappedFileHandle> Handle;
+	TUniquePtr<IMappedFileRegion> Region;
+	TArray<uint8> Loaded;
+
+	const uint8* Data = nullptr;	// first record
+	int64 Size = 0;
+	uint32 SampleRate = 30;
+	uint32 NumSamples = 0;
+};
+
+/**
+ * Time-trial ghosts. Recording samples a character's transform, velocity and traversal mode;
+ * playback decodes mapped ghost files forward and drives one instanced mesh per ghost: no actor,
+ * movement component, animation or collision per ghost. Ghosts loop their track.
+ * The instance's custom data [0] is the traversal mode, for a material to tint sprint / slide / vault / mantle.
+ *
+ * Trial.Ghost.Record [Rate] / Trial.Ghost.StopRecord <name> / Trial.Ghost.Play <name> [Count] [StaggerSec] /
+ * Trial.Ghost.Clear / Trial.Ghost.Report (GHOSTS line: per-ghost CPU and memory)
+ */
+UCLASS()
+class TRIALTASK_API UTrialGhostSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Relative names resolve to Saved/Ghosts/<Name>.tgh
+	static FString ResolvePath(const FString& Name);
+
+	bool StartRecording(ACustomCharacter* Character, uint32 SampleRate = 30);
+	bool StopRecording(const FString& Path);
+	bool IsRecording() const { return Recorder.IsValid(); }
+
+	// Count ghosts of one file, each StaggerSeconds behind the previous. Returns the number added.
+	int32 AddGhosts(const FString& Path, int32 Count, float StaggerSeconds);
+	void ClearGhosts();
+
+	int32 GetNumGhosts() const { return Ghosts.Num(); }
+
+	// Logs a GHOSTS line
+	void Report() const;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+private:
+	struct FGhost
+	{
+		int64 Offset = 0;	// next record
+		uint32 NextIndex = 0;	// sample index of Next
+		float Time = 0.f;	// seconds into the track
+		uint16 Track = 0;
+		uint8 ShownState = 0xFF;	// last state written to the instance custom data
+		TrialGhostFormat::FQuantSample Prev;
+		TrialGhostFormat::FQuantSample Next;
+	};
+
+	TArray<TSharedPtr<FTrialGhostTrack>> Tracks;
+	TMap<FString, uint16> TrackByPath;
+	TArray<FGhost> Ghosts;
+	TArray<FTransform> InstanceTransforms;
+
+	UPROPERTY(Transient)
+	TObjectPtr<AActor> VisualsActor;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UInstancedStaticMeshComponent> Visuals;
+
+	TUniquePtr<FTrialGhostRecorder> Recorder;
+	TWeakObjectPtr<ACustomCharacter> RecordedCharacter;
+	float RecordAccumulator = 0.f;	// seconds since the last sample
+
+	// State at the end of the previous recorded frame; samples due inside a frame interpolate from it
+	FVector RecordPrevLocation = FVector::ZeroVector;
+	FVector RecordPrevVelocity = FVector::ZeroVector;
+	float RecordPrevYaw = 0.f;
+
+	// Smoothed playback cost for Report
+	double AvgUpdateMicros = 0.0;
+
+	void TickRecording(float DeltaTime);
+	void TickPlayback(float DeltaTime);
+
+	// Decodes from the first record; Time is kept
+	void RestartGhost(FGhost& Ghost) const;
+	void AdvanceGhost(FGhost& Ghost) const;
+	bool EnsureVisuals();
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class APawn;
+
+// Input edges the latency probe follows to their first capsule motion
+enum class ETrialLatencyAction : uint8
+{
+	Move,		// move axis leaves zero at rest -> capsule moves
+	Sprint,		// sprint pressed at walk speed -> speed passes WalkSpeed
+	Slide,		// CrouchPressed starts a slide -> first PhysSlide move
+	Parkour,	// ParkourPressed -> first ParkourMoveStep
+
+	Num
+};
+
+/**
+ * Input-to-motion latency of the local player's character, in engine frames and milliseconds.
+ * Input handlers note the edge (GFrameCounter + time), movement code notes the first motion it caused;
+ * the difference goes into a per-action histogram. An edge that never moves the capsule
+ * (rejected slide, no parkour obstacle) is counted as dropped when the next edge replaces it or it goes stale.
+ * Game thread only; NoteMotion is one mask test while nothing is pending.
+ *
+ * Trial.Latency.Probe 1 / Trial.Latency.Report / Trial.Latency.Reset
+ * Tick ordering: Trial.Tick.EarlySprint, Trial.Tick.Order [TickGroup]
+ */
+struct TRIALTASK_API FTrialInputLatency
+{
+	static constexpr int32 NumBuckets = 6;	// 0..4 frames, 5+
+
+	static bool IsEnabled();
+
+	// Pawn must be player controlled and local; other pawns are ignored
+	static void NoteInput(const APawn* Pawn, ETrialLatencyAction Action);
+
+	static void NoteMotion(const APawn* Pawn, ETrialLatencyAction Action)
+	{
+		if (PendingMask & (1u << (uint8)Action))
+		{
+			CloseEdge(Pawn, Action);
+		}
+	}
+
+	static void Report();
+	static void Reset();
+
+	// Trial.Tick.EarlySprint: the movement component applies sprint requests before this frame's move
+	static bool UseEarlySprint();
+
+private:
+	static uint8 PendingMask;
+
+	static void CloseEdge(const APawn* Pawn, ETrialLatencyAction Action);
+};
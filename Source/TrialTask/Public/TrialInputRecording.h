@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TrialInputRecording.generated.h"
+
+// Button-style actions that can be injected without Enhanced Input (bots, soak tests, replays)
+UENUM(BlueprintType)
+enum class ETrialInputAction : uint8
+{
+	Jump,
+	Sprint,
+	Crouch,
+	Parkour,
+
+	Count UMETA(Hidden)
+};
+
+// Pawn state captured when a recording starts and restored before replay
+struct FTrialReplayInitialState
+{
+	FVector Location = FVector::ZeroVector;
+	FRotator Rotation = FRotator::ZeroRotator;
+	FRotator ControlRotation = FRotator::ZeroRotator;
+	FVector Velocity = FVector::ZeroVector;
+	float Stamina = 0.f;
+	uint8 MovementMode = 0;
+	uint8 CustomMovementMode = 0;
+	bool bIsCrouched = false;
+	uint8 HeldActionMask = 0;	// bit per ETrialInputAction held when recording started
+};
+
+// One engine frame of input
+struct FTrialInputFrame
+{
+	float DeltaSeconds = 0.f;
+	FVector2f Move = FVector2f::ZeroVector;	// X = right, Y = forward
+	FRotator3f ControlRotation = FRotator3f::ZeroRotator;	// result of Look this frame
+	uint8 PressedMask = 0;	// bit per ETrialInputAction
+	uint8 ReleasedMask = 0;
+
+	bool WasPressed(ETrialInputAction Action) const { return (PressedMask & (1u << (uint8)Action)) != 0; }
+	bool WasReleased(ETrialInputAction Action) const { return (ReleasedMask & (1u << (uint8)Action)) != 0; }
+};
+
+/**
+ * Initial state + per-frame input stream.
+ * On disk each frame is a flags byte, the edge masks and delta time; move axes and
+ * control rotation are only written when they changed from the previous frame.
+ */
+struct TRIALTASK_API FTrialInputRecording
+{
+	static constexpr uint32 Magic = 0x52495254; // "TRIR"
+	static constexpr uint32 Version = 2;
+
+	FTrialReplayInitialState Initial;
+	TArray<FTrialInputFrame> Frames;
+
+	bool SaveToFile(const FString& Path) const;
+	bool LoadFromFile(const FString& Path);
+};
+
+// Collects handler calls during a frame and commits them once per tick
+class TRIALTASK_API FTrialInputRecorder
+{
+public:
+	explicit FTrialInputRecorder(const FTrialReplayInitialState& Initial);
+
+	void NoteMoveForward(float Axis) { Pending.Move.Y = Axis; }
+	void NoteMoveRight(float Axis) { Pending.Move.X = Axis; }
+	void NoteAction(ETrialInputAction Action, bool bPressed);
+
+	void CommitFrame(float DeltaSeconds, const FRotator& ControlRotation);
+
+	const FTrialInputRecording& GetRecording() const { return Recording; }
+
+private:
+	FTrialInputRecording Recording;
+	FTrialInputFrame Pending;
+};
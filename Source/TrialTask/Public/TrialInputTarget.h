@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "TrialInputRecording.h"
+#include "TrialInputTarget.generated.h"
+
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class UTrialInputTarget : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * A pawn bots and soak tests can drive without Enhanced Input.
+ * Implemented by both movement backends (ACustomCharacter on CMC, ATrialMoverCharacter on Mover)
+ * so the same bot behaviors produce the same load on either.
+ */
+class TRIALTASK_API ITrialInputTarget
+{
+	GENERATED_BODY()
+
+public:
+	// X = right axis, Y = forward axis
+	virtual void InjectMoveInput(const FVector2D& Axes) = 0;
+	virtual void InjectLookInput(const FVector2D& Axes) = 0;
+	virtual void InjectAction(ETrialInputAction Action, bool bPressed) = 0;
+
+	// Movement state the bot decisions react to
+	virtual bool IsSprintActive() const = 0;
+	virtual bool IsSlideActive() const = 0;
+	virtual bool IsTraversalActive() const = 0;
+};
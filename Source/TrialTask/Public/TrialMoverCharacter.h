@@ -0,0 +1,91 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Pawn.h"
+#include "InputActionValue.h"
+#include "MoverSimulationTypes.h"
+#include "TrialInputTarget.h"
+#include "TrialMoverCharacter.generated.h"
+
+class ACustomCharacter;
+class UCameraComponent;
+class UCapsuleComponent;
+class USkeletalMeshComponent;
+class UTrialMoverComponent;
+
+/**
+ * Same player character on the Mover backend instead of the CMC. Pick it per pawn class
+ * (game mode DefaultPawnClass, ATrialBotController::BotCharacterClass, -SoakPawn=TrialMoverCharacter).
+ * Tuning and input assets come from TuningSourceClass, so both backends always run the same numbers.
+ */
+UCLASS(Config = Game)
+class TRIALTASK_API ATrialMoverCharacter : public APawn, public IMoverInputProducerInterface, public ITrialInputTarget
+{
+	GENERATED_BODY()
+
+public:
+	ATrialMoverCharacter(const FObjectInitializer& ObjectInitializer);
+
+	// CMC character whose defaults (and movement component defaults) provide tuning, capsule and input assets
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Movement")
+	FSoftClassPath TuningSourceClass;
+
+	UTrialMoverComponent* GetTrialMover() const { return MoverComponent; }
+
+	virtual FVector GetVelocity() const override;
+
+	// --------------------
+	// ITrialInputTarget
+	// --------------------
+	virtual void InjectMoveInput(const FVector2D& Axes) override;
+	virtual void InjectLookInput(const FVector2D& Axes) override;
+	virtual void InjectAction(ETrialInputAction Action, bool bPressed) override;
+
+	virtual bool IsSprintActive() const override;
+	virtual bool IsSlideActive() const override;
+	virtual bool IsTraversalActive() const override;
+
+protected:
+	virtual void PostInitializeComponents() override;
+	virtual void BeginPlay() override;
+	virtual void SetupPlayerInputComponent(UInputComponent* PlayerInputComponent) override;
+
+	// Called by the Mover backend once per simulation input frame
+	virtual void ProduceInput_Implementation(int32 SimTimeMs, FMoverInputCmdContext& InputCmdResult) override;
+
+	// Enhanced Input handlers (same bindings as ACustomCharacter)
+	void MoveForward(const FInputActionValue& Value);
+	void MoveRight(const FInputActionValue& Value);
+	void Look(const FInputActionValue& Value);
+	void SprintPressed(const FInputActionValue& Value) { InjectAction(ETrialInputAction::Sprint, true); }
+	void SprintReleased(const FInputActionValue& Value) { InjectAction(ETrialInputAction::Sprint, false); }
+	void CrouchPressed(const FInputActionValue& Value) { InjectAction(ETrialInputAction::Crouch, true); }
+	void CrouchReleased(const FInputActionValue& Value) { InjectAction(ETrialInputAction::Crouch, false); }
+	void JumpPressed(const FInputActionValue& Value) { InjectAction(ETrialInputAction::Jump, true); }
+	void JumpReleased(const FInputActionValue& Value) { InjectAction(ETrialInputAction::Jump, false); }
+	void ParkourPressed(const FInputActionValue& Value) { InjectAction(ETrialInputAction::Parkour, true); }
+
+private:
+	UPROPERTY(VisibleAnywhere)
+	TObjectPtr<UCapsuleComponent> CapsuleComponent;
+
+	UPROPERTY(VisibleAnywhere)
+	TObjectPtr<USkeletalMeshComponent> Mesh;
+
+	UPROPERTY(VisibleAnywhere)
+	TObjectPtr<UCameraComponent> FirstPersonCamera;
+
+	UPROPERTY(VisibleAnywhere)
+	TObjectPtr<UTrialMoverComponent> MoverComponent;
+
+	// Input gathered since the last ProduceInput (X = right, Y = forward)
+	FVector2D PendingMove = FVector2D::ZeroVector;
+	bool bSprintHeld = false;
+	bool bCrouchHeld = false;
+	bool bJumpHeld = false;
+	bool bJumpJustPressed = false;
+	bool bCrouchJustPressed = false;
+	bool bParkourJustPressed = false;
+
+	const ACustomCharacter* GetTuningSource() const;
+};
@@ -0,0 +1,212 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CustomCharacter.h"
+#include "DefaultMovementSet/CharacterMoverComponent.h"
+#include "MoverTypes.h"
+#include "TrialMoverComponent.generated.h"
+
+class UCustomMovementComponent;
+
+namespace TrialMoverModes
+{
+	// Walking / Falling reuse the default mode names so the stock floor and jump logic finds them
+	extern TRIALTASK_API const FName Slide;
+	extern TRIALTASK_API const FName Traversal;
+}
+
+/**
+ * Extra per-command input for the Mover backend (move / look / jump go through FCharacterDefaultInputs).
+ * Presses are edges so a held button is not re-triggered on resimulation.
+ */
+USTRUCT()
+struct TRIALTASK_API FTrialMoverInputs : public FMoverDataStructBase
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	bool bSprintHeld = false;
+
+	UPROPERTY()
+	bool bCrouchHeld = false;
+
+	UPROPERTY()
+	bool bCrouchJustPressed = false;
+
+	UPROPERTY()
+	bool bParkourJustPressed = false;
+
+	virtual FMoverDataStructBase* Clone() const override { return new FTrialMoverInputs(*this); }
+	virtual bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess) override;
+	virtual UScriptStruct* GetScriptStruct() const override { return StaticStruct(); }
+	virtual void ToString(FAnsiStringBuilderBase& Out) const override;
+	virtual void Merge(const FMoverDataStructBase& From) override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FTrialMoverInputs> : public TStructOpsTypeTraitsBase2<FTrialMoverInputs>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithCopy = true
+	};
+};
+
+/**
+ * Sprint / stamina / slide / traversal state, carried in the Mover sync state so it is predicted,
+ * reconciled and rolled back together with the transform (the CMC keeps these as component members).
+ */
+USTRUCT()
+struct TRIALTASK_API FTrialMoverSyncState : public FMoverDataStructBase
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	float Stamina = 100.f;
+
+	UPROPERTY()
+	float TimeSinceSprintEnded = 999.f;
+
+	UPROPERTY()
+	bool bSprinting = false;
+
+	UPROPERTY()
+	bool bSliding = false;
+
+	// Traversal (same start -> apex -> target move as ACustomCharacter)
+	UPROPERTY()
+	EParkourType Parkour = EParkourType::None;
+
+	UPROPERTY()
+	EParkourPhase Phase = EParkourPhase::None;
+
+	UPROPERTY()
+	float PhaseElapsed = 0.f;
+
+	UPROPERTY()
+	FVector ParkourStart = FVector::ZeroVector;
+
+	UPROPERTY()
+	FVector ParkourApex = FVector::ZeroVector;
+
+	UPROPERTY()
+	FVector ParkourTarget = FVector::ZeroVector;
+
+	virtual FMoverDataStructBase* Clone() const override { return new FTrialMoverSyncState(*this); }
+	virtual bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess) override;
+	virtual UScriptStruct* GetScriptStruct() const override { return StaticStruct(); }
+	virtual void ToString(FAnsiStringBuilderBase& Out) const override;
+	virtual bool ShouldReconcile(const FMoverDataStructBase& AuthorityState) const override;
+	virtual void Interpolate(const FMoverDataStructBase& From, const FMoverDataStructBase& To, float Pct) override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FTrialMoverSyncState> : public TStructOpsTypeTraitsBase2<FTrialMoverSyncState>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithCopy = true
+	};
+};
+
+// Tuning copied from the CMC character (class defaults, then the tuning source), so both backends run identical numbers.
+// No defaults of its own: UTrialMoverComponent fills it from the CDOs.
+struct FTrialMoverTuning
+{
+	// UCustomMovementComponent
+	float WalkSpeed = 0.f;
+	float SprintSpeed = 0.f;
+	float BrakingDecelerationWalking = 0.f;
+	float StaminaMax = 0.f;
+	float StaminaRegenPerSec = 0.f;
+	float SprintDrainPerSec = 0.f;
+	float SlideDrainPerSec = 0.f;
+	float MinStaminaToSprint = 0.f;
+	float MinStaminaToSlide = 0.f;
+	float SlideMinStartSpeed = 0.f;
+	float SlideMinSpeedToKeep = 0.f;
+	float SlideFlatDecel = 0.f;
+	float SlideMaxSpeedFlat = 0.f;
+	float SlideMaxSpeedDownhill = 0.f;
+	float SlideUphillDecel = 0.f;
+	float SlideDownhillAccel = 0.f;
+	float SlideSteerAccel = 0.f;
+	float SlideSlopeAngleMinDeg = 0.f;
+	float PostSprintSlideGraceTime = 0.f;
+
+	// ACustomCharacter
+	float ParkourFrontCheckDistance = 0.f;
+	float ParkourFrontCheckRadius = 0.f;
+	float ParkourTopTraceHeight = 0.f;
+	float VaultMaxObstacleHeight = 0.f;
+	float MantleMaxObstacleHeight = 0.f;
+	float ParkourLandForwardOffset = 0.f;
+	float ParkourLandUpOffset = 0.f;
+	float ParkourLandingForwardExtra = 0.f;
+	float ParkourLandingCapsuleInflate = 0.f;
+	float VaultToApexDuration = 0.f;
+	float VaultToTargetDuration = 0.f;
+	float MantleToApexDuration = 0.f;
+	float MantleToTargetDuration = 0.f;
+	float ApexForwardExtra = 0.f;
+	float ApexUpExtra = 0.f;
+
+	void CopyFrom(const ACustomCharacter& Character, const UCustomMovementComponent& Move);
+
+	float GetPhaseDuration(EParkourType Type, EParkourPhase Phase) const;
+};
+
+/**
+ * Mover-based implementation of walk / sprint, slide (CMOVE_Slide) and vault / mantle.
+ * Registers the Trial modes, carries FTrialMoverSyncState across frames and owns the query params
+ * and tuning the modes read. Simulation rules mirror UCustomMovementComponent and ACustomCharacter.
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class TRIALTASK_API UTrialMoverComponent : public UCharacterMoverComponent
+{
+	GENERATED_BODY()
+
+public:
+	UTrialMoverComponent();
+
+	// Copies tuning from the character class (its CDO and CDO movement component) and applies the
+	// CMC walking values (acceleration, braking, friction, step height, jump) to the shared Mover settings
+	void ApplyTuning(const ACustomCharacter& Source);
+
+	const FTrialMoverTuning& GetTuning() const { return Tuning; }
+	const FCollisionQueryParams& GetQueryParams() const { return QueryParams; }
+
+	// Last simulated state (what the game thread / animation sees)
+	const FTrialMoverSyncState* GetTrialSyncState() const;
+
+	bool IsSprinting() const;
+	bool IsSliding() const;
+	bool IsTraversing() const;
+	float GetStamina() const;
+
+	// --------------------
+	// Simulation helpers shared by the Trial modes
+	// --------------------
+	// UpdateStamina + UpdateMaxSpeed of the CMC path, for one sim step
+	void TickStamina(FTrialMoverSyncState& State, const FTrialMoverInputs* Inputs, bool bOnGround, float DeltaSeconds) const;
+
+	bool CanStartSlide(const FTrialMoverSyncState& State, float HorizontalSpeed) const;
+
+	// FindParkourObstacle + DecideParkourType + apex / landing of ACustomCharacter, from a sim location.
+	// Fills the traversal fields of OutState on success.
+	bool FindTraversal(const FVector& Location, const FQuat& Orientation, FTrialMoverSyncState& OutState) const;
+
+protected:
+	virtual void BeginPlay() override;
+
+private:
+	FTrialMoverTuning Tuning;
+
+	// Built once (constructing them per query allocates)
+	FCollisionQueryParams QueryParams;
+
+	float CapsuleRadius = 34.f;
+	float CapsuleHalfHeight = 88.f;
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DefaultMovementSet/Modes/FallingMode.h"
+#include "DefaultMovementSet/Modes/WalkingMode.h"
+#include "MovementMode.h"
+#include "TrialMoverModes.generated.h"
+
+/**
+ * Walking with sprint: the shared MaxSpeed is the sprint speed and the proposed move is capped to the
+ * walk speed while not sprinting (same result as the CMC switching MaxWalkSpeed).
+ * Also starts slides and traversals from the input edges.
+ */
+UCLASS()
+class TRIALTASK_API UTrialMoverWalkingMode : public UWalkingMode
+{
+	GENERATED_BODY()
+
+protected:
+	virtual void GenerateMove_Implementation(const FMoverTickStartData& StartState, const FMoverTimeStep& TimeStep, FProposedMove& OutProposedMove) const override;
+	virtual void SimulationTick_Implementation(const FSimulationTickParams& Params, FMoverTickEndData& OutputState) override;
+};
+
+// Falling that keeps regenerating stamina (the CMC ticks stamina in every mode)
+UCLASS()
+class TRIALTASK_API UTrialMoverFallingMode : public UFallingMode
+{
+	GENERATED_BODY()
+
+protected:
+	virtual void SimulationTick_Implementation(const FSimulationTickParams& Params, FMoverTickEndData& OutputState) override;
+};
+
+// PhysSlide: steering, downhill pull, uphill / flat braking and the speed caps, one floor query per step
+UCLASS()
+class TRIALTASK_API UTrialMoverSlideMode : public UBaseMovementMode
+{
+	GENERATED_BODY()
+
+public:
+	UTrialMoverSlideMode();
+
+protected:
+	virtual void GenerateMove_Implementation(const FMoverTickStartData& StartState, const FMoverTimeStep& TimeStep, FProposedMove& OutProposedMove) const override;
+	virtual void SimulationTick_Implementation(const FSimulationTickParams& Params, FMoverTickEndData& OutputState) override;
+};
+
+// Vault / mantle: geometric start -> apex -> target move from the sync state, no gravity
+UCLASS()
+class TRIALTASK_API UTrialMoverTraversalMode : public UBaseMovementMode
+{
+	GENERATED_BODY()
+
+protected:
+	virtual void GenerateMove_Implementation(const FMoverTickStartData& StartState, const FMoverTimeStep& TimeStep, FProposedMove& OutProposedMove) const override;
+	virtual void SimulationTick_Implementation(const FSimulationTickParams& Params, FMoverTickEndData& OutputState) override;
+};
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "GameFramework/Actor.h"
+#include "TrialParkourObstacle.generated.h"
+
+// Traversal data of the obstacle a front sweep hit
+struct FTrialParkourObstacleInfo
+{
+	// World Z of the obstacle top; only valid with bHasTop (otherwise the caller traces for it)
+	float TopZ = 0.f;
+	bool bHasTop = false;
+
+	bool bAllowVault = true;
+	bool bAllowMantle = true;
+};
+
+namespace TrialParkourObstacle
+{
+	// Actor tag of legacy per-actor obstacles (BP_Parkourable)
+	TRIALTASK_API extern const FName Tag;
+
+	// Extra tags on a tagged actor: the per-actor counterpart of the instance disallow flags
+	TRIALTASK_API extern const FName NoVaultTag;
+	TRIALTASK_API extern const FName NoMantleTag;
+
+	// Instanced obstacles resolve through FHitResult::Item, anything else needs the actor tag
+	TRIALTASK_API bool Resolve(const FHitResult& Hit, FTrialParkourObstacleInfo& OutInfo);
+}
+
+/**
+ * Many parkour obstacles as HISM instances: one actor, one draw / collision proxy set, no tag check.
+ * Per-instance traversal data lives in the instance custom data:
+ *   [0] top height in mesh space (0 = mesh bounds top), scaled by the instance Z scale
+ *   [1] disallow flags (1 = no vault, 2 = no mantle; 0 = both allowed)
+ * Zeroed custom data (instances painted or added in the editor) means "mesh top, everything allowed".
+ * Instances are assumed upright.
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class TRIALTASK_API UTrialParkourObstacleComponent : public UHierarchicalInstancedStaticMeshComponent
+{
+	GENERATED_BODY()
+
+public:
+	static constexpr int32 CustomDataTopHeight = 0;
+	static constexpr int32 CustomDataFlags = 1;
+	static constexpr int32 NumTraversalCustomData = 2;
+
+	static constexpr int32 FlagNoVault = 1 << 0;
+	static constexpr int32 FlagNoMantle = 1 << 1;
+
+	UTrialParkourObstacleComponent(const FObjectInitializer& ObjectInitializer);
+
+	// Adds an obstacle instance. TopHeight is in world units above the instance origin (<= 0 = mesh bounds top).
+	UFUNCTION(BlueprintCallable, Category = "Parkour")
+	int32 AddObstacle(const FTransform& Transform, bool bWorldSpace = true, float TopHeight = 0.f, bool bAllowVault = true, bool bAllowMantle = true);
+
+	UFUNCTION(BlueprintCallable, Category = "Parkour")
+	void SetObstacleTraversal(int32 InstanceIndex, float TopHeight, bool bAllowVault, bool bAllowMantle);
+
+	bool GetObstacleInfo(int32 InstanceIndex, FTrialParkourObstacleInfo& OutInfo) const;
+
+	// Server validation: Point lies within Slack of some instance's bounds
+	bool IsPointOnObstacle(const FVector& Point, float Slack) const;
+
+protected:
+	virtual void OnRegister() override;
+};
+
+/**
+ * Placeable field of instanced parkour obstacles. Carries the Parkourable tag so server-side
+ * validation of the obstacle actor works unchanged.
+ */
+UCLASS()
+class TRIALTASK_API ATrialParkourObstacleField : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ATrialParkourObstacleField(const FObjectInitializer& ObjectInitializer);
+
+	UTrialParkourObstacleComponent* GetObstacles() const { return Obstacles; }
+
+private:
+	UPROPERTY(VisibleAnywhere, Category = "Parkour")
+	TObjectPtr<UTrialParkourObstacleComponent> Obstacles;
+};
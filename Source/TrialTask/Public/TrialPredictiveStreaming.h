@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "SlideTrajectoryPredictor.h"
+#include "WorldPartition/WorldPartitionStreamingSource.h"
+#include "TrialPredictiveStreaming.generated.h"
+
+class ACustomCharacter;
+
+/**
+ * Late streaming seen by predictive streaming components: how often the ground right around a player pawn
+ * (where FindFloor and FindParkourObstacle query) was not activated yet. Game thread only.
+ * Trial.Streaming.Report / Trial.Streaming.Reset
+ */
+struct TRIALTASK_API FTrialStreamingStats
+{
+	static uint64 Probes;
+	static uint64 LateProbes;
+	static uint32 LateEvents;	// pawn entered not-yet-activated ground (rising edges of LateProbes)
+	static double LateSeconds;
+	static float MaxLateSpeed;
+
+	static void Report();
+	static void Reset();
+};
+
+/**
+ * Extra World Partition streaming source of a fast player pawn: a chain of small shapes (grid loading range
+ * scaled by Trial.Streaming.ShapeScale) along where the pawn will be in Trial.Streaming.Lookahead seconds,
+ * at high priority while sliding or sprinting. Slides follow the slide prediction (PhysSlide rules over
+ * the floor ahead), everything else the current velocity. Below Trial.Streaming.MinSpeed there is no extra
+ * source, so the player controller's own source is all that streams and no one's radius grows.
+ * Active for player pawns on the machine that streams for them (owning client, listen / dedicated server);
+ * everywhere else it does not tick and is not registered with World Partition.
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class TRIALTASK_API UTrialPredictiveStreamingComponent : public UActorComponent, public IWorldPartitionStreamingSourceProvider
+{
+	GENERATED_BODY()
+
+public:
+	UTrialPredictiveStreamingComponent();
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	// IWorldPartitionStreamingSourceProvider
+	virtual bool GetStreamingSources(TArray<FWorldPartitionStreamingSource>& OutStreamingSources) const override;
+	virtual UObject* GetStreamingSourceOwner() override { return this; }
+
+	// Ticks and registers as a streaming source only while the owner is a player pawn this machine streams for.
+	// The owner calls it when its controller changes (possession, unpossession, client restart).
+	void RefreshStreamingRole();
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	bool ShouldStreamFor(const ACustomCharacter& Character) const;
+	void StopStreaming();
+	void UpdateSource(const ACustomCharacter& Character, float DeltaTime);
+	void ProbeLateStreaming(const ACustomCharacter& Character, float DeltaTime);
+
+	FWorldPartitionStreamingSource Source;
+	bool bSourceActive = false;
+	bool bRegistered = false;
+
+	// Slide path ahead, a few floor traces per tick. Allocated on the first fast slide (most pawns never need it).
+	TUniquePtr<FSlideTrajectoryPredictor> SlidePrediction;
+
+	bool bWasLate = false;
+	float ProbeTimeLeft = 0.f;
+};
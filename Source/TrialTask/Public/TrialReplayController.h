@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Controller.h"
+#include "TrialInputRecording.h"
+#include "TrialReplayController.generated.h"
+
+class ACustomCharacter;
+
+/**
+ * Feeds a recorded input stream back into ACustomCharacter, one recorded frame per engine frame.
+ * The engine runs on a fixed time step set to each frame's recorded delta, and the controller ticks
+ * before its pawn (pawn tick dependency), so the pawn sees input in the same order as a player controller.
+ * Look is replayed as the recorded control rotation rather than raw axes, so replays don't depend on mouse scaling.
+ *
+ * Trial.Input.Record / Trial.Input.StopRecord <file> / Trial.Input.Replay <file>
+ * Headless: -TrialReplay=<file> [-TrialReplayQuit]
+ */
+UCLASS()
+class TRIALTASK_API ATrialReplayController : public AController
+{
+	GENERATED_BODY()
+
+public:
+	ATrialReplayController();
+
+	static ATrialReplayController* StartReplay(ACustomCharacter* Pawn, const FString& Path, bool bQuitWhenDone);
+
+	// Starts -TrialReplay=<file> once for the first locally controlled character
+	static void StartFromCommandLine(ACustomCharacter* Pawn);
+
+	// Relative names resolve to Saved/InputReplays/<Name>.tir
+	static FString ResolvePath(const FString& Name);
+
+protected:
+	virtual void Tick(float DeltaSeconds) override;
+
+private:
+	FTrialInputRecording Recording;
+	int32 FrameIndex = 0;
+	int32 DeltaMismatches = 0;
+	double StartSeconds = 0.0;
+
+	UPROPERTY(Transient)
+	TObjectPtr<ACustomCharacter> ReplayPawn;
+
+	UPROPERTY(Transient)
+	TObjectPtr<AController> PreviousController;
+
+	bool bQuitWhenDone = false;
+	bool bSavedUseFixedTimeStep = false;
+	double SavedFixedDeltaTime = 0.0;
+
+	void Finish();
+};
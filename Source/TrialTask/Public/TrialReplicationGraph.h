@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReplicationGraph.h"
+#include "TrialReplicationGraph.generated.h"
+
+class UReplicationGraphNode_GridSpatialization2D;
+class UReplicationGraphNode_ActorList;
+class UReplicationGraphNode_AlwaysRelevant_ForConnection;
+
+/**
+ * Replication graph for many traversal characters.
+ * - Characters go into a 2D grid, so relevancy is spatial instead of a per-actor distance check.
+ * - Game state / player states replicate through an always-relevant list.
+ * - Each connection's controller and pawn are always relevant to that connection.
+ * - Characters that are idle (not sprinting, sliding or traversing) replicate less often.
+ * Enabled through ReplicationDriverClassName in DefaultEngine.ini.
+ */
+UCLASS(Transient, Config = Engine)
+class TRIALTASK_API UTrialReplicationGraph : public UReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(Config)
+	float GridCellSize = 10000.f;
+
+	// Must cover the playable area's min corner; actors outside it are clamped into edge cells
+	UPROPERTY(Config)
+	FVector2D SpatialBias = FVector2D(-200000.f, -200000.f);
+
+	UPROPERTY(Config)
+	float CharacterCullDistance = 15000.f;
+
+	// Replication period (in server frames) for characters that are moving / traversing vs idle
+	UPROPERTY(Config)
+	int32 ActivePeriodFrames = 1;
+
+	UPROPERTY(Config)
+	int32 IdlePeriodFrames = 6;
+
+	static UTrialReplicationGraph* Get(const UWorld* World);
+
+	// Called by the character on the server when its activity changes
+	void SetTraversalActive(AActor* Actor, bool bActive);
+
+	virtual void InitGlobalActorClassSettings() override;
+	virtual void InitGlobalGraphNodes() override;
+	virtual void InitConnectionGraphNodes(UNetReplicationGraphConnection* ConnectionManager) override;
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+	virtual int32 ServerReplicateActors(float DeltaSeconds) override;
+
+private:
+	UPROPERTY()
+	TObjectPtr<UReplicationGraphNode_GridSpatialization2D> GridNode;
+
+	UPROPERTY()
+	TObjectPtr<UReplicationGraphNode_ActorList> AlwaysRelevantNode;
+
+	enum class ERouting : uint8
+	{
+		None,		// owner-only actors (controllers) come from the per-connection node
+		Grid,
+		GridStatic,
+		AlwaysRelevant
+	};
+
+	ERouting GetRouting(const AActor* Actor) const;
+};
+
+// Server replication timing per player count, for the local multi-client benchmark (Trial.RepBench.Report)
+struct TRIALTASK_API FTrialRepBenchStats
+{
+	struct FBucket
+	{
+		double TotalMs = 0.0;
+		double MaxMs = 0.0;
+		int64 Frames = 0;
+		int64 ActorsReplicated = 0;
+	};
+
+	static TMap<int32, FBucket>& Buckets();
+	static void Add(int32 NumConnections, double Ms, int32 NumReplicated);
+	static void Report();
+	static void Reset();
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "UObject/ObjectKey.h"
+#include "TrialSlideSurfaces.generated.h"
+
+class UPhysicalMaterial;
+class UPrimitiveComponent;
+
+// Slide feel of one physical material, as multipliers of the movement component's slide tuning
+USTRUCT(BlueprintType)
+struct FTrialSlideSurfaceProfile
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Slide")
+	TObjectPtr<UPhysicalMaterial> PhysicalMaterial;
+
+	// x the slide's braking (SlideFlatDecel on flat ground, SlideUphillDecel against a slope)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Slide", meta = (ClampMin = "0"))
+	float FrictionScale = 1.f;
+
+	// x SlideFlatDecel (ice < 1, grass > 1)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Slide", meta = (ClampMin = "0"))
+	float FlatDecelScale = 1.f;
+
+	// x SlideDownhillAccel
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Slide", meta = (ClampMin = "0"))
+	float DownhillAccelScale = 1.f;
+};
+
+UCLASS(BlueprintType)
+class TRIALTASK_API UTrialSlideSurfaceTable : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	// Materials not listed here (and floors without one) slide with the unscaled tuning
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Slide")
+	TArray<FTrialSlideSurfaceProfile> Profiles;
+};
+
+// Resolved multipliers read by the slide step
+struct FTrialSlideSurface
+{
+	float Friction = 1.f;
+	float FlatDecel = 1.f;
+	float DownhillAccel = 1.f;
+};
+
+/**
+ * UTrialSlideSurfaceTable flattened for the movement hot path: entry 0 is the default surface,
+ * the others follow the table's profiles. Materials map to an index once, when the floor changes;
+ * per tick the slide only reads Surfaces[Index].
+ */
+class TRIALTASK_API FTrialSlideSurfaceCache
+{
+public:
+	static constexpr uint8 DefaultIndex = 0;
+
+	FTrialSlideSurfaceCache() { Surfaces.AddDefaulted(1); }
+
+	void Build(const UTrialSlideSurfaceTable* Table);
+
+	// Index of the floor body's simple collision material. Per component, never per hit: PhysSlide's floor
+	// sweep and the trajectory predictor's line trace must land on the same surface for the same floor.
+	uint8 Resolve(const UPrimitiveComponent* Floor) const;
+
+	const FTrialSlideSurface& Get(uint8 Index) const { checkSlow(Surfaces.IsValidIndex(Index)); return Surfaces[Index]; }
+
+	// Changes on every Build; indices resolved under another generation are stale
+	uint32 GetGeneration() const { return Generation; }
+
+private:
+	TArray<FTrialSlideSurface, TInlineAllocator<8>> Surfaces;
+	uint32 Generation = 0;
+	TMap<TObjectKey<UPhysicalMaterial>, uint8> IndexByMaterial;
+};
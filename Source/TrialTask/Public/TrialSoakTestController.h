@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GauntletTestController.h"
+#include "TrialSoakTestController.generated.h"
+
+class APawn;
+
+/**
+ * Gauntlet controller for the headless TestingArea soak (-gauntlet=TrialSoakTestController).
+ * Spawns ATrialBotController-driven characters, runs them for a fixed duration, captures a CSV profile and
+ * exits non-zero when game-thread frame time or traversal query counts exceed the baselines below.
+ * Command line overrides: -SoakBots=N -SoakDuration=Seconds -SoakBehavior=Name -SoakPawn=Class (CMC vs Mover backend)
+ */
+UCLASS(Config = Game)
+class TRIALTASK_API UTrialSoakTestController : public UGauntletTestController
+{
+	GENERATED_BODY()
+
+public:
+	// Map the soak expects to run in (matched against the loaded world name)
+	UPROPERTY(Config)
+	FString MapName = TEXT("TestingArea");
+
+	UPROPERTY(Config)
+	int32 NumBots = 16;
+
+	// ATrialBotController behavior for every bot; None cycles through all configured behaviors
+	UPROPERTY(Config)
+	FName BotBehavior;
+
+	// Bot pawn class; empty uses ATrialBotController::BotCharacterClass
+	UPROPERTY(Config)
+	FString PawnClass;
+
+	UPROPERTY(Config)
+	float WarmupSeconds = 5.0f;
+
+	UPROPERTY(Config)
+	float DurationSeconds = 120.0f;
+
+	// Give up if the map never loads
+	UPROPERTY(Config)
+	float MapLoadTimeoutSeconds = 120.0f;
+
+	// --------------------
+	// Baselines
+	// --------------------
+	UPROPERTY(Config)
+	float MaxAvgGameThreadMs = 8.0f;
+
+	UPROPERTY(Config)
+	float MaxP95GameThreadMs = 12.0f;
+
+	UPROPERTY(Config)
+	float MaxQueriesPerBotPerFrame = 6.0f;
+
+	// Steady-state hot-path allocations (only checked when Parkour.AllocCheck is enabled)
+	UPROPERTY(Config)
+	int32 MaxAllocViolations = 0;
+
+protected:
+	virtual void OnInit() override;
+	virtual void OnTick(float TimeDelta) override;
+
+private:
+	enum class ESoakPhase : uint8
+	{
+		WaitingForMap,
+		Warmup,
+		Measuring,
+		Done
+	};
+
+	ESoakPhase Phase = ESoakPhase::WaitingForMap;
+	float PhaseTime = 0.f;
+
+	TArray<TWeakObjectPtr<APawn>> Bots;
+	FString BotClassName;
+
+	// Measured window
+	TArray<float> GameThreadMs;
+	uint64 QueriesAtStart = 0;
+	uint64 AllocViolationsAtStart = 0;
+
+	bool SpawnBots();
+	void BeginMeasuring();
+	void FinishAndReport();
+};
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "TrialStressMap.generated.h"
+
+class AActor;
+class UHierarchicalInstancedStaticMeshComponent;
+class UStaticMeshComponent;
+
+namespace TrialStressMap
+{
+	// PlayerStartTag of generated spawn points; ATrialBotController::SpawnBots uses only these when present
+	TRIALTASK_API extern const FName SpawnTag;
+}
+
+/**
+ * Deterministic stress level for traversal benchmarks: a square grid of CellSize cells from the actor origin,
+ * each holding a parkour obstacle, a ramp (slope field) or nothing, plus untagged clutter and bot spawn points.
+ * Every cell draws from its own stream (Seed, cell X, Y), so a seed always gives the same level and a
+ * smaller map is the corner of a larger one. Lanes between cells stay clear for spawning and running.
+ *
+ * Obstacles go into one ATrialParkourObstacleField (instanced, the 100k case) or, with ObstacleActorClass
+ * (BP_Parkourable), one actor each for actor-vs-instance comparisons (restrictions as ParkourNoVault /
+ * ParkourNoMantle tags).
+ * Editor: place, set counts, press Generate and save the level. Runtime: Trial.StressMap.
+ */
+UCLASS()
+class TRIALTASK_API ATrialStressMapGenerator : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ATrialStressMapGenerator(const FObjectInitializer& ObjectInitializer);
+
+	UPROPERTY(EditAnywhere, Category = "Stress Map")
+	int32 Seed = 1;
+
+	UPROPERTY(EditAnywhere, Category = "Stress Map", meta = (ClampMin = "0"))
+	int32 ObstacleCount = 1000;
+
+	// One obstacle or ramp per cell: density is 1 / CellSize^2
+	UPROPERTY(EditAnywhere, Category = "Stress Map", meta = (ClampMin = "300"))
+	float CellSize = 800.f;
+
+	UPROPERTY(EditAnywhere, Category = "Stress Map|Obstacles")
+	FVector2D ObstacleHeightRange = FVector2D(100.f, 260.f);
+
+	// Width and depth, each drawn from this range (capped to 60% of a cell)
+	UPROPERTY(EditAnywhere, Category = "Stress Map|Obstacles")
+	FVector2D ObstacleFootprintRange = FVector2D(40.f, 300.f);
+
+	// Share of obstacles that only allow a mantle / only a vault
+	UPROPERTY(EditAnywhere, Category = "Stress Map|Obstacles", meta = (ClampMin = "0", ClampMax = "1"))
+	float RestrictedFraction = 0.1f;
+
+	// Spawns this class per obstacle instead of instances (far heavier; keep counts low)
+	UPROPERTY(EditAnywhere, Category = "Stress Map|Obstacles")
+	TSoftClassPtr<AActor> ObstacleActorClass;
+
+	// Share of cells holding a ramp instead of an obstacle
+	UPROPERTY(EditAnywhere, Category = "Stress Map|Slopes", meta = (ClampMin = "0", ClampMax = "0.9"))
+	float SlopeFraction = 0.15f;
+
+	UPROPERTY(EditAnywhere, Category = "Stress Map|Slopes")
+	FVector2D SlopeAngleRange = FVector2D(8.f, 40.f);
+
+	// Average untagged boxes per cell (front sweeps that hit them find no obstacle)
+	UPROPERTY(EditAnywhere, Category = "Stress Map|Clutter", meta = (ClampMin = "0"))
+	float ClutterPerCell = 1.f;
+
+	UPROPERTY(EditAnywhere, Category = "Stress Map|Clutter")
+	FVector2D ClutterSizeRange = FVector2D(15.f, 60.f);
+
+	UPROPERTY(EditAnywhere, Category = "Stress Map|Bots", meta = (ClampMin = "0"))
+	int32 BotSpawnPoints = 32;
+
+	UPROPERTY(EditAnywhere, Category = "Stress Map")
+	bool bGenerateOnBeginPlay = false;
+
+	UFUNCTION(CallInEditor, BlueprintCallable, Category = "Stress Map")
+	void Generate();
+
+	UFUNCTION(CallInEditor, BlueprintCallable, Category = "Stress Map")
+	void Clear();
+
+	// Cells per side for the current settings
+	int32 GetSide() const;
+
+	const TArray<FTransform>& GetSpawnTransforms() const { return SpawnTransforms; }
+
+protected:
+	virtual void BeginPlay() override;
+
+private:
+	UPROPERTY(VisibleAnywhere, Category = "Stress Map")
+	TObjectPtr<UStaticMeshComponent> Floor;
+
+	UPROPERTY(VisibleAnywhere, Category = "Stress Map")
+	TObjectPtr<UHierarchicalInstancedStaticMeshComponent> Slopes;
+
+	UPROPERTY(VisibleAnywhere, Category = "Stress Map")
+	TObjectPtr<UHierarchicalInstancedStaticMeshComponent> Clutter;
+
+	// Obstacle field or obstacle actors, and spawn points
+	UPROPERTY()
+	TArray<TObjectPtr<AActor>> GeneratedActors;
+
+	UPROPERTY()
+	TArray<FTransform> SpawnTransforms;
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+
+// Low-Level Memory Tracker tags for the TrialTask module.
+// Subsystem tags are children of TrialTask, so the module total rolls up in LLM captures.
+LLM_DECLARE_TAG_API(TrialTask, TRIALTASK_API);
+LLM_DECLARE_TAG_API(TrialTask_Parkour, TRIALTASK_API);
+LLM_DECLARE_TAG_API(TrialTask_Movement, TRIALTASK_API);
+LLM_DECLARE_TAG_API(TrialTask_Anim, TRIALTASK_API);
+LLM_DECLARE_TAG_API(TrialTask_HUD, TRIALTASK_API);
+LLM_DECLARE_TAG_API(TrialTask_Caches, TRIALTASK_API);
+
+// Unique names as registered with LLM (underscores in the declaration become slashes)
+namespace TrialTaskLLM
+{
+	inline const TCHAR* const AllTagNames[] =
+	{
+		TEXT("TrialTask"),
+		TEXT("TrialTask/Parkour"),
+		TEXT("TrialTask/Movement"),
+		TEXT("TrialTask/Anim"),
+		TEXT("TrialTask/HUD"),
+		TEXT("TrialTask/Caches"),
+	};
+}
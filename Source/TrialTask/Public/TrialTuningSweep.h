@@ -0,0 +1,110 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SlideTrajectoryPredictor.h"
+#include "TraversalStateMachine.h"
+
+class ACustomCharacter;
+class UCustomMovementComponent;
+
+// Straight lane: a ramp of SlopeDeg (positive = downhill along +X) up to RampLength, flat after it
+struct FTrialSlideFixture
+{
+	const TCHAR* Name = TEXT("");
+	float SlopeDeg = 0.f;
+	float RampLength = 0.f;
+	float TargetDistance = 0.f;	// success = the slide carries at least this far...
+	float WallDistance = 0.f;	// ...and stops before a wall here (0 = open lane)
+};
+
+// Box across the lane, front face ApproachGap in front of the capsule
+struct FTrialObstacleFixture
+{
+	const TCHAR* Name = TEXT("");
+	float Height = 0.f;
+	float Depth = 0.f;
+	float CeilingHeight = 0.f;	// overhang above the box (0 = open sky)
+	bool bHasTop = false;	// instanced obstacle that reports its top: no top trace
+};
+
+// The character tuning the traversal decision chain reads
+struct TRIALTASK_API FTrialTraversalTuning
+{
+	float CapsuleRadius = 34.f;
+	float CapsuleHalfHeight = 88.f;
+
+	float ParkourFrontCheckDistance = 0.f;
+	float ParkourFrontCheckRadius = 0.f;
+	float ParkourTopTraceHeight = 0.f;
+	float VaultMaxObstacleHeight = 0.f;
+	float MantleMaxObstacleHeight = 0.f;
+	float ParkourLandForwardOffset = 0.f;
+	float ParkourLandUpOffset = 0.f;
+	float ParkourLandingForwardExtra = 0.f;
+	float ParkourLandingCapsuleInflate = 0.f;
+	float VaultToApexDuration = 0.f;
+	float VaultToTargetDuration = 0.f;
+	float MantleToApexDuration = 0.f;
+	float MantleToTargetDuration = 0.f;
+	float ApexForwardExtra = 0.f;
+	float ApexUpExtra = 0.f;
+	float MoveStepFallbackUp = 0.f;
+	float MoveStepFallbackForward = 0.f;
+
+	// Values of Character (usually a class default object); a property named in Overrides takes that value instead
+	static FTrialTraversalTuning FromCharacter(const ACustomCharacter& Character, const TMap<FName, float>& Overrides);
+};
+
+struct FTrialSlideRun
+{
+	ESlideTrajectoryEnd End = ESlideTrajectoryEnd::None;
+	bool bStarted = false;	// start speed passed CanStartSlide
+	bool bSuccess = false;
+	float Distance = 0.f;	// horizontal, from the start
+	float TimeToStop = 0.f;
+	uint16 Queries = 0;	// PhysSlide: FindFloor + move sweep per tick
+};
+
+enum class ETrialTraversalOutcome : uint8
+{
+	Success,
+	Recovered,	// mantle move blocked, placed on the target by the recovery teleport
+	Failed
+};
+
+struct FTrialTraversalRun
+{
+	ETrialTraversalOutcome Outcome = ETrialTraversalOutcome::Failed;
+	EParkourType Type = EParkourType::None;
+	const TCHAR* FailReason = TEXT("");
+	float Time = 0.f;	// press to landing
+	uint16 Queries = 0;	// sweeps + line traces, at the PARKOUR_COUNT sites
+	uint16 Fallbacks = 0;
+};
+
+/**
+ * Headless slide and traversal runs for tuning sweeps. Engine-free and thread-safe, so a sweep can spread
+ * thousands of runs over ParallelFor:
+ *  - SimulateSlide integrates with UCustomMovementComponent::StepSlideVelocity itself (const, reads tuning
+ *    only) over an analytic lane, so slide feel is the shipped rule set.
+ *  - SimulateTraversal mirrors ACustomCharacter's decision chain (front sweep, top trace, vault / mantle
+ *    choice, landing and apex fit tests, ParkourMoveStep with its fallbacks) against a box in profile,
+ *    counting queries where the character counts them.
+ * Geometry is a stand-in for collision: use the tables to rank tuning, then confirm in PIE.
+ */
+namespace TrialTuningSweep
+{
+	// SteerInput is in lane space (X along the lane); zero = no input, the only case that can coast to a stop
+	TRIALTASK_API FTrialSlideRun SimulateSlide(const UCustomMovementComponent& Move, const FTrialSlideFixture& Fixture, float StartSpeed, const FVector& SteerInput, float TickRate, float HorizonSeconds);
+
+	TRIALTASK_API FTrialTraversalRun SimulateTraversal(const FTrialTraversalTuning& Tuning, const FTrialObstacleFixture& Fixture, float ApproachGap, float TickRate);
+
+	// Tuning the models read: movement component properties for SimulateSlide (StepSlideVelocity and the
+	// start speeds), character properties for SimulateTraversal (FTrialTraversalTuning)
+	TRIALTASK_API bool IsSlideTuning(FName Property);
+	TRIALTASK_API bool IsTraversalTuning(FName Property);
+
+	// Built-in fixture sets
+	TRIALTASK_API TConstArrayView<FTrialSlideFixture> GetSlideFixtures();
+	TRIALTASK_API TConstArrayView<FTrialObstacleFixture> GetObstacleFixtures();
+}
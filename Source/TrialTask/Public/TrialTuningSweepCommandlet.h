@@ -0,0 +1,27 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TrialTuningSweepCommandlet.generated.h"
+
+/**
+ * Runs headless slide and traversal simulations (TrialTuningSweep) over a tuning grid and the built-in
+ * slope / obstacle fixtures on all cores, and writes one table per kind.
+ * Usage: UnrealEditor-Cmd TrialTask.uproject -run=TrialTuningSweep
+ *          [-Character=<class path, e.g. /Game/Blueprints/BP_CustomCharacter.BP_CustomCharacter_C>]
+ *          [-Grid="SlideDownhillAccel=600:1400:5,VaultToApexDuration=0.12:0.3:4"] [-Hz=60] [-Out=<dir>]
+ * Grid axes are float properties the models read, of the character's movement component (slide table) or of
+ * the character (traversal table), each Name=Min:Max:Steps; any other property is rejected. Slide rows are split
+ * into the no-input baseline (Steer=None, success and time to stop) and the steered runs. Output: SlideSweep.csv and TraversalSweep.csv in
+ * Saved/TuningSweep unless -Out is given, plus one SLIDESWEEP / TRAVERSALSWEEP log line per grid cell.
+ */
+UCLASS()
+class TRIALTASK_API UTrialTuningSweepCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UTrialTuningSweepCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
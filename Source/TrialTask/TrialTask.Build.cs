@@ -11,6 +11,22 @@ public class TrialTask : ModuleRules
 		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput", "UMG", "AnimGraphRuntime" });
 
 		PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore" });
+
+		// Headless soak test controller (UTrialSoakTestController derives from UGauntletTestController)
+		PublicDependencyModuleNames.Add("Gauntlet");
+
+		// Spatialized replication driver (UTrialReplicationGraph derives from UReplicationGraph)
+		PublicDependencyModuleNames.Add("ReplicationGraph");
+
+		// Alternative Mover-based movement backend (UTrialMoverComponent derives from UCharacterMoverComponent)
+		PublicDependencyModuleNames.Add("Mover");
+
+		// Crowd animation (UTrialAnimCrowdSubsystem): budget allocator, pose sharing and the significance it is driven by
+		PublicDependencyModuleNames.Add("AnimationSharing");
+		PrivateDependencyModuleNames.AddRange(new string[] { "AnimationBudgetAllocator", "SignificanceManager" });
+
+		// Iris serializers for the replicated traversal state (classic NetSerialize is kept for the replication graph path)
+		SetupIrisSupport(Target);
 		
 
 		// Uncomment if you are using Slate UI
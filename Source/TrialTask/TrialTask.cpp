@@ -1,6 +1,26 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "TrialTask.h"
+#include "ParkourAllocationScope.h"
+#include "TrialTaskLLM.h"
 #include "Modules/ModuleManager.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, TrialTask, "TrialTask" );
+LLM_DEFINE_TAG(TrialTask);
+LLM_DEFINE_TAG(TrialTask_Parkour, TEXT("Parkour"), TEXT("TrialTask"));
+LLM_DEFINE_TAG(TrialTask_Movement, TEXT("Movement"), TEXT("TrialTask"));
+LLM_DEFINE_TAG(TrialTask_Anim, TEXT("Anim"), TEXT("TrialTask"));
+LLM_DEFINE_TAG(TrialTask_HUD, TEXT("HUD"), TEXT("TrialTask"));
+LLM_DEFINE_TAG(TrialTask_Caches, TEXT("Caches"), TEXT("TrialTask"));
+
+class FTrialTaskModule : public FDefaultGameModuleImpl
+{
+public:
+	virtual void StartupModule() override
+	{
+#if PARKOUR_ALLOC_TRACKING
+		ParkourAlloc::InstallCountingMallocIfRequested();
+#endif
+	}
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FTrialTaskModule, TrialTask, "TrialTask" );